@@ -0,0 +1,265 @@
+/*
+ * File: generate_workload.c
+ * -------------------------
+ * Generates a synthetic assembly source ('.as') for the benchmark of the assembler ('make bench').
+ *
+ * The workload is described by parameters given as "key=value" arguments. A parameter that is not given keeps its
+ * default value:
+ *
+ *   lines=N      Number of code and data lines of the program (default 200).
+ *   labels=N     Number of labels defined on these lines (default 20, at most 'lines').
+ *   macros=N     Number of macros defined at the beginning of the source (default 2).
+ *   body=N       Number of lines in the body of every macro (default 3).
+ *   calls=P      Percentage of the unlabeled code lines that are macro calls (default 10).
+ *   externs=N    Number of external labels (default 2).
+ *   entries=N    Number of labels declared as entries (default 2, at most 'labels').
+ *   data=P       Percentage of the lines that are '.data' or '.string' directives (default 20).
+ *   direct=P     Percentage of the operands that refer to a label (default 40).
+ *   immediate=P  Percentage of the operands that are numbers (default 30). The other operands are registers.
+ *   seed=N       Seed of the pseudo-random numbers (default 1).
+ *
+ * The source is written to the standard output. The same parameters always give the same source, so the outputs
+ * of the assembler can be compared with golden files.
+ *
+ * Notes:
+ *   - Every generated instruction follows the addressing rules of the language, and every referenced label is
+ *     defined (or external), so a workload that fits in the memory of the machine assembles without errors.
+ *   - The generator is not part of the assembler; it is built by the 'bench' target of the makefile.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Number of parameters of a workload */
+#define COUNT_PARAMETERS 11
+
+/* Index of every parameter in the array of parameters */
+enum {LINES, LABELS, MACROS, BODY, CALLS, EXTERNS, ENTRIES, DATA, DIRECT, IMMEDIATE, SEED};
+
+/* Names of the parameters, in the order of their indexes */
+static const char *name_parameters[COUNT_PARAMETERS] = {
+        "lines", "labels", "macros", "body", "calls", "externs", "entries", "data", "direct", "immediate", "seed"
+};
+
+/* Values of the parameters, in the order of their indexes */
+static long parameters[COUNT_PARAMETERS] = {200, 20, 2, 3, 10, 2, 2, 20, 40, 30, 1};
+
+/* State of the pseudo-random numbers */
+static unsigned long random_state;
+
+/* Instructions of the language by their number of operands */
+static const char *two_operands[] = {"mov", "cmp", "add", "sub", "lea"};
+static const char *one_operand[] = {"not", "clr", "inc", "dec", "jmp", "bne", "red", "prn", "jsr"};
+static const char *no_operands[] = {"rts", "stop"};
+
+/*
+ * Function: parse_parameters
+ * --------------------------
+ * Reads the "key=value" arguments into the array of parameters.
+ *
+ * Returns:
+ *   - int: 1 if every argument is a known parameter with a number, 0 otherwise (a message is printed to stderr).
+ */
+static int parse_parameters(int argc, char **argv);
+
+/*
+ * Function: next_random
+ * ---------------------
+ * Returns a pseudo-random number between 0 and 'limit' - 1 (a linear congruential generator, so the numbers are the
+ * same on every platform).
+ */
+static long next_random(long limit);
+
+/*
+ * Function: print_operand
+ * -----------------------
+ * Prints one operand of an instruction.
+ *
+ * Parameters:
+ *   - direct_only: 1 if the operand must refer to a label ('lea' source).
+ *   - allow_immediate: 1 if the operand may be a number.
+ */
+static void print_operand(int direct_only, int allow_immediate);
+
+/*
+ * Function: print_label_name
+ * --------------------------
+ * Prints the name of a label that may be referenced: a label of the program or an external label.
+ */
+static void print_label_name(void);
+
+/*
+ * Function: print_instruction
+ * ---------------------------
+ * Prints one instruction (without a label) and its operands, following the addressing rules of the language.
+ *
+ * Parameters:
+ *   - allow_labels: 0 if the operands may not refer to labels (the bodies of the macros, which may be expanded
+ *                   before the labels that would be referenced are declared external).
+ */
+static void print_instruction(int allow_labels);
+
+/*
+ * Function: print_data
+ * --------------------
+ * Prints one '.data' or '.string' directive (without a label).
+ */
+static void print_data(void);
+
+int main(int argc, char **argv){
+    long i;
+    long j;
+    long next_label = 0;
+
+    if (parse_parameters(argc, argv) == 0){
+        return EXIT_FAILURE;
+    }
+    if (parameters[LABELS] > parameters[LINES]){
+        parameters[LABELS] = parameters[LINES];
+    }
+    if (parameters[ENTRIES] > parameters[LABELS]){
+        parameters[ENTRIES] = parameters[LABELS];
+    }
+    random_state = (unsigned long) parameters[SEED];
+
+    /* The external labels */
+    for (i = 0; i < parameters[EXTERNS]; i++){
+        printf(".extern E%ld\n", i);
+    }
+
+    /* The macros, their bodies do not refer to labels */
+    for (i = 0; i < parameters[MACROS]; i++){
+        printf("mcro m%ld\n", i);
+        for (j = 0; j < parameters[BODY]; j++){
+            printf("    ");
+            print_instruction(0);
+        }
+        printf("endmcro\n");
+    }
+
+    /* The program, the labels are spread evenly over its lines */
+    for (i = 0; i < parameters[LINES]; i++){
+        if (next_label < parameters[LABELS] && i == next_label * parameters[LINES] / parameters[LABELS]){
+            printf("L%ld: ", next_label++);
+        } else if (parameters[MACROS] > 0 && next_random(100) < parameters[CALLS]){
+            printf("m%ld\n", next_random(parameters[MACROS]));
+            continue;
+        }
+        if (next_random(100) < parameters[DATA]){
+            print_data();
+        } else {
+            print_instruction(1);
+        }
+    }
+
+    /* The entries, spread evenly over the labels */
+    for (i = 0; i < parameters[ENTRIES]; i++){
+        printf(".entry L%ld\n", i * parameters[LABELS] / parameters[ENTRIES]);
+    }
+    return EXIT_SUCCESS;
+}
+
+static int parse_parameters(int argc, char **argv){
+    int i;
+    int j;
+    size_t length;
+    char *end;
+
+    for (i = 1; i < argc; i++){
+        for (j = 0; j < COUNT_PARAMETERS; j++){
+            length = strlen(name_parameters[j]);
+            if (strncmp(argv[i], name_parameters[j], length) == 0 && argv[i][length] == '='){
+                break;
+            }
+        }
+        if (j == COUNT_PARAMETERS){
+            fprintf(stderr, "Error, unknown parameter '%s'.\n", argv[i]);
+            return 0;
+        }
+        parameters[j] = strtol(argv[i] + length + 1, &end, 10);
+        if (*end != '\0' || parameters[j] < 0){
+            fprintf(stderr, "Error, the parameter '%s' expects a non-negative number.\n", name_parameters[j]);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static long next_random(long limit){
+    random_state = (random_state * 1103515245UL + 12345UL) & 0x7fffffffUL;
+    return (long) ((random_state >> 8) % (unsigned long) limit);
+}
+
+static void print_label_name(void){
+    long choice = next_random(parameters[LABELS] + parameters[EXTERNS]);
+
+    if (choice < parameters[LABELS]){
+        printf("L%ld", choice);
+    } else {
+        printf("E%ld", choice - parameters[LABELS]);
+    }
+}
+
+static void print_operand(int direct_only, int allow_immediate){
+    long choice = next_random(100);
+
+    if (direct_only || choice < parameters[DIRECT]){
+        print_label_name();
+    } else if (allow_immediate && choice < parameters[DIRECT] + parameters[IMMEDIATE]){
+        printf("%ld", next_random(1000) - 500);
+    } else {
+        printf("@r%ld", next_random(8));
+    }
+}
+
+static void print_instruction(int allow_labels){
+    long choice = next_random(16);
+    long saved_direct = parameters[DIRECT];
+    const char *name;
+
+    /* Without labels, the share of the direct operands goes to the registers */
+    if (allow_labels == 0 || parameters[LABELS] + parameters[EXTERNS] == 0){
+        parameters[DIRECT] = 0;
+    }
+    if (choice < 5){
+        name = two_operands[choice];
+        /* 'lea' needs a label as its source, so without labels it becomes 'mov' */
+        if (strcmp(name, "lea") == 0 && parameters[DIRECT] == 0){
+            name = "mov";
+        }
+        printf("%s ", name);
+        print_operand(strcmp(name, "lea") == 0, 1);
+        printf(", ");
+        print_operand(0, strcmp(name, "cmp") == 0);
+    } else if (choice < 14){
+        name = one_operand[choice - 5];
+        printf("%s ", name);
+        print_operand(0, strcmp(name, "prn") == 0);
+    } else {
+        printf("%s", no_operands[choice - 14]);
+    }
+    printf("\n");
+    parameters[DIRECT] = saved_direct;
+}
+
+static void print_data(void){
+    long count;
+    long i;
+
+    if (next_random(2) == 0){
+        printf(".data ");
+        count = 1 + next_random(4);
+        for (i = 0; i < count; i++){
+            printf(i == 0 ? "%ld" : ", %ld", next_random(4000) - 2000);
+        }
+        printf("\n");
+    } else {
+        printf(".string \"");
+        count = 1 + next_random(12);
+        for (i = 0; i < count; i++){
+            putchar('a' + (int) next_random(26));
+        }
+        printf("\"\n");
+    }
+}
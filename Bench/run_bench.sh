@@ -0,0 +1,230 @@
+#!/bin/sh
+# Benchmark of the assembler: generates the workloads of 'Bench/workloads.txt', times 'my_project' on every workload
+# (with the two passes and with '--single-pass') and compares the outputs with 'Bench/golden.txt'.
+#
+# Usage (from the root of the repository, after 'make my_project Bench/generate_workload'):
+#   sh Bench/run_bench.sh              Run the benchmark; exits with a failure if an output differs from the golden files.
+#   sh Bench/run_bench.sh --update     Run the benchmark and write the outputs as the new golden files.
+#   sh Bench/run_bench.sh --check      Run the benchmark; exits with a failure if an output differs from the golden files,
+#                                      or if the throughput or the peak memory of a gate workload regressed against
+#                                      the reference build.
+#   sh Bench/run_bench.sh --baseline   Pin the revision of HEAD as the reference of the gate ('Bench/reference.txt').
+#
+# The environment variable REPEAT sets the number of timed runs of every workload in both modes (default 5); the
+# median one is shown.
+#
+# With '--check', the workloads marked as gates in 'Bench/workloads.txt' (those long enough to be timed reliably) are
+# also timed with a reference build, in the same run: their runs alternate between the two builds, so both see the
+# same load of the machine, and the median of GATE_REPEAT runs (default 11) of each build is compared. The peak
+# memory of a build is the median of GATE_REPEAT more runs, from their '--stats' summary.
+#
+# The reference is built from the baseline revision pinned in 'Bench/reference.txt', so a regression is caught after
+# it is committed too (in a clean checkout, or in CI). The environment variable REFERENCE overrides it with another git
+# revision (for example HEAD, to measure only the changes in the working tree), or with the path of an assembler that
+# is already built. After a change that is meant to change the performance, pin a new baseline. The environment
+# variable THRESHOLD sets the regression allowed, in percent (default 10): a gate workload fails if its throughput is
+# lower than that of the reference by more than that, or its peak memory higher.
+
+cd "$(dirname "$0")/.." || exit 1
+ROOT=$(pwd)
+REPEAT=${REPEAT:-5}
+GATE_REPEAT=${GATE_REPEAT:-11}
+THRESHOLD=${THRESHOLD:-10}
+REFERENCE=${REFERENCE:-$(grep -v '^#' Bench/reference.txt 2>/dev/null | head -n 1)}
+WORK=$(mktemp -d) || exit 1
+trap 'rm -rf "$WORK"' EXIT
+
+# Print the checksum of every output of the files of a workload (a missing output is "none"). A workload of more than
+# 64 files prints one checksum per extension instead, of the checksums of all its files.
+checksums() {
+    for name in $2; do
+        for ext in ob ent ext; do
+            if [ -f "$name.$ext" ]; then
+                echo "$1 $name.$ext $(cksum < "$name.$ext" | cut -d ' ' -f 1)"
+            else
+                echo "$1 $name.$ext none"
+            fi
+        done
+    done > "$WORK/files.txt"
+    if [ "$(wc -l < "$WORK/files.txt")" -le 192 ]; then
+        cat "$WORK/files.txt"
+    else
+        for ext in ob ent ext; do
+            echo "$1 all.$ext $(grep "\\.$ext " "$WORK/files.txt" | cksum | cut -d ' ' -f 1)"
+        done
+    fi
+    echo "$1 console $(cksum < console.txt | cut -d ' ' -f 1)"
+}
+
+# Run an assembler once in a directory and append its wall time, in microseconds, to a file.
+time_run() {
+    directory=$1
+    file=$2
+    program=$3
+    shift 3
+    start=$(date +%s%N)
+    (cd "$directory" && "$program" "$@" > console.txt 2>&1)
+    end=$(date +%s%N)
+    echo $(( (end - start) / 1000 )) >> "$file"
+}
+
+# Print the median of the times of a file, one per line.
+median() {
+    sort -n "$1" | awk '{ times[NR] = $1 } END { print times[int((NR + 1) / 2)] + 0 }'
+}
+
+# Run a workload REPEAT times and print the median wall time, in microseconds.
+median_time() {
+    : > "$WORK/times.txt"
+    i=0
+    while [ $i -lt "$REPEAT" ]; do
+        time_run . "$WORK/times.txt" "$ROOT/my_project" "$@"
+        i=$((i + 1))
+    done
+    median "$WORK/times.txt"
+}
+
+# Print the time of a run in milliseconds, from microseconds.
+milliseconds() {
+    awk "BEGIN { printf \"%.2f\", $1 / 1000 }"
+}
+
+# Run an assembler once with '--stats' and print the peak memory (RSS) of the run, in kilobytes (0 if it is not
+# printed; older builds print it as 'Peak memory').
+peak_memory() {
+    program=$1
+    shift
+    "$program" --stats "$@" 2>&1 | awk '/Peak (memory|RSS of the process) \(kB\):/ { peak = $NF } END { print peak + 0 }'
+}
+
+# Run an assembler GATE_REPEAT times with '--stats' and print the median peak memory, in kilobytes.
+median_peak_memory() {
+    : > "$WORK/peaks.txt"
+    i=0
+    while [ $i -lt "$GATE_REPEAT" ]; do
+        peak_memory "$@" >> "$WORK/peaks.txt"
+        i=$((i + 1))
+    done
+    median "$WORK/peaks.txt"
+}
+
+# Pin the revision of HEAD as the baseline of the gate.
+if [ "$1" = "--baseline" ]; then
+    revision=$(git rev-parse HEAD) || exit 1
+    {
+        echo "# Baseline revision of the performance gate ('make bench-baseline'): the gate workloads of 'make check'"
+        echo "# are compared with a build of this revision."
+        echo "$revision"
+    } > Bench/reference.txt
+    echo "Baseline pinned to $revision."
+    exit 0
+fi
+
+# Build the reference assembler of the gate, or use the one given.
+if [ "$1" = "--check" ]; then
+    if [ -z "$REFERENCE" ]; then
+        echo "There is no baseline revision, pin one with 'make bench-baseline'."
+        exit 1
+    fi
+    if [ -f "$REFERENCE" ] && [ -x "$REFERENCE" ]; then
+        REFERENCE_PROGRAM=$(cd "$(dirname "$REFERENCE")" && pwd)/$(basename "$REFERENCE")
+    else
+        echo "Building the reference from $REFERENCE..."
+        mkdir "$WORK/reference" || exit 1
+        git archive "$REFERENCE" | tar -x -C "$WORK/reference" || exit 1
+        rm -f "$WORK/reference/"*.o
+        make -s -C "$WORK/reference" my_project > /dev/null || exit 1
+        REFERENCE_PROGRAM=$WORK/reference/my_project
+    fi
+fi
+
+printf "%-12s %6s %8s %14s %14s\n" "workload" "files" "lines" "two-pass(ms)" "single(ms)"
+: > "$WORK/outputs.txt"
+: > "$WORK/perf.txt"
+grep -v '^#' Bench/workloads.txt | while read -r workload files jobs gate parameters; do
+    [ -z "$workload" ] && continue
+    mkdir "$WORK/$workload" && cd "$WORK/$workload" || exit 1
+
+    # Generate the files of the workload.
+    names=""
+    n=1
+    while [ $n -le "$files" ]; do
+        # shellcheck disable=SC2086
+        "$ROOT/Bench/generate_workload" $parameters seed=$n > "w$n.as" || exit 1
+        names="$names w$n"
+        n=$((n + 1))
+    done
+    lines=$(cat ./*.as | wc -l)
+
+    # Time both modes; the outputs of both must match the same golden files.
+    # shellcheck disable=SC2086
+    two=$(median_time -j "$jobs" $names)
+    checksums "$workload" "$names" > "$WORK/two.txt"
+    # shellcheck disable=SC2086
+    single=$(median_time -j "$jobs" --single-pass $names)
+    checksums "$workload" "$names" > "$WORK/single.txt"
+    cat "$WORK/two.txt" >> "$WORK/outputs.txt"
+    if ! cmp -s "$WORK/two.txt" "$WORK/single.txt"; then
+        echo "$workload single-pass outputs differ" >> "$WORK/outputs.txt"
+    fi
+
+    # Time a gate workload again with both builds, one run of each in turn, in their own copies of the sources (after
+    # a first run of each that writes the output files, and is not timed).
+    if [ "$1" = "--check" ] && [ "$gate" = "yes" ]; then
+        mkdir current reference && cp ./*.as current/ && cp ./*.as reference/ || exit 1
+        # shellcheck disable=SC2086
+        time_run reference /dev/null "$REFERENCE_PROGRAM" -j "$jobs" $names
+        # shellcheck disable=SC2086
+        time_run current /dev/null "$ROOT/my_project" -j "$jobs" $names
+        : > "$WORK/current.txt"
+        : > "$WORK/reference.txt"
+        i=0
+        while [ $i -lt "$GATE_REPEAT" ]; do
+            # shellcheck disable=SC2086
+            time_run reference "$WORK/reference.txt" "$REFERENCE_PROGRAM" -j "$jobs" $names
+            # shellcheck disable=SC2086
+            time_run current "$WORK/current.txt" "$ROOT/my_project" -j "$jobs" $names
+            i=$((i + 1))
+        done
+        # shellcheck disable=SC2086
+        peak=$(cd current && median_peak_memory "$ROOT/my_project" -j "$jobs" $names)
+        # shellcheck disable=SC2086
+        reference_peak=$(cd reference && median_peak_memory "$REFERENCE_PROGRAM" -j "$jobs" $names)
+        awk "BEGIN { printf \"%s %d %d %d %d\\n\", \"$workload\", $lines * 1000000 / ($(median "$WORK/current.txt") + 1),
+             $peak, $lines * 1000000 / ($(median "$WORK/reference.txt") + 1), $reference_peak }" >> "$WORK/perf.txt"
+    fi
+
+    printf "%-12s %6s %8s %14s %14s\n" "$workload" "$files" "$lines" "$(milliseconds "$two")" "$(milliseconds "$single")"
+    cd "$ROOT" || exit 1
+done
+
+if [ "$1" = "--update" ]; then
+    cp "$WORK/outputs.txt" Bench/golden.txt
+    echo "Golden files updated."
+    exit 0
+fi
+if diff Bench/golden.txt "$WORK/outputs.txt" > "$WORK/diff.txt"; then
+    echo "All outputs match the golden files."
+else
+    echo "Outputs differ from the golden files:"
+    cat "$WORK/diff.txt"
+    exit 1
+fi
+
+# Compare the throughput and the peak memory of every gate workload with those of the reference (a reference that
+# does not print its peak memory is not compared on memory).
+if [ "$1" = "--check" ]; then
+    printf "\n%-12s %12s %12s %10s %10s\n" "workload" "lines/s" "reference" "peak(kB)" "reference"
+    awk -v threshold="$THRESHOLD" '
+        {
+            status = ""
+            if ($2 < $4 * (1 - threshold / 100)) { status = status "  THROUGHPUT REGRESSED"; failed = 1 }
+            if ($5 > 0 && $3 > $5 * (1 + threshold / 100)) { status = status "  MEMORY REGRESSED"; failed = 1 }
+            printf "%-12s %12d %12d %10d %10d%s\n", $1, $2, $4, $3, $5, status
+        }
+        END { exit failed }' "$WORK/perf.txt" || {
+        echo "The performance regressed by more than $THRESHOLD% against the reference ($REFERENCE)."
+        exit 1
+    }
+    echo "No gate workload regressed by more than $THRESHOLD% against the reference ($REFERENCE)."
+fi
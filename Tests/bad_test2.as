@@ -0,0 +1,14 @@
+;A comma at the start of a line is a word of its own,
+;so the line has four words and its first one is not
+;an instruction.
+;INSTRUCTION_NAME_NOT_EXIST
+ ,  r3 red sub
+
+;INSTRUCTION_NAME_NOT_EXIST
+,stop
+
+;TOO_MUCH_WORDS_FOR_INSTRUCTION
+MAIN: mov @r1, @r2, @r3
+
+mov @r1, @r2
+stop
@@ -0,0 +1,23 @@
+; Every keyword of the language: the 16 instructions, the 4 directives
+; and the 8 registers (a keyword missing from its slot of the table of
+; keywords is read as a label, and the file fails).
+.entry MAIN
+.extern EXT
+MAIN: mov @r0, @r1
+cmp 5, @r2
+add @r3, VALUES
+sub @r4, @r5
+not @r6
+clr @r7
+lea TEXT, @r0
+inc VALUES
+dec EXT
+jmp LOOP
+LOOP: bne EXT
+red @r1
+prn -3
+jsr LOOP
+rts
+stop
+TEXT: .string "keys"
+VALUES: .data 7, -7
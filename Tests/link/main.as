@@ -0,0 +1,10 @@
+.entry MAIN
+.extern PRINT
+.extern COUNT
+MAIN: mov @r3 ,COUNT
+LOOP: jsr PRINT
+dec @r3
+bne LOOP
+lea STR, @r1
+stop
+STR: .string "main"
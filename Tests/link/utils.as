@@ -0,0 +1,6 @@
+.entry PRINT
+.entry COUNT
+PRINT: prn @r1
+inc COUNT
+rts
+COUNT: .data 3
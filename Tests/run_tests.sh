@@ -0,0 +1,103 @@
+#!/bin/sh
+# Tests of the assembler: assembles every 'Tests/*.as' (with '--am' and '--binary') and compares every output with the
+# expected file of the same name in 'Tests' ('.am', '.ob', '.ent', '.ext' and '.obj'). An output without an expected
+# file, or an expected file without an output, is a failure too (a source with errors has no '.ob'). The console
+# messages of the run (the errors of every source) are compared with 'Tests/messages.txt'.
+#
+# Two more groups of outputs are compared:
+#   - 'Tests/link': the modules 'main' and 'utils' are linked with '--link prog'; the image ('prog.ob' and 'prog.ent')
+#     and the console messages of the run ('messages.txt') are compared.
+#   - 'Tests/diagnostics': the errors of 'Tests/bad_test*.as' are printed in every format of '--diagnostics' ('json.txt',
+#     'sarif.txt' and 'color.txt') and with '--max-errors 3' ('max_errors.txt').
+#
+# Usage (from the root of the repository, after 'make my_project'):
+#   sh Tests/run_tests.sh            Run the tests; exits with a failure if an output differs from its expected file.
+#   sh Tests/run_tests.sh --update   Run the tests and write the outputs as the new expected files.
+
+cd "$(dirname "$0")/.." || exit 1
+ROOT=$(pwd)
+MODE=$1
+WORK=$(mktemp -d) || exit 1
+trap 'rm -rf "$WORK"' EXIT
+failed=0
+
+# Compare an output with its expected file, or write it as the new expected file with '--update' (an expected file
+# without an output is removed). The differences of a binary file ('.obj') are shown as its differing bytes.
+check_output() {
+    output=$1
+    expected=$2
+    if [ "$MODE" = "--update" ]; then
+        rm -f "$expected"
+        [ -f "$output" ] && cp "$output" "$expected"
+    elif [ -f "$output" ] && [ -f "$expected" ]; then
+        if ! cmp -s "$output" "$expected"; then
+            echo "FAIL ${expected#Tests/} differs from the expected file:"
+            case "$expected" in
+                *.obj) cmp -l "$expected" "$output" | head -20 ;;
+                *) diff "$expected" "$output" | head -20 ;;
+            esac
+            failed=1
+        fi
+    elif [ -f "$output" ]; then
+        echo "FAIL ${expected#Tests/} was written, but there is no expected file"
+        failed=1
+    elif [ -f "$expected" ]; then
+        echo "FAIL ${expected#Tests/} was not written"
+        failed=1
+    fi
+}
+
+# Assemble all the sources of the tests in one run.
+names=""
+for source in Tests/*.as; do
+    cp "$source" "$WORK/" || exit 1
+    names="$names $(basename "$source" .as)"
+done
+cd "$WORK" || exit 1
+# shellcheck disable=SC2086
+"$ROOT/my_project" --am --binary $names > console.txt 2>&1
+cd "$ROOT" || exit 1
+
+for name in $names; do
+    for ext in am ob ent ext obj; do
+        check_output "$WORK/$name.$ext" "Tests/$name.$ext"
+    done
+done
+check_output "$WORK/console.txt" Tests/messages.txt
+
+# Link the two modules of 'Tests/link' into one image.
+mkdir "$WORK/link" && cp Tests/link/*.as "$WORK/link/" || exit 1
+(cd "$WORK/link" && "$ROOT/my_project" --link prog main utils > messages.txt 2>&1)
+for file in prog.ob prog.ent messages.txt; do
+    check_output "$WORK/link/$file" "Tests/link/$file"
+done
+
+# Print the errors of the sources with errors in every format; the JSON and SARIF objects are alone on the standard
+# output.
+mkdir "$WORK/diagnostics" && cp Tests/bad_test*.as "$WORK/diagnostics/" || exit 1
+bad_names=""
+for source in Tests/bad_test*.as; do
+    bad_names="$bad_names $(basename "$source" .as)"
+done
+cd "$WORK/diagnostics" || exit 1
+# shellcheck disable=SC2086
+"$ROOT/my_project" --diagnostics json $bad_names > json.txt 2> /dev/null
+# shellcheck disable=SC2086
+"$ROOT/my_project" --diagnostics sarif $bad_names > sarif.txt 2> /dev/null
+# shellcheck disable=SC2086
+"$ROOT/my_project" --diagnostics color $bad_names > color.txt 2>&1
+# shellcheck disable=SC2086
+"$ROOT/my_project" --max-errors 3 $bad_names > max_errors.txt 2>&1
+cd "$ROOT" || exit 1
+for file in json.txt sarif.txt color.txt max_errors.txt; do
+    check_output "$WORK/diagnostics/$file" "Tests/diagnostics/$file"
+done
+
+if [ "$MODE" = "--update" ]; then
+    echo "Expected files updated."
+    exit 0
+fi
+if [ $failed -ne 0 ]; then
+    exit 1
+fi
+echo "All tests match the expected files."
@@ -0,0 +1,98 @@
+#include "arena_tool.h"
+
+/*
+ * Union: arena_align
+ * ------------------
+ * A union of the types with the strictest alignment, used to round the sizes of the objects given out by an arena,
+ * so every object is aligned for any type.
+ */
+typedef union {
+    long as_long;
+    double as_double;
+    void *as_pointer;
+} arena_align;
+
+/*
+ * Function: add_block_to_arena
+ * ----------------------------
+ * Allocates a new block of at least 'size' bytes and makes it the current block of the arena.
+ *
+ * Parameters:
+ *   - arena: A pointer to the arena.
+ *   - size: The number of bytes that must fit in the new block.
+ *
+ * Notes:
+ *   - If dynamic memory allocation fails, the function prints an error message to stderr and exits the program.
+ */
+static void add_block_to_arena(ptr_arena arena, size_t size);
+
+void init_arena(ptr_arena arena){
+    arena->head_block = NULL;
+}
+
+void * alloc_from_arena(ptr_arena arena, size_t size){
+    void *object;
+
+    /* Round the size up, so the next object is aligned too */
+    size = (size + sizeof(arena_align) - 1) / sizeof(arena_align) * sizeof(arena_align);
+
+    /* Start a new block if the object does not fit in the current one */
+    if (arena->head_block == NULL || arena->head_block->size - arena->head_block->used < size){
+        add_block_to_arena(arena, size);
+    }
+
+    /* Give out the next bytes of the current block */
+    object = arena->head_block->memory + arena->head_block->used;
+    arena->head_block->used += size;
+    return object;
+}
+
+static void add_block_to_arena(ptr_arena arena, size_t size){
+    ptr_arena_block new_block = (ptr_arena_block)malloc(sizeof(item_arena_block));
+    if (new_block == NULL){
+        fprintf(stderr, "Error in dynamic memory allocation");
+        exit(EXIT_FAILURE);
+    }
+
+    /* A big object gets a block of its own size */
+    new_block->size = (size > ARENA_BLOCK_SIZE) ? size : ARENA_BLOCK_SIZE;
+    new_block->memory = (char *)malloc(new_block->size);
+    if (new_block->memory == NULL){
+        fprintf(stderr, "Error in dynamic memory allocation");
+        exit(EXIT_FAILURE);
+    }
+    new_block->used = 0;
+
+    /* The new block becomes the current block of the arena */
+    new_block->next = arena->head_block;
+    arena->head_block = new_block;
+}
+
+void reset_arena(ptr_arena arena){
+    ptr_arena_block temp_block;
+
+    if (arena->head_block == NULL){
+        return;
+    }
+
+    /* Free every block but the current one, which is emptied */
+    while (arena->head_block->next){
+        temp_block = arena->head_block->next;
+        arena->head_block->next = temp_block->next;
+        free(temp_block->memory);
+        free(temp_block);
+    }
+    arena->head_block->used = 0;
+}
+
+void free_arena(ptr_arena arena){
+    ptr_arena_block temp_block;
+
+    /* Free every block of the arena */
+    while (arena->head_block){
+        temp_block = arena->head_block;
+        arena->head_block = arena->head_block->next;
+        free(temp_block->memory);
+        free(temp_block);
+    }
+}
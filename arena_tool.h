@@ -0,0 +1,119 @@
+/*
+ * Header: arena_tool.h
+ * --------------------
+ * This header file defines an arena allocator and the functions used to manage it.
+ * Every file struct owns an arena that serves the small objects allocated while the file is assembled (for example
+ * the nodes of the label and macro tables). The objects are never freed one by one; the whole arena is released at once
+ * when the file struct is freed, so the memory of a file is bounded and the files assembled at the same time do not
+ * share an allocator.
+ *
+ * Included Files:
+ *   - stdio.h: Standard Input/Output library. It provides functions for input and output operations, such as file handling.
+ *   - stdlib.h: Standard Library. It provides functions for memory allocation, conversion, and other utility functions.
+ *   - setting.h: Contains constant definitions and configurations used throughout the assembly process.
+ */
+
+#ifndef ARENA_TOOL_H
+#define ARENA_TOOL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "setting.h"
+
+/*
+ * Struct: item_arena_block
+ * ------------------------
+ * A structure representing one block of memory of an arena.
+ *
+ * Fields:
+ *   - memory: A pointer to the dynamically allocated memory of the block.
+ *   - size: The number of bytes allocated for 'memory'.
+ *   - used: The number of bytes of 'memory' already given out.
+ *   - next: A pointer to the block allocated before this one (NULL for the first block).
+ */
+typedef struct arena_block * ptr_arena_block;
+typedef struct arena_block {
+    char *memory;
+    size_t size;
+    size_t used;
+    ptr_arena_block next;
+} item_arena_block;
+
+/*
+ * Struct: item_arena
+ * ------------------
+ * A structure representing an arena allocator.
+ *
+ * Fields:
+ *   - head_block: A pointer to the current block of the arena, from which the next objects are given out (NULL before
+ *                 the first allocation).
+ *
+ * Notes:
+ *   - The blocks are 'ARENA_BLOCK_SIZE' bytes; a bigger object gets a block of its own.
+ */
+typedef struct arena_struct * ptr_arena;
+typedef struct arena_struct {
+    ptr_arena_block head_block;
+} item_arena;
+
+/*
+ * Function: init_arena
+ * --------------------
+ * Initializes an empty arena.
+ *
+ * Parameters:
+ *   - arena: A pointer to the arena to be initialized.
+ *
+ * Notes:
+ *   - No memory is allocated here; the first block is allocated on the first allocation.
+ */
+void init_arena(ptr_arena arena);
+
+/*
+ * Function: alloc_from_arena
+ * --------------------------
+ * Allocates 'size' bytes from the arena.
+ *
+ * Parameters:
+ *   - arena: A pointer to the arena.
+ *   - size: The number of bytes to be allocated.
+ *
+ * Returns:
+ *   - void*: A pointer to the allocated memory, aligned for any type. The memory is not initialized.
+ *
+ * Notes:
+ *   - The memory stays valid until the arena is released with 'free_arena', it must not be passed to 'free'.
+ *   - If dynamic memory allocation fails, the function prints an error message to stderr and exits the program.
+ */
+void * alloc_from_arena(ptr_arena arena, size_t size);
+
+/*
+ * Function: reset_arena
+ * ---------------------
+ * Gives back all the memory of the arena at once, but keeps its current block for the next allocations.
+ *
+ * Parameters:
+ *   - arena: A pointer to the arena to be reset.
+ *
+ * Notes:
+ *   - Every object allocated from the arena becomes invalid, as with 'free_arena'.
+ *   - Only the other blocks are freed, so an arena that is reset for every file of a long run does not allocate
+ *     memory again for the small allocations of the next file.
+ */
+void reset_arena(ptr_arena arena);
+
+/*
+ * Function: free_arena
+ * --------------------
+ * Releases all the memory of the arena at once.
+ *
+ * Parameters:
+ *   - arena: A pointer to the arena to be released.
+ *
+ * Notes:
+ *   - Every object allocated from the arena becomes invalid.
+ *   - The arena is left empty (as after 'init_arena'), so it can be used again.
+ */
+void free_arena(ptr_arena arena);
+
+#endif /* ARENA_TOOL_H */
@@ -0,0 +1,147 @@
+#include "assembler.h"
+
+/*
+ * Function: take_text_of_file
+ * ---------------------------
+ * Moves the text of one of the files of a file struct kept in memory to the caller.
+ *
+ * Parameters:
+ *   - file_struct: A pointer to the file struct.
+ *   - ext: The file to be moved.
+ *   - length: A pointer that receives the number of characters of the text.
+ *
+ * Returns:
+ *   - char*: The text of the file (NULL if the file was not produced). The file struct no longer owns it.
+ */
+static char * take_text_of_file(ptr_file file_struct, file_ext ext, size_t *length);
+
+/*
+ * Function: write_section_of_stream
+ * ---------------------------------
+ * Writes the section of one file to a framed output stream: its header line and its characters.
+ *
+ * Parameters:
+ *   - file_out: The stream that receives the section.
+ *   - name_section: The name of the section (the extension of the file).
+ *   - text: The text of the file, or NULL if the file was not produced (nothing is written).
+ *   - length: The number of characters of 'text'.
+ */
+static void write_section_of_stream(FILE *file_out, const char *name_section, const char *text, size_t length);
+
+void init_assembler(ptr_assembler assembler, const char *name_file, FILE *file_log){
+    strncpy(assembler->name_file, name_file, MAX_FILE_NAME_LENGTH - 1);
+    assembler->name_file[MAX_FILE_NAME_LENGTH - 1] = '\0';
+    assembler->file_log = file_log;
+    assembler->single_pass_flag = FALSE;
+    assembler->binary_flag = FALSE;
+    assembler->diagnostics_format = FORMAT_TEXT;
+    assembler->max_errors = 0;
+}
+
+bool assemble(ptr_assembler assembler, const char *source_text, size_t source_length, ptr_assembler_output output){
+    ptr_file file_struct;
+    FILE *file_log = assembler->file_log;
+    bool result;
+
+    /* Start from an empty output */
+    memset(output, 0, sizeof(item_assembler_output));
+
+    /* Collect the console messages into the output if the assembler has no stream for them */
+    if (file_log == NULL){
+        file_log = open_memstream(&output->text_log, &output->length_log);
+        if (file_log == NULL){
+            fprintf(stderr, "Error in dynamic memory allocation");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    /* Run the pre-assembly and the two passes on a file struct kept in memory */
+    file_struct = create_new_memory_file_struct(assembler->name_file, source_text, source_length, file_log);
+    file_struct->single_pass_flag = assembler->single_pass_flag;
+    file_struct->binary_flag = assembler->binary_flag;
+    file_struct->diagnostics_format = assembler->diagnostics_format;
+    file_struct->diagnostic_list.max_diagnostics = assembler->max_errors;
+    start_pre_assembly(file_struct);
+    start_first_pass(file_struct);
+    start_second_pass(file_struct);
+    print_end_of_file(file_struct);
+
+    /* Move the expanded source and the texts of the files to the output */
+    output->text_am = file_struct->text_am.text;
+    output->length_am = file_struct->text_am.length;
+    init_buffer(&file_struct->text_am);
+    output->text_ob = take_text_of_file(file_struct, EXT_OBJECT, &output->length_ob);
+    output->text_ent = take_text_of_file(file_struct, EXT_ENTRY, &output->length_ent);
+    output->text_ext = take_text_of_file(file_struct, EXT_EXTERN, &output->length_ext);
+    output->text_obj = take_text_of_file(file_struct, EXT_BINARY, &output->length_obj);
+    output->count_error = file_struct->count_error;
+    output->stats = file_struct->stats;
+    result = (file_struct->error_flag == FALSE) ? TRUE : FALSE;
+    free_file(file_struct);
+
+    if (assembler->file_log == NULL){
+        fclose(file_log);
+    }
+    return result;
+}
+
+static char * take_text_of_file(ptr_file file_struct, file_ext ext, size_t *length){
+    char *text = file_struct->memory_texts[ext];
+
+    *length = file_struct->memory_lengths[ext];
+    file_struct->memory_texts[ext] = NULL;
+    file_struct->memory_lengths[ext] = 0;
+    return text;
+}
+
+void free_assembler_output(ptr_assembler_output output){
+    free(output->text_am);
+    free(output->text_ob);
+    free(output->text_ent);
+    free(output->text_ext);
+    free(output->text_obj);
+    free(output->text_log);
+    memset(output, 0, sizeof(item_assembler_output));
+}
+
+void write_output_stream(FILE *file_out, const char *name_file, ptr_assembler_output output, bool am_flag){
+    fprintf(file_out, "%s %s %s\n", STREAM_HEADER, ASSEMBLER_VERSION, name_file);
+    if (am_flag == TRUE){
+        write_section_of_stream(file_out, "am", output->text_am != NULL ? output->text_am : "", output->length_am);
+    }
+    write_section_of_stream(file_out, "ob", output->text_ob, output->length_ob);
+    write_section_of_stream(file_out, "ent", output->text_ent, output->length_ent);
+    write_section_of_stream(file_out, "ext", output->text_ext, output->length_ext);
+    write_section_of_stream(file_out, "obj", output->text_obj, output->length_obj);
+    fprintf(file_out, "end %d\n", output->count_error);
+}
+
+static void write_section_of_stream(FILE *file_out, const char *name_section, const char *text, size_t length){
+    if (text == NULL){
+        return;
+    }
+    fprintf(file_out, "%s %lu\n", name_section, (unsigned long) length);
+    fwrite(text, 1, length, file_out);
+}
+
+void print_end_of_file(ptr_file file_struct){
+    /* Print the errors of the file at once, in the order in which they were found */
+    print_list_diagnostic(&file_struct->diagnostic_list, file_struct->file_log, file_struct->diagnostics_format,
+                          file_struct->name_file);
+
+    /* The JSON and SARIF objects already hold the result of the file, so nothing else is printed with them */
+    if (is_structured_format(file_struct->diagnostics_format) == TRUE){
+        return;
+    }
+
+    /* Print success message if no errors were encountered */
+    if (file_struct->error_flag == FALSE){
+        fprintf(file_struct->file_log, "\nCompilation completed successfully.\n");
+        fprintf(file_struct->file_log, "Lines parsed into file: %d.\n", file_struct->IC + file_struct->DC - FIRST_CELL_IN_MEMORY);
+
+    /* Print error message if there were errors during the assembly process */
+    } else {
+        fprintf(file_struct->file_log, "\nNumber of errors: %d.\n", file_struct->count_error);
+        fprintf(file_struct->file_log, "Compilation not completed.\n");
+    }
+}
@@ -0,0 +1,191 @@
+/*
+ * Header: assembler.h
+ * -------------------
+ * This header file is the interface of the assembler as a library ('libassembler.a').
+ *
+ * The library assembles a source held in memory and returns the output files in memory, without touching the disk.
+ * All the state of an assembly lives in the structs below and in the file struct created for the call, so the
+ * library can be called from many threads at the same time, each one with its own 'item_assembler'.
+ *
+ *   item_assembler assembler;
+ *   item_assembler_output output;
+ *
+ *   init_assembler(&assembler, "prog", NULL);
+ *   if (assemble(&assembler, source_text, source_length, &output) == TRUE) {
+ *       ... use output.text_ob (output.length_ob characters) ...
+ *   }
+ *   free_assembler_output(&output);
+ *
+ * Included Files:
+ *   - stdio.h: Standard Input/Output library. It provides functions for input and output operations, such as file handling.
+ *   - stdlib.h: Standard Library. It provides functions for memory allocation, conversion, and other utility functions.
+ *   - string.h: C String Library. It provides functions for manipulating strings, such as string copying and comparison.
+ *   - file_tool.h: Contains the file struct holding the state of an assembly, and its files kept in memory.
+ *   - pre_assembly.h: Contains functions and declarations for the pre-assembly process, which handles macros and expansions.
+ *   - first_pass.h: Contains functions and declarations for the first pass of the assembly process.
+ *   - second_pass.h: Contains functions and declarations for the second pass of the assembly process.
+ *   - setting.h: Contains constant definitions and configurations used throughout the assembly process.
+ */
+
+#ifndef ASSEMBLER_H
+#define ASSEMBLER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "file_tool.h"
+#include "pre_assembly.h"
+#include "first_pass.h"
+#include "second_pass.h"
+#include "setting.h"
+
+/*
+ * Struct: item_assembler
+ * ----------------------
+ * The context of the assembler, given to every call of 'assemble'.
+ *
+ * Fields:
+ *   - name_file: The name of the source, used only in the messages.
+ *   - file_log: The stream that receives the console messages (progress and errors), or NULL to collect the
+ *               messages into the output of every call.
+ *   - single_pass_flag: TRUE to resolve the labels from the fixups of the first pass instead of a second pass
+ *                       (FALSE after 'init_assembler'). The output is the same in both modes.
+ *   - binary_flag: TRUE to produce the binary object file too (FALSE after 'init_assembler').
+ *   - diagnostics_format: The format of the errors in the console messages (FORMAT_TEXT after 'init_assembler').
+ *   - max_errors: The largest number of errors printed, or 0 to print them all (0 after 'init_assembler').
+ */
+typedef struct assembler_struct * ptr_assembler;
+typedef struct assembler_struct {
+    char name_file[MAX_FILE_NAME_LENGTH];
+    FILE *file_log;
+    bool single_pass_flag;
+    bool binary_flag;
+    diagnostics_format diagnostics_format;
+    int max_errors;
+} item_assembler;
+
+/*
+ * Struct: item_assembler_output
+ * -----------------------------
+ * The result of one call of 'assemble'. Every text is allocated by the library and is NULL (with a length of zero)
+ * when the file was not produced.
+ *
+ * Fields:
+ *   - text_am, length_am: The source after the pre-assembly (the '.am' file).
+ *   - text_ob, length_ob: The object file ('.ob'), produced only when there are no errors.
+ *   - text_ent, length_ent: The entries file ('.ent'), produced only when there are no errors and entries exist.
+ *   - text_ext, length_ext: The externals file ('.ext'), produced only when there are no errors and externals exist.
+ *   - text_obj, length_obj: The binary object file ('.obj'), produced only when there are no errors and the
+ *                           'binary_flag' of the assembler is TRUE.
+ *   - text_log, length_log: The console messages, collected only when the 'file_log' of the assembler is NULL.
+ *   - count_error: The number of errors found in the source.
+ *   - stats: The times of the phases and the counters of the assembly (see 'stats_tool.h').
+ */
+typedef struct assembler_output_struct * ptr_assembler_output;
+typedef struct assembler_output_struct {
+    char *text_am;
+    size_t length_am;
+    char *text_ob;
+    size_t length_ob;
+    char *text_ent;
+    size_t length_ent;
+    char *text_ext;
+    size_t length_ext;
+    char *text_obj;
+    size_t length_obj;
+    char *text_log;
+    size_t length_log;
+    int count_error;
+    item_stats stats;
+} item_assembler_output;
+
+/*
+ * Function: init_assembler
+ * ------------------------
+ * Initializes the context of the assembler.
+ *
+ * Parameters:
+ *   - assembler: A pointer to the context to be initialized.
+ *   - name_file: The name of the source, used only in the messages (cut to 'MAX_FILE_NAME_LENGTH' - 1 characters).
+ *   - file_log: The stream that receives the console messages, or NULL to collect them into the output.
+ */
+void init_assembler(ptr_assembler assembler, const char *name_file, FILE *file_log);
+
+/*
+ * Function: assemble
+ * ------------------
+ * Assembles a source held in memory.
+ *
+ * Parameters:
+ *   - assembler: A pointer to the context of the assembler.
+ *   - source_text: The text of the source (the content of an '.as' file). It does not need to be null-terminated.
+ *   - source_length: The number of characters of 'source_text'.
+ *   - output: A pointer to the output to be filled. It must be released with 'free_assembler_output'.
+ *
+ * Returns:
+ *   - bool: TRUE if the source was assembled without errors, FALSE otherwise.
+ *
+ * Notes:
+ *   - The function runs the pre-assembly and the two passes on a file struct kept in memory, then moves the texts
+ *     of the files into the output.
+ *   - If dynamic memory allocation fails, the function prints an error message to stderr and exits the program.
+ */
+bool assemble(ptr_assembler assembler, const char *source_text, size_t source_length, ptr_assembler_output output);
+
+/*
+ * Function: free_assembler_output
+ * -------------------------------
+ * Frees the texts of an output filled by 'assemble'.
+ *
+ * Parameters:
+ *   - output: A pointer to the output to be freed.
+ */
+void free_assembler_output(ptr_assembler_output output);
+
+/*
+ * Function: write_output_stream
+ * -----------------------------
+ * Writes an output filled by 'assemble' to a stream as one framed stream, so the output files can be passed to the
+ * next program of a pipeline without temporary files (the '--stdio' option). The stream is formed as follows:
+ *
+ *   "assembler-stream <version> <name>\n"
+ *   "<section> <length>\n" followed by the <length> characters of the file, for every file produced
+ *   "end <number of errors>\n"
+ *
+ * where <section> is the extension of the file ("am", "ob", "ent", "ext" or "obj"), in this order.
+ *
+ * Parameters:
+ *   - file_out: The stream that receives the framed output.
+ *   - name_file: The name of the source, written in the first line of the stream.
+ *   - output: A pointer to the output of 'assemble'.
+ *   - am_flag: A boolean flag indicating if the source after the pre-assembly is written too (the "am" section).
+ *
+ * Notes:
+ *   - A file that was not produced (the "ob" section of a source with errors, or a source without entries or
+ *     external references) has no section, so a reader finds the end of the stream by the "end" line.
+ */
+void write_output_stream(FILE *file_out, const char *name_file, ptr_assembler_output output, bool am_flag);
+
+/*
+ * Function: print_end_of_file
+ * ---------------------------
+ * The 'print_end_of_file' function prints the final result of the assembly process for a specific assembly file.
+ * It displays whether the compilation was successful or encountered errors, along with additional information
+ * related to the number of lines parsed and any error messages.
+ *
+ * Parameters:
+ *   file_struct: A pointer to the file structure (ptr_file) representing the processed assembly file.
+ *
+ * Notes:
+ *   - This function is called at the end of the assembly process for each assembly file to display the final result.
+ *   - The function takes the 'file_struct' as a parameter to access the file-specific data, such as the number of errors,
+ *     whether the compilation was successful (indicated by 'error_flag'), and the values of the instruction counter (IC)
+ *     and data counter (DC).
+ *   - If no errors were encountered during the assembly process (error_flag == FALSE), the function prints a success message
+ *     indicating that the compilation was completed successfully.
+ *   - The errors recorded by the passes are printed first, at once, in the 'diagnostics_format' of the file.
+ *   - In the JSON and SARIF formats only the diagnostics are printed, their object holds the result of the file.
+ */
+void print_end_of_file(ptr_file file_struct);
+
+#endif /* ASSEMBLER_H */
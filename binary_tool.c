@@ -0,0 +1,215 @@
+#include "binary_tool.h"
+
+/*
+ * Function: append_integer_to_buffer
+ * ----------------------------------
+ * Appends an unsigned integer to a buffer, in little-endian order.
+ *
+ * Parameters:
+ *   - buffer: A pointer to the buffer.
+ *   - value: The value to be appended.
+ *   - size: The number of bytes of the integer, at most 4 (2 or 4 for the fields of the header and the records, 3 for
+ *           two packed words).
+ */
+static void append_integer_to_buffer(ptr_buffer buffer, unsigned long value, int size);
+
+/*
+ * Function: append_record_to_buffer
+ * ---------------------------------
+ * Appends a record (a name and an address) to the buffer of the records. The name is added to the string table only
+ * the first time it is seen, so every external label is kept once however many words refer to it.
+ *
+ * Parameters:
+ *   - records: A pointer to the buffer of the records.
+ *   - strings: A pointer to the string table.
+ *   - name: A null-terminated name.
+ *   - address: The address of the record.
+ */
+static void append_record_to_buffer(ptr_buffer records, ptr_string_table strings, const char *name, int address);
+
+/*
+ * Function: init_string_table
+ * ---------------------------
+ * Initializes an empty string table with room for a given number of names.
+ *
+ * Parameters:
+ *   - strings: A pointer to the string table.
+ *   - count_names: The largest number of names the table will hold (the table is not grown).
+ *
+ * Notes:
+ *   - If dynamic memory allocation fails, the function prints an error message to stderr and exits the program.
+ */
+static void init_string_table(ptr_string_table strings, int count_names);
+
+/*
+ * Function: add_to_string_table
+ * -----------------------------
+ * Finds a name in the string table, adding it at the end of the table if it is not there yet.
+ *
+ * Parameters:
+ *   - strings: A pointer to the string table.
+ *   - name: A null-terminated name.
+ *
+ * Returns:
+ *   - size_t: The offset of the name in the text of the string table.
+ */
+static size_t add_to_string_table(ptr_string_table strings, const char *name);
+
+/*
+ * Function: free_string_table
+ * ---------------------------
+ * Frees the memory of the string table.
+ *
+ * Parameters:
+ *   - strings: A pointer to the string table.
+ */
+static void free_string_table(ptr_string_table strings);
+
+/*
+ * Function: append_words_to_buffer
+ * --------------------------------
+ * Appends the words of an image to a buffer, packed two words in three bytes.
+ *
+ * Parameters:
+ *   - buffer: A pointer to the buffer.
+ *   - words: A pointer to the words of the image.
+ *   - count_words: The number of words of the image.
+ *   - pending: A pointer to the word waiting for its pair (-1 if there is none), carried from one image to the next.
+ */
+static void append_words_to_buffer(ptr_buffer buffer, const unsigned int *words, int count_words, long *pending);
+
+void create_binary_object_file(ptr_file sfile){
+    item_string_table strings;
+    item_buffer binary;
+    item_buffer entry_records;
+    item_buffer extern_records;
+    ptr_label temp_node;
+    const char *line;
+    const char *tab;
+    size_t position = 0;
+    size_t length;
+    long pending = -1;
+    int count_instructions = sfile->IC - FIRST_CELL_IN_MEMORY;
+    char name[MAX_ASSEMBLY_LINE_LENGTH];
+
+    init_buffer(&binary);
+    init_buffer(&entry_records);
+    init_buffer(&extern_records);
+
+    /* Every name of a record is a label of the table, so the string table has at most that many names */
+    init_string_table(&strings, sfile->label_table.count_label);
+
+    /* The entry records, in the order of the label table (as the '.ent' file) */
+    for (temp_node = sfile->label_table.head_label; temp_node != NULL; temp_node = temp_node->next){
+        if (temp_node->type == ENTRY){
+            append_record_to_buffer(&entry_records, &strings, temp_node->name_label, temp_node->address_label);
+        }
+    }
+
+    /* The extern records, from the lines "<name>\t<address>" of the external references (as the '.ext' file) */
+    while ((line = get_line_view_of_buffer(&sfile->extern_list, &position, MAX_ASSEMBLY_LINE_LENGTH, &length)) != NULL){
+        tab = (const char *) memchr(line, '\t', length);
+        if (tab != NULL){
+            memcpy(name, line, length);
+            name[length] = '\0';
+            name[tab - line] = '\0';
+            append_record_to_buffer(&extern_records, &strings, name, atoi(name + (tab - line) + 1));
+        }
+    }
+
+    /* The header */
+    append_to_buffer(&binary, BINARY_MAGIC, 4);
+    append_integer_to_buffer(&binary, BINARY_VERSION, 2);
+    append_integer_to_buffer(&binary, WORD_BITS, 2);
+    append_integer_to_buffer(&binary, FIRST_CELL_IN_MEMORY, 4);
+    append_integer_to_buffer(&binary, (unsigned long) count_instructions, 4);
+    append_integer_to_buffer(&binary, (unsigned long) sfile->DC, 4);
+    append_integer_to_buffer(&binary, (unsigned long) (entry_records.length / BINARY_RECORD_LENGTH), 4);
+    append_integer_to_buffer(&binary, (unsigned long) (extern_records.length / BINARY_RECORD_LENGTH), 4);
+    append_integer_to_buffer(&binary, (unsigned long) strings.text.length, 4);
+
+    /* The packed words of the code image and then of the data image, the records and the string table */
+    append_words_to_buffer(&binary, sfile->instruction_array.words, count_instructions, &pending);
+    append_words_to_buffer(&binary, sfile->data_array.words, sfile->DC, &pending);
+    if (pending != -1){
+        append_integer_to_buffer(&binary, (unsigned long) pending, 3);
+    }
+    append_to_buffer(&binary, entry_records.text, entry_records.length);
+    append_to_buffer(&binary, extern_records.text, extern_records.length);
+    append_to_buffer(&binary, strings.text.text, strings.text.length);
+
+    /* Write the whole binary object file at once */
+    if (write_file_of_struct(sfile, EXT_BINARY, binary.text, binary.length) == TRUE){
+        sfile->stats.bytes_written += (long) binary.length;
+    }
+
+    free_string_table(&strings);
+    free_buffer(&extern_records);
+    free_buffer(&entry_records);
+    free_buffer(&binary);
+}
+
+static void append_integer_to_buffer(ptr_buffer buffer, unsigned long value, int size){
+    char bytes[4];
+    int i;
+
+    for (i = 0; i < size; i++){
+        bytes[i] = (char) ((value >> (8 * i)) & 0xFF);
+    }
+    append_to_buffer(buffer, bytes, (size_t) size);
+}
+
+static void append_record_to_buffer(ptr_buffer records, ptr_string_table strings, const char *name, int address){
+    append_integer_to_buffer(records, (unsigned long) add_to_string_table(strings, name), 4);
+    append_integer_to_buffer(records, (unsigned long) address, 4);
+}
+
+static void init_string_table(ptr_string_table strings, int count_names){
+    strings->size_slots = INITIAL_HASH_TABLE_SIZE;
+    while (strings->size_slots < count_names * 2){
+        strings->size_slots *= 2;
+    }
+    strings->slots = (long *) malloc(sizeof(long) * (size_t) strings->size_slots);
+    if (strings->slots == NULL){
+        fprintf(stderr, "Error in dynamic memory allocation");
+        exit(EXIT_FAILURE);
+    }
+    memset(strings->slots, -1, sizeof(long) * (size_t) strings->size_slots);
+    init_buffer(&strings->text);
+}
+
+static size_t add_to_string_table(ptr_string_table strings, const char *name){
+    unsigned long mask = (unsigned long) strings->size_slots - 1;
+    unsigned long index = hash_name(name) & mask;
+
+    /* Linear probing: move to the next slot until the name or an empty slot is found */
+    while (strings->slots[index] != -1 && strcmp(strings->text.text + strings->slots[index], name) != 0){
+        index = (index + 1) & mask;
+    }
+    if (strings->slots[index] == -1){
+        strings->slots[index] = (long) strings->text.length;
+        append_to_buffer(&strings->text, name, strlen(name) + 1);
+    }
+    return (size_t) strings->slots[index];
+}
+
+static void free_string_table(ptr_string_table strings){
+    free(strings->slots);
+    free_buffer(&strings->text);
+}
+
+static void append_words_to_buffer(ptr_buffer buffer, const unsigned int *words, int count_words, long *pending){
+    unsigned long word;
+    int i;
+
+    for (i = 0; i < count_words; i++){
+        word = words[i] & WORD_MASK;
+        if (*pending == -1){
+            *pending = (long) word;
+        } else {
+            /* Two words fill three bytes, the first one in the low bits */
+            append_integer_to_buffer(buffer, (unsigned long) *pending | (word << WORD_BITS), 3);
+            *pending = -1;
+        }
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ * Header: binary_tool.h
+ * ---------------------
+ * This header file defines the binary object file ('.obj', written with the '--binary' option) and the function that
+ * writes it.
+ *
+ * The binary object file holds in one file everything the text files ('.ob', '.ent' and '.ext') hold, in a fixed
+ * layout that a loader reads with a single read (or maps into memory) without parsing any text. All the integers are
+ * unsigned and little-endian:
+ *
+ *   Offset  Size  Field
+ *   0       4     Magic "AOBJ" ('BINARY_MAGIC')
+ *   4       2     Version of the format ('BINARY_VERSION')
+ *   6       2     Bits of every word ('WORD_BITS', 12)
+ *   8       4     Address of the first word (FIRST_CELL_IN_MEMORY)
+ *   12      4     Number of instruction words (IC - FIRST_CELL_IN_MEMORY)
+ *   16      4     Number of data words (DC)
+ *   20      4     Number of entry records
+ *   24      4     Number of extern records
+ *   28      4     Number of bytes of the string table
+ *   32            The words: the instruction words and then the data words, packed two words in three bytes (the
+ *                 first word in the low 12 bits); an odd last word is padded with a zero word
+ *   ...           The entry records, 8 bytes each: the offset of the name in the string table and the address of
+ *                 the label, in the order of the '.ent' file
+ *   ...           The extern records, 8 bytes each: the offset of the name in the string table and the address of
+ *                 the word that refers to it, in the order of the '.ext' file
+ *   ...           The string table: the null-terminated names of the records, every name once
+ *
+ * Included Files:
+ *   - stdio.h: Standard Input/Output library. It provides functions for input and output operations, such as file handling.
+ *   - stdlib.h: Standard Library. It provides functions for memory allocation, conversion, and other utility functions.
+ *   - string.h: C String Library. It provides functions for manipulating strings, such as string copying and comparison.
+ *   - file_tool.h: Contains the file struct holding the images, the labels and the external references of a file.
+ *   - buffer_tool.h: Contains the growable buffer the binary object file is built in.
+ *   - label_list.h: Contains the table of labels, walked for the entry labels.
+ *   - text_tool.h: Contains 'hash_name', used to keep every name of the string table once.
+ *   - setting.h: Contains constant definitions and configurations used throughout the assembly process.
+ */
+
+#ifndef BINARY_TOOL_H
+#define BINARY_TOOL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "file_tool.h"
+#include "buffer_tool.h"
+#include "label_list.h"
+#include "text_tool.h"
+#include "setting.h"
+
+/*
+ * Struct: item_string_table
+ * -------------------------
+ * A structure representing the string table of the binary object file while it is built: the names, each one kept
+ * once, indexed by an open-addressing hash table with linear probing.
+ *
+ * Fields:
+ *   - text: The null-terminated names, one after the other (the string table written to the file).
+ *   - slots: An array of 'size_slots' offsets of names in 'text'. An empty slot holds -1.
+ *   - size_slots: The number of slots (a power of two, at least twice the number of names).
+ */
+typedef struct string_table_struct * ptr_string_table;
+typedef struct string_table_struct {
+    item_buffer text;
+    long *slots;
+    int size_slots;
+} item_string_table;
+
+/*
+ * Function: create_binary_object_file
+ * -----------------------------------
+ * Builds the binary object file of a file that was assembled without errors and writes it at once.
+ *
+ * Parameters:
+ *   - sfile: A pointer to the file struct, after the second pass (the code image is complete, the entry labels are
+ *            marked and 'extern_list' holds the external references).
+ *
+ * Notes:
+ *   - The file is written at once with 'write_file_of_struct': to a temporary file that is renamed over the output
+ *     ('write_file'), or to 'memory_texts' for a struct kept in memory. A file that already holds the same bytes is
+ *     not written again.
+ *   - If dynamic memory allocation fails, the function prints an error message to stderr and exits the program.
+ */
+void create_binary_object_file(ptr_file sfile);
+
+#endif /* BINARY_TOOL_H */
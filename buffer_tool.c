@@ -0,0 +1,167 @@
+#include "buffer_tool.h"
+
+/*
+ * Function: reserve_buffer
+ * ------------------------
+ * Makes sure the buffer has room for 'length' more characters and a null terminator.
+ *
+ * Parameters:
+ *   - buffer: A pointer to the buffer.
+ *   - length: The number of characters that are about to be appended.
+ *
+ * Notes:
+ *   - The capacity is doubled until it is big enough, so the number of reallocations is logarithmic in the final length.
+ *   - If dynamic memory allocation fails, the function prints an error message to stderr and exits the program.
+ */
+static void reserve_buffer(ptr_buffer buffer, size_t length);
+
+void init_buffer(ptr_buffer buffer){
+    buffer->text = NULL;
+    buffer->length = 0;
+    buffer->capacity = 0;
+}
+
+void append_to_buffer(ptr_buffer buffer, const char *text, size_t length){
+    /* Make room for the new characters and the null terminator */
+    reserve_buffer(buffer, length);
+
+    /* Copy the characters to the end of the buffer and keep it null-terminated ('text' may be NULL when it is empty,
+     * such as the text of an empty buffer, so nothing is copied then) */
+    if (length > 0){
+        memcpy(buffer->text + buffer->length, text, length);
+    }
+    buffer->length += length;
+    buffer->text[buffer->length] = '\0';
+}
+
+void append_text_to_buffer(ptr_buffer buffer, const char *text){
+    append_to_buffer(buffer, text, strlen(text));
+}
+
+void append_address_line_to_buffer(ptr_buffer buffer, const char *name, int address){
+    size_t length_name = strlen(name);
+
+    /* Make room for the name, the tab, the address and the newline */
+    reserve_buffer(buffer, length_name + MAX_DIGITS_FOR_NUMBER + 2);
+
+    /* Write the line at the write cursor ('length') of the buffer */
+    memcpy(buffer->text + buffer->length, name, length_name);
+    buffer->length += length_name;
+    buffer->length += (size_t) sprintf(buffer->text + buffer->length, "\t%d\n", address);
+}
+
+void truncate_buffer(ptr_buffer buffer, size_t length){
+    if (length < buffer->length){
+        buffer->length = length;
+        buffer->text[length] = '\0';
+    }
+}
+
+void read_file_to_buffer(ptr_buffer buffer, FILE *file){
+    size_t count;
+
+    /* Read big blocks straight into the free space at the end of the buffer until the end of the file */
+    do {
+        reserve_buffer(buffer, READ_BLOCK_SIZE);
+        count = fread(buffer->text + buffer->length, 1, buffer->capacity - buffer->length - 1, file);
+        buffer->length += count;
+        buffer->text[buffer->length] = '\0';
+    } while (count > 0);
+}
+
+const char * get_line_view_of_buffer(ptr_buffer buffer, size_t *position, int size, size_t *length){
+    const char *line = buffer->text + *position;
+    const char *newline;
+    size_t limit;
+
+    if (*position >= buffer->length){
+        return NULL;
+    }
+
+    /* The line ends after its newline character, or after 'size' - 1 characters */
+    limit = buffer->length - *position;
+    if (limit > (size_t) (size - 1)){
+        limit = (size_t) (size - 1);
+    }
+    newline = (const char *) memchr(line, '\n', limit);
+    *length = (newline != NULL) ? (size_t) (newline - line) + 1 : limit;
+    *position += *length;
+    return line;
+}
+
+char * read_line_of_buffer(ptr_buffer buffer, size_t *position, char *line, int size){
+    const char *view;
+    size_t length;
+
+    view = get_line_view_of_buffer(buffer, position, size, &length);
+    if (view == NULL){
+        return NULL;
+    }
+
+    /* Copy the characters of the line at once and null-terminate it */
+    memcpy(line, view, length);
+    line[length] = '\0';
+    return line;
+}
+
+void free_buffer(ptr_buffer buffer){
+    free(buffer->text);
+    init_buffer(buffer);
+}
+
+static void reserve_buffer(ptr_buffer buffer, size_t length){
+    size_t new_capacity = (buffer->capacity == 0) ? INITIAL_BUFFER_SIZE : buffer->capacity;
+
+    /* Nothing to do if the new characters and the null terminator already fit */
+    if (buffer->length + length < buffer->capacity){
+        return;
+    }
+
+    /* Double the capacity until the new characters and the null terminator fit */
+    while (buffer->length + length >= new_capacity){
+        new_capacity *= 2;
+    }
+    buffer->text = (char *) realloc(buffer->text, new_capacity);
+    if (buffer->text == NULL){
+        fprintf(stderr, "Error in dynamic memory allocation");
+        exit(EXIT_FAILURE);
+    }
+    buffer->capacity = new_capacity;
+}
+
+void init_word_array(ptr_word_array array){
+    array->words = NULL;
+    array->capacity = 0;
+}
+
+unsigned int * get_word_of_array(ptr_word_array array, int index){
+    int new_capacity = (array->capacity == 0) ? INITIAL_WORD_ARRAY_SIZE : array->capacity;
+
+    if (index >= array->capacity){
+        /* Double the capacity until the index fits */
+        while (index >= new_capacity){
+            new_capacity *= 2;
+        }
+        array->words = (unsigned int *) realloc(array->words, sizeof(unsigned int) * (size_t) new_capacity);
+        if (array->words == NULL){
+            fprintf(stderr, "Error in dynamic memory allocation");
+            exit(EXIT_FAILURE);
+        }
+
+        /* The new words are zero, as in a fresh memory image */
+        memset(array->words + array->capacity, 0, sizeof(unsigned int) * (size_t) (new_capacity - array->capacity));
+        array->capacity = new_capacity;
+    }
+    return &array->words[index];
+}
+
+void clear_word_array(ptr_word_array array){
+    if (array->words != NULL){
+        memset(array->words, 0, sizeof(unsigned int) * (size_t) array->capacity);
+    }
+}
+
+void free_word_array(ptr_word_array array){
+    free(array->words);
+    init_word_array(array);
+}
@@ -0,0 +1,254 @@
+/*
+ * Header: buffer_tool.h
+ * ---------------------
+ * This header file defines a growable text buffer and a growable array of machine words, and the functions used to
+ * manage them. The buffer is used wherever the assembler builds text of unknown length (for example the bodies of the
+ * macros), and the word array holds the code and data images of a file, so the memory used is proportional to the
+ * actual text or program instead of a fixed maximum.
+ *
+ * Included Files:
+ *   - stdio.h: Standard Input/Output library. It provides functions for input and output operations, such as file handling.
+ *   - stdlib.h: Standard Library. It provides functions for memory allocation, conversion, and other utility functions.
+ *   - string.h: C String Library. It provides functions for manipulating strings, such as string copying and comparison.
+ *   - setting.h: Contains constant definitions and configurations used throughout the assembly process.
+ */
+
+#ifndef BUFFER_TOOL_H
+#define BUFFER_TOOL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "setting.h"
+
+/*
+ * Struct: item_buffer
+ * -------------------
+ * A structure representing a growable text buffer.
+ *
+ * Fields:
+ *   - text: A pointer to the dynamically allocated characters of the buffer (NULL before the first append).
+ *   - length: The number of characters stored in the buffer.
+ *   - capacity: The number of characters allocated for 'text'.
+ *
+ * Notes:
+ *   - When the buffer is not empty, 'text[length]' is always a null terminator, so the whole buffer can be used as a string.
+ *   - The capacity is doubled whenever the buffer is full, so appending n characters takes amortized O(n) time.
+ */
+typedef struct buffer_struct * ptr_buffer;
+typedef struct buffer_struct {
+    char *text;
+    size_t length;
+    size_t capacity;
+} item_buffer;
+
+/*
+ * Struct: item_word_array
+ * -----------------------
+ * A structure representing a growable array of machine words (the code or the data image of a file).
+ *
+ * Fields:
+ *   - words: A pointer to the dynamically allocated words of the array (NULL before the first word is stored).
+ *   - capacity: The number of words allocated for 'words'.
+ *
+ * Notes:
+ *   - The array does not keep the number of words stored in it; the counters of the passes ('IC' and 'DC') do.
+ *   - The capacity is doubled whenever a word is stored past its end, so storing n words takes amortized O(n) time.
+ */
+typedef struct word_array_struct * ptr_word_array;
+typedef struct word_array_struct {
+    unsigned int *words;
+    int capacity;
+} item_word_array;
+
+/*
+ * Function: init_buffer
+ * ---------------------
+ * Initializes an empty buffer.
+ *
+ * Parameters:
+ *   - buffer: A pointer to the buffer to be initialized.
+ *
+ * Notes:
+ *   - No memory is allocated here; the characters are allocated on the first append.
+ */
+void init_buffer(ptr_buffer buffer);
+
+/*
+ * Function: append_to_buffer
+ * --------------------------
+ * Appends 'length' characters of 'text' at the end of the buffer.
+ *
+ * Parameters:
+ *   - buffer: A pointer to the buffer.
+ *   - text: A pointer to the characters to be appended (they do not have to be null-terminated). It may be NULL if
+ *           'length' is zero (the text of an empty buffer).
+ *   - length: The number of characters to be appended.
+ *
+ * Notes:
+ *   - If the buffer is full, its capacity is doubled (starting from 'INITIAL_BUFFER_SIZE').
+ *   - If dynamic memory allocation fails, the function prints an error message to stderr and exits the program.
+ */
+void append_to_buffer(ptr_buffer buffer, const char *text, size_t length);
+
+/*
+ * Function: append_text_to_buffer
+ * -------------------------------
+ * Appends a null-terminated string at the end of the buffer.
+ *
+ * Parameters:
+ *   - buffer: A pointer to the buffer.
+ *   - text: A pointer to the null-terminated string to be appended.
+ */
+void append_text_to_buffer(ptr_buffer buffer, const char *text);
+
+/*
+ * Function: append_address_line_to_buffer
+ * ---------------------------------------
+ * Appends a line of the form "<name>\t<address>\n" at the end of the buffer (a line of the '.ent' or '.ext' files).
+ *
+ * Parameters:
+ *   - buffer: A pointer to the buffer.
+ *   - name: A pointer to the null-terminated name of the label.
+ *   - address: The address written after the name.
+ *
+ * Notes:
+ *   - The room for the whole line is reserved once, and the line is written at the end of the buffer ('length' is the
+ *     write cursor), so building a file of n lines takes O(n) time.
+ */
+void append_address_line_to_buffer(ptr_buffer buffer, const char *name, int address);
+
+/*
+ * Function: truncate_buffer
+ * -------------------------
+ * Shortens the buffer to its first 'length' characters.
+ *
+ * Parameters:
+ *   - buffer: A pointer to the buffer.
+ *   - length: The new length of the buffer. It must not be bigger than the current length.
+ *
+ * Notes:
+ *   - The memory of the buffer is kept, so the next appends reuse it.
+ */
+void truncate_buffer(ptr_buffer buffer, size_t length);
+
+/*
+ * Function: read_file_to_buffer
+ * -----------------------------
+ * Appends the whole rest of a stream at the end of the buffer.
+ *
+ * Parameters:
+ *   - buffer: A pointer to the buffer.
+ *   - file: The stream to be read, from its current position to its end.
+ *
+ * Notes:
+ *   - The stream is read in blocks of at least 'READ_BLOCK_SIZE' characters straight into the buffer, so a source is
+ *     read with a few calls instead of one call for each of its lines.
+ *   - If dynamic memory allocation fails, the function prints an error message to stderr and exits the program.
+ */
+void read_file_to_buffer(ptr_buffer buffer, FILE *file);
+
+/*
+ * Function: get_line_view_of_buffer
+ * ---------------------------------
+ * Finds the next line of the text of the buffer without copying it (a view of the line).
+ *
+ * Parameters:
+ *   - buffer: A pointer to the buffer holding the text.
+ *   - position: A pointer to the read position in the buffer. It is advanced past the line.
+ *   - size: The size of the array a line is read into; the line has at most 'size' - 1 characters.
+ *   - length: A pointer that receives the number of characters of the line.
+ *
+ * Returns:
+ *   - const char*: A pointer to the first character of the line in the buffer, or NULL if the read position is at the
+ *     end of the text. The line is not null-terminated; it is valid until the buffer is changed.
+ *
+ * Notes:
+ *   - The end of the line is found with 'memchr', and the line ends as it would with 'fgets' (see 'read_line_of_buffer').
+ */
+const char * get_line_view_of_buffer(ptr_buffer buffer, size_t *position, int size, size_t *length);
+
+/*
+ * Function: read_line_of_buffer
+ * -----------------------------
+ * Reads the next line of the text of the buffer, the same way 'fgets' reads the next line of a stream.
+ *
+ * Parameters:
+ *   - buffer: A pointer to the buffer holding the text.
+ *   - position: A pointer to the read position in the buffer. It is advanced past the characters read.
+ *   - line: The array that receives the line.
+ *   - size: The size of 'line'. At most 'size' - 1 characters are read.
+ *
+ * Returns:
+ *   - char*: A pointer to 'line', or NULL if the read position is at the end of the text (nothing was read).
+ *
+ * Notes:
+ *   - Reading stops after a newline character (which is kept in 'line') or after 'size' - 1 characters, so a long
+ *     line is split exactly as 'fgets' would split it. The line is always null-terminated.
+ *   - The line is found with 'get_line_view_of_buffer' and copied at once; the rest of 'line' is not touched, so it
+ *     does not have to be cleared before the call.
+ */
+char * read_line_of_buffer(ptr_buffer buffer, size_t *position, char *line, int size);
+
+/*
+ * Function: free_buffer
+ * ---------------------
+ * Frees the memory of the buffer and leaves it empty (as after 'init_buffer').
+ *
+ * Parameters:
+ *   - buffer: A pointer to the buffer to be freed.
+ */
+void free_buffer(ptr_buffer buffer);
+
+/*
+ * Function: init_word_array
+ * -------------------------
+ * Initializes an empty word array.
+ *
+ * Parameters:
+ *   - array: A pointer to the word array to be initialized.
+ *
+ * Notes:
+ *   - No memory is allocated here; the words are allocated when the first word is stored.
+ */
+void init_word_array(ptr_word_array array);
+
+/*
+ * Function: get_word_of_array
+ * ---------------------------
+ * Returns a pointer to the word at 'index' of the array, growing the array if it is too short.
+ *
+ * Parameters:
+ *   - array: A pointer to the word array.
+ *   - index: The index of the word (zero or more).
+ *
+ * Returns:
+ *   - unsigned int*: A pointer to the word, valid until the array grows again.
+ *
+ * Notes:
+ *   - The capacity is doubled (starting from 'INITIAL_WORD_ARRAY_SIZE') until 'index' fits, and the new words are zero.
+ *   - If dynamic memory allocation fails, the function prints an error message to stderr and exits the program.
+ */
+unsigned int * get_word_of_array(ptr_word_array array, int index);
+
+/*
+ * Function: clear_word_array
+ * --------------------------
+ * Sets every word of the word array to zero (as in a fresh memory image), keeping its memory.
+ *
+ * Parameters:
+ *   - array: A pointer to the word array to be cleared.
+ */
+void clear_word_array(ptr_word_array array);
+
+/*
+ * Function: free_word_array
+ * -------------------------
+ * Frees the memory of the word array and leaves it empty (as after 'init_word_array').
+ *
+ * Parameters:
+ *   - array: A pointer to the word array to be freed.
+ */
+void free_word_array(ptr_word_array array);
+
+#endif /* BUFFER_TOOL_H */
@@ -0,0 +1,283 @@
+#include "cache_tool.h"
+
+/* The texts of an entry, in the order in which they are kept in the file of the entry */
+enum {CACHE_SOURCE, CACHE_LOG, CACHE_MACRO, CACHE_OBJECT, CACHE_ENTRY, CACHE_EXTERN, CACHE_BINARY};
+
+/* Number of texts of an entry */
+#define COUNT_CACHE_TEXTS 7
+
+/* The output file of every text of an entry (the source and the messages are not output files) */
+static const file_ext ext_of_cache_texts[COUNT_CACHE_TEXTS] = {
+        EXT_INPUT, EXT_INPUT, EXT_MACRO, EXT_OBJECT, EXT_ENTRY, EXT_EXTERN, EXT_BINARY
+};
+
+/*
+ * Function: hash_text
+ * -------------------
+ * Mixes characters into a pair of 32-bit hash values (FNV-1a and djb2), used together as a 64-bit hash.
+ *
+ * Parameters:
+ *   - hashes: The two hash values, updated in place.
+ *   - text: A pointer to the characters.
+ *   - length: The number of characters.
+ */
+static void hash_text(unsigned long hashes[2], const char *text, size_t length);
+
+/*
+ * Function: read_whole_file
+ * -------------------------
+ * Reads a whole file into a buffer.
+ *
+ * Parameters:
+ *   - buffer: A pointer to the (empty) buffer that receives the text.
+ *   - path: The path of the file.
+ *
+ * Returns:
+ *   - bool: TRUE if the file was read, FALSE if it cannot be opened.
+ */
+static bool read_whole_file(ptr_buffer buffer, const char *path);
+
+/*
+ * Function: parse_text_of_entry
+ * -----------------------------
+ * Reads the next text of an entry: its length on a line of its own (-1 for a file that was not produced), followed by
+ * its characters.
+ *
+ * Parameters:
+ *   - entry: A pointer to the buffer holding the whole entry.
+ *   - position: A pointer to the read position in the entry, advanced past the text.
+ *   - text: A pointer that receives the first character of the text in the entry (NULL if the file was not produced).
+ *   - length: A pointer that receives the number of characters of the text.
+ *
+ * Returns:
+ *   - bool: TRUE if the text was read, FALSE if the entry is damaged.
+ */
+static bool parse_text_of_entry(ptr_buffer entry, size_t *position, const char **text, size_t *length);
+
+/*
+ * Function: write_text_of_entry
+ * -----------------------------
+ * Writes one text of an entry (the format read by 'parse_text_of_entry').
+ *
+ * Parameters:
+ *   - file: The stream of the entry.
+ *   - text: A pointer to the characters of the text, or NULL for a file that was not produced.
+ *   - length: The number of characters of the text.
+ */
+static void write_text_of_entry(FILE *file, const char *text, size_t length);
+
+bool create_cache_directory(const char *cache_dir){
+    struct stat status;
+
+    if (stat(cache_dir, &status) == 0){
+        return S_ISDIR(status.st_mode) ? TRUE : FALSE;
+    }
+    return (mkdir(cache_dir, 0777) == 0) ? TRUE : FALSE;
+}
+
+void init_cache_key(ptr_cache_key key, const char *cache_dir, const char *name_file, FILE *file_as, bool am_flag,
+                    bool binary_flag, diagnostics_format format, int max_errors){
+    unsigned long hashes[2] = {2166136261UL, 5381UL};
+    char flags[2 + MAX_DIGITS_FOR_NUMBER + 2];
+
+    /* The key of the entry covers the version of the assembler, the options that change the outputs (or the stored
+     * messages) and the source */
+    init_buffer(&key->source);
+    read_file_to_buffer(&key->source, file_as);
+    hash_text(hashes, ASSEMBLER_VERSION, strlen(ASSEMBLER_VERSION));
+    flags[0] = (am_flag == TRUE) ? '1' : '0';
+    flags[1] = (binary_flag == TRUE) ? '1' : '0';
+    sprintf(flags + 2, "%d:%d", (int) format, max_errors);
+    hash_text(hashes, flags, strlen(flags));
+
+    /* The JSON and SARIF messages hold the name of the file, so a copy of the source under another name is another entry */
+    if (format == FORMAT_JSON || format == FORMAT_SARIF){
+        hash_text(hashes, name_file, strlen(name_file) + 1);
+    }
+    hash_text(hashes, key->source.text != NULL ? key->source.text : "", key->source.length);
+    key->am_flag = am_flag;
+    key->binary_flag = binary_flag;
+
+    /* The name of the entry is the hash in hexadecimal */
+    key->path_entry = (char *) malloc(strlen(cache_dir) + 2 * 8 + 8);
+    if (key->path_entry == NULL){
+        fprintf(stderr, "Error in dynamic memory allocation");
+        exit(EXIT_FAILURE);
+    }
+    sprintf(key->path_entry, "%s/%08lx%08lx.cache", cache_dir, hashes[0], hashes[1]);
+}
+
+bool restore_from_cache(ptr_cache_key key, char *name_file, FILE *file_log, ptr_stats stats, bool *restored){
+    item_buffer entry;
+    const char *texts[COUNT_CACHE_TEXTS];
+    size_t lengths[COUNT_CACHE_TEXTS];
+    size_t position;
+    size_t length_header = strlen(CACHE_HEADER ASSEMBLER_VERSION "\n");
+    bool result = FALSE;
+    int i;
+
+    for (i = 0; i < COUNT_FILE_EXT; i++){
+        restored[i] = FALSE;
+    }
+    init_buffer(&entry);
+    if (read_whole_file(&entry, key->path_entry) == FALSE){
+        return FALSE;
+    }
+
+    /* The entry must belong to this version of the assembler and hold a copy of the same source */
+    if (entry.length >= length_header && memcmp(entry.text, CACHE_HEADER ASSEMBLER_VERSION "\n", length_header) == 0){
+        position = length_header;
+        for (i = 0; i < COUNT_CACHE_TEXTS; i++){
+            if (parse_text_of_entry(&entry, &position, &texts[i], &lengths[i]) == FALSE){
+                break;
+            }
+        }
+        if (i == COUNT_CACHE_TEXTS && texts[CACHE_SOURCE] != NULL && lengths[CACHE_SOURCE] == key->source.length &&
+            memcmp(texts[CACHE_SOURCE], key->source.text != NULL ? key->source.text : "", key->source.length) == 0){
+            result = TRUE;
+        }
+    }
+
+    if (result == TRUE){
+        /* Write every output file kept in the entry and print the messages of the assembly */
+        for (i = CACHE_MACRO; i < COUNT_CACHE_TEXTS; i++){
+            if (texts[i] != NULL){
+                if (write_file(name_file, ext_of_cache_texts[i], texts[i], lengths[i]) == TRUE){
+                    stats->bytes_written += (long) lengths[i];
+                }
+                restored[ext_of_cache_texts[i]] = TRUE;
+            }
+        }
+        fwrite(texts[CACHE_LOG], 1, lengths[CACHE_LOG], file_log);
+        stats->bytes_read += (long) key->source.length;
+        (stats->count_cache_hits)++;
+    }
+    free_buffer(&entry);
+    return result;
+}
+
+void store_in_cache(ptr_cache_key key, ptr_file file_struct, const char *text_log, size_t length_log){
+    item_buffer outputs[COUNT_CACHE_TEXTS];
+    bool produced[COUNT_CACHE_TEXTS] = {FALSE, FALSE, FALSE, FALSE, FALSE, FALSE, FALSE};
+    char full_name[MAX_FULL_FILE_NAME_LENGTH];
+    char *path_temp;
+    FILE *file;
+    int descriptor;
+    int i;
+
+    /* The output files produced by this assembly (older files with the same names are not part of the result) */
+    produced[CACHE_MACRO] = file_struct->am_flag;
+    if (file_struct->error_flag == FALSE){
+        produced[CACHE_OBJECT] = TRUE;
+        produced[CACHE_ENTRY] = file_struct->entry_flag;
+        produced[CACHE_EXTERN] = file_struct->extern_flag;
+        produced[CACHE_BINARY] = file_struct->binary_flag;
+    }
+    for (i = CACHE_MACRO; i < COUNT_CACHE_TEXTS; i++){
+        init_buffer(&outputs[i]);
+        if (produced[i] == TRUE &&
+            read_whole_file(&outputs[i], get_file_with_extension(file_struct->name_file, ext_of_cache_texts[i], full_name)) == FALSE){
+            produced[i] = FALSE;
+        }
+    }
+
+    /* Write the entry to a temporary file of the cache directory */
+    path_temp = (char *) malloc(strlen(key->path_entry) + 8);
+    if (path_temp == NULL){
+        fprintf(stderr, "Error in dynamic memory allocation");
+        exit(EXIT_FAILURE);
+    }
+    sprintf(path_temp, "%s.XXXXXX", key->path_entry);
+    descriptor = mkstemp(path_temp);
+    file = (descriptor != -1) ? fdopen(descriptor, "wb") : NULL;
+    if (file != NULL){
+        fputs(CACHE_HEADER ASSEMBLER_VERSION "\n", file);
+        write_text_of_entry(file, key->source.text != NULL ? key->source.text : "", key->source.length);
+        write_text_of_entry(file, text_log != NULL ? text_log : "", length_log);
+        for (i = CACHE_MACRO; i < COUNT_CACHE_TEXTS; i++){
+            write_text_of_entry(file, produced[i] == TRUE ? (outputs[i].text != NULL ? outputs[i].text : "") : NULL,
+                                outputs[i].length);
+        }
+
+        /* Publish the entry under its name at once, or drop it if it was not written completely */
+        if (fclose(file) == 0){
+            if (rename(path_temp, key->path_entry) != 0){
+                unlink(path_temp);
+            }
+        } else {
+            unlink(path_temp);
+        }
+    } else if (descriptor != -1){
+        close(descriptor);
+        unlink(path_temp);
+    }
+
+    free(path_temp);
+    for (i = CACHE_MACRO; i < COUNT_CACHE_TEXTS; i++){
+        free_buffer(&outputs[i]);
+    }
+}
+
+void free_cache_key(ptr_cache_key key){
+    free(key->path_entry);
+    key->path_entry = NULL;
+    free_buffer(&key->source);
+}
+
+static void hash_text(unsigned long hashes[2], const char *text, size_t length){
+    size_t i;
+
+    for (i = 0; i < length; i++){
+        hashes[0] = ((hashes[0] ^ (unsigned char) text[i]) * 16777619UL) & 0xFFFFFFFFUL;
+        hashes[1] = ((hashes[1] * 33) ^ (unsigned char) text[i]) & 0xFFFFFFFFUL;
+    }
+}
+
+static bool read_whole_file(ptr_buffer buffer, const char *path){
+    FILE *file = fopen(path, "rb");
+
+    if (file == NULL){
+        return FALSE;
+    }
+    read_file_to_buffer(buffer, file);
+    fclose(file);
+    return TRUE;
+}
+
+static bool parse_text_of_entry(ptr_buffer entry, size_t *position, const char **text, size_t *length){
+    char *end;
+    long value;
+
+    if (*position >= entry->length){
+        return FALSE;
+    }
+
+    /* The length of the text, on a line of its own */
+    value = strtol(entry->text + *position, &end, 10);
+    if (end == entry->text + *position || *end != '\n' || value < -1){
+        return FALSE;
+    }
+    *position = (size_t) (end - entry->text) + 1;
+
+    if (value == -1){
+        *text = NULL;
+        *length = 0;
+        return TRUE;
+    }
+    if ((size_t) value > entry->length - *position){
+        return FALSE;
+    }
+    *text = entry->text + *position;
+    *length = (size_t) value;
+    *position += *length;
+    return TRUE;
+}
+
+static void write_text_of_entry(FILE *file, const char *text, size_t length){
+    if (text == NULL){
+        fputs("-1\n", file);
+        return;
+    }
+    fprintf(file, "%lu\n", (unsigned long) length);
+    fwrite(text, 1, length, file);
+}
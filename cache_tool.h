@@ -0,0 +1,145 @@
+/*
+ * Header: cache_tool.h
+ * --------------------
+ * This header file defines the cache of assembled files ('--cache DIR' option) and the functions used to manage it.
+ *
+ * Every entry of the cache is one file in the cache directory, named after a hash of the source ('.as'), the version
+ * of the assembler ('ASSEMBLER_VERSION') and the options that change the output files. The entry holds a copy of the
+ * source, the console messages of the assembly and the output files it produced ('.am', '.ob', '.ent', '.ext', '.obj'). When
+ * a file is assembled again with the same source, its outputs and messages are restored from the entry and none of
+ * the phases runs.
+ *
+ * Included Files:
+ *   - stdio.h: Standard Input/Output library. It provides functions for input and output operations, such as file handling.
+ *   - stdlib.h: Standard Library. It provides functions for memory allocation, conversion, and other utility functions.
+ *   - string.h: C String Library. It provides functions for manipulating strings, such as string copying and comparison.
+ *   - unistd.h: POSIX Standard Library. It provides 'close' and 'unlink', used to write an entry atomically.
+ *   - sys/stat.h: POSIX file status library. It provides 'mkdir', used to create the cache directory.
+ *   - file_tool.h: Contains the file struct and the functions that open the files of a source.
+ *   - buffer_tool.h: Contains the growable text buffer that holds the texts of an entry.
+ *   - stats_tool.h: Contains the statistics of the assembly of a file, which count the hits of the cache.
+ *   - setting.h: Contains constant definitions and configurations used throughout the assembly process.
+ */
+
+#ifndef CACHE_TOOL_H
+#define CACHE_TOOL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "file_tool.h"
+#include "buffer_tool.h"
+#include "stats_tool.h"
+#include "setting.h"
+
+/*
+ * Struct: item_cache_key
+ * ----------------------
+ * A structure representing the key of the entry of one source in the cache.
+ *
+ * Fields:
+ *   - path_entry: The dynamically allocated path of the file of the entry in the cache directory.
+ *   - source: The text of the source, compared with the copy kept in the entry (so two sources with the same hash
+ *             never share an entry).
+ *   - am_flag: A boolean flag indicating if the '.am' file is written (it is part of the key).
+ *   - binary_flag: A boolean flag indicating if the '.obj' file is written (it is part of the key).
+ */
+typedef struct cache_key_struct * ptr_cache_key;
+typedef struct cache_key_struct {
+    char *path_entry;
+    item_buffer source;
+    bool am_flag;
+    bool binary_flag;
+} item_cache_key;
+
+/*
+ * Function: create_cache_directory
+ * --------------------------------
+ * Creates the cache directory if it does not exist yet.
+ *
+ * Parameters:
+ *   - cache_dir: The path of the cache directory.
+ *
+ * Returns:
+ *   - bool: TRUE if the directory exists (or was created), FALSE otherwise.
+ */
+bool create_cache_directory(const char *cache_dir);
+
+/*
+ * Function: init_cache_key
+ * ------------------------
+ * Reads the source of a file and builds the key of its entry in the cache.
+ *
+ * Parameters:
+ *   - key: A pointer to the key to be initialized.
+ *   - cache_dir: The path of the cache directory.
+ *   - name_file: The name of the source (without the '.as' extension). It is part of the key only for the formats
+ *                whose messages hold the name of the file (JSON and SARIF).
+ *   - file_as: The stream of the source file. It is read to its end into 'source' (the caller closes it), and the
+ *              assembly reads the source from the key instead of reading the file again.
+ *   - am_flag: A boolean flag indicating if the '.am' file is written.
+ *   - binary_flag: A boolean flag indicating if the '.obj' file is written.
+ *   - format: The format of the errors in the console messages, which are stored in the entry.
+ *   - max_errors: The largest number of errors printed for the file (0 for no limit).
+ *
+ * Notes:
+ *   - The key must be released with 'free_cache_key'.
+ *   - If dynamic memory allocation fails, the function prints an error message to stderr and exits the program.
+ */
+void init_cache_key(ptr_cache_key key, const char *cache_dir, const char *name_file, FILE *file_as, bool am_flag,
+                    bool binary_flag, diagnostics_format format, int max_errors);
+
+/*
+ * Function: restore_from_cache
+ * ----------------------------
+ * Restores the outputs and the console messages of a source from its entry in the cache, if there is one.
+ *
+ * Parameters:
+ *   - key: A pointer to the key of the source ('init_cache_key').
+ *   - name_file: The name of the source (without the '.as' extension), the outputs are written next to it.
+ *   - file_log: The stream that receives the console messages kept in the entry.
+ *   - stats: A pointer to the statistics of the file, which count the hit and the bytes read and written.
+ *   - restored: An array of 'COUNT_FILE_EXT' flags, indexed by the extension, that receives which output files were
+ *               restored (the output files the assembly would have produced).
+ *
+ * Returns:
+ *   - bool: TRUE if the entry was found and restored (the file does not have to be assembled), FALSE otherwise.
+ *
+ * Notes:
+ *   - An entry that cannot be read, that belongs to another version of the assembler or whose copy of the source
+ *     differs from the source is a miss, never an error.
+ */
+bool restore_from_cache(ptr_cache_key key, char *name_file, FILE *file_log, ptr_stats stats, bool *restored);
+
+/*
+ * Function: store_in_cache
+ * ------------------------
+ * Stores the result of the assembly of a source in its entry in the cache.
+ *
+ * Parameters:
+ *   - key: A pointer to the key of the source ('init_cache_key').
+ *   - file_struct: A pointer to the file struct of the assembly, after the second pass (the outputs produced by the
+ *                  assembly are read back from the disk).
+ *   - text_log: The console messages of the assembly.
+ *   - length_log: The number of characters of 'text_log'.
+ *
+ * Notes:
+ *   - The entry is written to a temporary file in the cache directory and renamed to its name, so a reader (another
+ *     job or another run) never sees a partial entry.
+ *   - If the entry cannot be written, the cache is simply not updated.
+ */
+void store_in_cache(ptr_cache_key key, ptr_file file_struct, const char *text_log, size_t length_log);
+
+/*
+ * Function: free_cache_key
+ * ------------------------
+ * Frees the memory of a key of the cache.
+ *
+ * Parameters:
+ *   - key: A pointer to the key to be freed.
+ */
+void free_cache_key(ptr_cache_key key);
+
+#endif /* CACHE_TOOL_H */
@@ -0,0 +1,180 @@
+#include "diagnostic_list.h"
+
+/*
+ * Function: print_json_string
+ * ---------------------------
+ * Prints a text as a JSON string (between quotes, with its quotes, backslashes and control characters escaped).
+ *
+ * Parameters:
+ *   - stream: The stream the string is printed to.
+ *   - text: The null-terminated text.
+ */
+static void print_json_string(FILE *stream, const char *text);
+
+/*
+ * Function: print_json_of_list
+ * ----------------------------
+ * Prints the diagnostics of the list as one JSON object (the 'FORMAT_JSON' format).
+ *
+ * Parameters:
+ *   - list: A pointer to the list.
+ *   - stream: The stream the object is printed to.
+ *   - name_source: The name of the source file (with its extension).
+ */
+static void print_json_of_list(ptr_diagnostic_list list, FILE *stream, const char *name_source);
+
+/*
+ * Function: print_sarif_of_list
+ * -----------------------------
+ * Prints the diagnostics of the list as one SARIF 2.1.0 log (the 'FORMAT_SARIF' format).
+ *
+ * Parameters:
+ *   - list: A pointer to the list.
+ *   - stream: The stream the log is printed to.
+ *   - name_source: The name of the source file (with its extension).
+ *
+ * Notes:
+ *   - Every diagnostic is a result whose 'ruleId' is the name of its error code. A column of 0 is not written, as a
+ *     region of SARIF starts at column 1.
+ */
+static void print_sarif_of_list(ptr_diagnostic_list list, FILE *stream, const char *name_source);
+
+void init_diagnostic_list(ptr_diagnostic_list list){
+    list->diagnostics = NULL;
+    list->count_diagnostic = 0;
+    list->size_diagnostics = 0;
+    list->max_diagnostics = 0;
+    list->count_dropped = 0;
+}
+
+void add_to_list_diagnostic(ptr_diagnostic_list list, error_code code, int line, int column){
+    ptr_diagnostic new_diagnostics;
+    ptr_diagnostic diagnostic;
+    int new_size;
+
+    /* A full list only counts the diagnostic. */
+    if (list->max_diagnostics > 0 && list->count_diagnostic >= list->max_diagnostics){
+        (list->count_dropped)++;
+        return;
+    }
+
+    /* Double the array if it is full. */
+    if (list->count_diagnostic == list->size_diagnostics){
+        new_size = (list->size_diagnostics == 0) ? INITIAL_DIAGNOSTIC_LIST_SIZE : list->size_diagnostics * 2;
+        new_diagnostics = (ptr_diagnostic)realloc(list->diagnostics, sizeof(item_diagnostic) * (size_t) new_size);
+        if (new_diagnostics == NULL){
+            fprintf(stderr, "Error in dynamic memory allocation");
+            exit(EXIT_FAILURE);
+        }
+        list->diagnostics = new_diagnostics;
+        list->size_diagnostics = new_size;
+    }
+
+    diagnostic = &list->diagnostics[(list->count_diagnostic)++];
+    diagnostic->code = code;
+    diagnostic->line = line;
+    diagnostic->column = column;
+}
+
+void print_list_diagnostic(ptr_diagnostic_list list, FILE *stream, diagnostics_format format, const char *name_file){
+    char name_source[MAX_FULL_FILE_NAME_LENGTH];
+    int i;
+
+    switch (format) {
+        case FORMAT_TEXT:
+            for (i = 0; i < list->count_diagnostic; i++){
+                print_error(stream, list->diagnostics[i].code, list->diagnostics[i].line);
+            }
+            break;
+        case FORMAT_COLOR:
+            for (i = 0; i < list->count_diagnostic; i++){
+                fprintf(stream, COLOR_RED "Error in line %d" COLOR_RESET " - %s\n", list->diagnostics[i].line,
+                        get_error_message(list->diagnostics[i].code));
+            }
+            break;
+        case FORMAT_JSON:
+        case FORMAT_SARIF:
+            sprintf(name_source, "%.*s.as", MAX_FILE_NAME_LENGTH - 1, name_file);
+            if (format == FORMAT_JSON){
+                print_json_of_list(list, stream, name_source);
+            } else {
+                print_sarif_of_list(list, stream, name_source);
+            }
+            return;
+    }
+    if (list->count_dropped > 0){
+        fprintf(stream, "Too many errors, %d more not shown.\n", list->count_dropped);
+    }
+}
+
+bool is_structured_format(diagnostics_format format){
+    return (format == FORMAT_JSON || format == FORMAT_SARIF) ? TRUE : FALSE;
+}
+
+static void print_json_of_list(ptr_diagnostic_list list, FILE *stream, const char *name_source){
+    ptr_diagnostic diagnostic;
+    int i;
+
+    fputs("{\"file\":", stream);
+    print_json_string(stream, name_source);
+    fprintf(stream, ",\"errors\":%d,\"dropped\":%d,\"diagnostics\":[", list->count_diagnostic + list->count_dropped,
+            list->count_dropped);
+    for (i = 0; i < list->count_diagnostic; i++){
+        diagnostic = &list->diagnostics[i];
+        fprintf(stream, "%s{\"line\":%d,\"column\":%d,\"code\":", (i == 0) ? "" : ",", diagnostic->line,
+                diagnostic->column);
+        print_json_string(stream, get_error_name(diagnostic->code));
+        fputs(",\"message\":", stream);
+        print_json_string(stream, get_error_message(diagnostic->code));
+        fputs("}", stream);
+    }
+    fputs("]}\n", stream);
+}
+
+static void print_sarif_of_list(ptr_diagnostic_list list, FILE *stream, const char *name_source){
+    ptr_diagnostic diagnostic;
+    int i;
+
+    fputs("{\"version\":\"2.1.0\",\"$schema\":\"" SARIF_SCHEMA "\",\"runs\":[{\"tool\":{\"driver\":"
+          "{\"name\":\"assembler\",\"version\":\"" ASSEMBLER_VERSION "\"}},\"results\":[", stream);
+    for (i = 0; i < list->count_diagnostic; i++){
+        diagnostic = &list->diagnostics[i];
+        fprintf(stream, "%s{\"ruleId\":", (i == 0) ? "" : ",");
+        print_json_string(stream, get_error_name(diagnostic->code));
+        fputs(",\"level\":\"error\",\"message\":{\"text\":", stream);
+        print_json_string(stream, get_error_message(diagnostic->code));
+        fputs("},\"locations\":[{\"physicalLocation\":{\"artifactLocation\":{\"uri\":", stream);
+        print_json_string(stream, name_source);
+        fprintf(stream, "},\"region\":{\"startLine\":%d", diagnostic->line);
+        if (diagnostic->column > 0){
+            fprintf(stream, ",\"startColumn\":%d", diagnostic->column);
+        }
+        fputs("}}}]}", stream);
+    }
+    fprintf(stream, "],\"properties\":{\"droppedResults\":%d}}]}\n", list->count_dropped);
+}
+
+static void print_json_string(FILE *stream, const char *text){
+    fputc('"', stream);
+    for (; *text != '\0'; text++){
+        if (*text == '"' || *text == '\\'){
+            fputc('\\', stream);
+            fputc(*text, stream);
+        } else if ((unsigned char) *text < ' '){
+            fprintf(stream, "\\u%04x", (unsigned int) (unsigned char) *text);
+        } else {
+            fputc(*text, stream);
+        }
+    }
+    fputc('"', stream);
+}
+
+void clear_list_diagnostic(ptr_diagnostic_list list){
+    list->count_diagnostic = 0;
+    list->count_dropped = 0;
+}
+
+void free_list_diagnostic(ptr_diagnostic_list list){
+    free(list->diagnostics);
+    init_diagnostic_list(list);
+}
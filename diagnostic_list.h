@@ -0,0 +1,171 @@
+/*
+ * Header: diagnostic_list.h
+ * -------------------------
+ * This is the header file for managing the list of diagnostics (errors) of a file.
+ *
+ * The passes do not print their errors as they find them. Every error is recorded in the list of the file (its code,
+ * its line and its column) and the list is printed once, when the result of the file is printed ('print_end_of_file'),
+ * in the order in which the errors were found. A broken file with many errors is then written to its console stream
+ * in one go, and the messages of the files assembled at the same time never interleave. The list may be capped, so a
+ * file with tens of thousands of errors keeps only the first ones (the others are only counted).
+ *
+ * The list is printed in one of the formats of 'diagnostics_format': the plain text of the assembler (the default),
+ * the same text in ANSI colors, or one line of JSON (or of SARIF) per file, for tools that read the diagnostics.
+ *
+ * Included Files:
+ *   - stdlib.h: Standard Library. It provides functions for memory allocation, conversion, and other utility functions.
+ *   - stdio.h: Standard Input/Output library. It provides functions for input and output operations, such as file handling.
+ *   - string.h: C String Library. It provides functions for manipulating strings, such as string copying and comparison.
+ *   - error_tool.h: Contains the error codes, their names and their messages.
+ *   - setting.h: Contains constant definitions and configurations used throughout the assembly process.
+ */
+
+#ifndef DIAGNOSTIC_LIST_H
+#define DIAGNOSTIC_LIST_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "error_tool.h"
+#include "setting.h"
+
+/*
+ * Enum: diagnostics_format
+ * ------------------------
+ * An enumeration representing the formats in which the diagnostics of a file are printed ('--diagnostics' option).
+ *
+ * Enum Values:
+ *   - FORMAT_TEXT: A line "Error in line <line> - <message>" for every error (the default).
+ *   - FORMAT_COLOR: The same lines, with "Error in line <line>" in red (ANSI escape sequences).
+ *   - FORMAT_JSON: One line holding a JSON object for the file: its name, its number of errors, the diagnostics
+ *                  kept (line, column, code and message of every error) and the number of diagnostics dropped.
+ *   - FORMAT_SARIF: One line holding a SARIF 2.1.0 log for the file, with a result for every diagnostic kept.
+ */
+typedef enum {FORMAT_TEXT, FORMAT_COLOR, FORMAT_JSON, FORMAT_SARIF} diagnostics_format;
+
+/*
+ * Struct: item_diagnostic
+ * -----------------------
+ * A structure representing one diagnostic (error) of a file.
+ *
+ * Fields:
+ *   - code: The code of the error.
+ *   - line: The number of the line of the error (from 1).
+ *   - column: The column of the error (from 1), at the word or the character that caused it, or 0 if the error refers to
+ *             the whole line (such as 'PROGRAM_EXCEEDS_MEMORY').
+ */
+typedef struct diagnostic_struct * ptr_diagnostic;
+typedef struct diagnostic_struct {
+    error_code code;
+    int line;
+    int column;
+} item_diagnostic;
+
+/*
+ * Struct: item_diagnostic_list
+ * ----------------------------
+ * A structure representing the list of diagnostics of a file, in the order in which they were found.
+ *
+ * Fields:
+ *   - diagnostics: A growable array of 'size_diagnostics' diagnostics, of which the first 'count_diagnostic' are used.
+ *   - count_diagnostic: The number of diagnostics kept in the list.
+ *   - size_diagnostics: The number of diagnostics allocated in 'diagnostics'.
+ *   - max_diagnostics: The largest number of diagnostics kept in the list, or 0 to keep them all ('--max-errors').
+ *   - count_dropped: The number of diagnostics that were not kept because the list was full.
+ */
+typedef struct diagnostic_list * ptr_diagnostic_list;
+typedef struct diagnostic_list {
+    ptr_diagnostic diagnostics;
+    int count_diagnostic;
+    int size_diagnostics;
+    int max_diagnostics;
+    int count_dropped;
+} item_diagnostic_list;
+
+/*
+ * Function: init_diagnostic_list
+ * ------------------------------
+ * Initializes an empty list of diagnostics, which keeps all the diagnostics.
+ *
+ * Parameters:
+ *   - list: A pointer to the list to be initialized.
+ *
+ * Notes:
+ *   - No memory is allocated here; the array is allocated when the first diagnostic is added to the list.
+ */
+void init_diagnostic_list(ptr_diagnostic_list list);
+
+/*
+ * Function: add_to_list_diagnostic
+ * --------------------------------
+ * Adds a diagnostic at the end of the list, or counts it as dropped if the list is full.
+ *
+ * Parameters:
+ *   - list: A pointer to the list.
+ *   - code: The code of the error.
+ *   - line: The number of the line of the error.
+ *   - column: The column of the error, or 0 if the error refers to the whole line.
+ *
+ * Notes:
+ *   - The array is doubled (starting from 'INITIAL_DIAGNOSTIC_LIST_SIZE') when it is full.
+ *   - If dynamic memory allocation fails, the function prints an error message to stderr and exits the program.
+ */
+void add_to_list_diagnostic(ptr_diagnostic_list list, error_code code, int line, int column);
+
+/*
+ * Function: print_list_diagnostic
+ * -------------------------------
+ * Prints the diagnostics of the list in a format.
+ *
+ * Parameters:
+ *   - list: A pointer to the list.
+ *   - stream: The stream the diagnostics are printed to (the console messages of the file).
+ *   - format: The format of the diagnostics.
+ *   - name_file: The name of the file (without the '.as' extension), used by the JSON and SARIF formats.
+ *
+ * Notes:
+ *   - In the text formats nothing is printed for a file without errors; if diagnostics were dropped, a last line
+ *     gives their number. In the JSON and SARIF formats a line is printed for every file, with or without errors.
+ */
+void print_list_diagnostic(ptr_diagnostic_list list, FILE *stream, diagnostics_format format, const char *name_file);
+
+/*
+ * Function: is_structured_format
+ * ------------------------------
+ * Checks if a format of the diagnostics is read by another tool (JSON or SARIF).
+ *
+ * Parameters:
+ *   - format: The format of the diagnostics.
+ *
+ * Returns:
+ *   - bool: TRUE for 'FORMAT_JSON' and 'FORMAT_SARIF', FALSE for the text formats.
+ *
+ * Notes:
+ *   - In a structured format the console messages of the files hold only the lines of the diagnostics, so they can be
+ *     parsed: the header, progress and result lines and the statistics of every file are not printed, and the other
+ *     messages of the run (the errors of a missing source, the link and the statistics of the run) are printed to
+ *     the standard error.
+ */
+bool is_structured_format(diagnostics_format format);
+
+/*
+ * Function: clear_list_diagnostic
+ * -------------------------------
+ * Removes every diagnostic of the list, keeping its array (and its cap) for the next file.
+ *
+ * Parameters:
+ *   - list: A pointer to the list to be cleared.
+ */
+void clear_list_diagnostic(ptr_diagnostic_list list);
+
+/*
+ * Function: free_list_diagnostic
+ * ------------------------------
+ * Frees the array of the list and leaves it empty (as after 'init_diagnostic_list').
+ *
+ * Parameters:
+ *   - list: A pointer to the list to be freed.
+ */
+void free_list_diagnostic(ptr_diagnostic_list list);
+
+#endif /* DIAGNOSTIC_LIST_H */
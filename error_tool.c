@@ -26,12 +26,51 @@ const char* error_messages[] = {
         /* INVALID_COMMA_POSITION */ "Invalid comma position.",
         /* LABEL_NOT_FOUND */ "The label does not found.",
         /* NESTED_MACRO_DEFINITION */ "You cannot define a nested macro.",
-        /* MACRO_NAME_IS_INSTRUCTION_OR_DIRECTIVE */ "The macro name is a reserved instruction or directive."
+        /* MACRO_NAME_IS_INSTRUCTION_OR_DIRECTIVE */ "The macro name is a reserved instruction or directive.",
+        /* PROGRAM_EXCEEDS_MEMORY */ "The code and data of the program do not fit in the memory of the machine."
 };
 
-void print_error(error_code code, int line) {
+const char* error_names[] = {
+        "NO_ERROR",
+        "LABEL_ALREADY_EXISTS",
+        "MACRO_ALREADY_EXISTS",
+        "COMMA_REQUIRED_BETWEEN_VALUES",
+        "DATA_NEED_NUM_VALUE",
+        "CANT_DEFINE_LABEL_BEFORE_ENTRY",
+        "CANT_DEFINE_LABEL_BEFORE_EXTERN",
+        "STRING_STRUCTURE_NOT_VALID",
+        "STRING_MUST_END_IN_QUOTES",
+        "STRING_DIRECTIVE_ACCEPTS_ONE_PARAMETER",
+        "TOO_MUCH_WORDS_FOR_INSTRUCTION",
+        "CANT_FIND_LABEL_TO_ENTRY",
+        "INVALID_LABEL_NAME",
+        "INSTRUCTION_NAME_NOT_EXIST",
+        "INSTRUCTION_SHOULD_RECEIVE_TWO_OPERANDS",
+        "COMMA_REQUIRED_BETWEEN_OPERANDS",
+        "INSTRUCTION_SHOULD_RECEIVE_ONE_OPERAND",
+        "INSTRUCTION_SHOULD_NOT_RECEIVE_OPERANDS",
+        "INVALID_ADDRESS_METHOD_FOR_INSTRUCTION",
+        "MUST_PROVIDE_LABELS_TO_EXTERN",
+        "MUST_PROVIDE_LABELS_TO_ENTRY",
+        "MUST_PROVIDE_VALUES_TO_DATA",
+        "INVALID_COMMA_POSITION",
+        "LABEL_NOT_FOUND",
+        "NESTED_MACRO_DEFINITION",
+        "MACRO_NAME_IS_INSTRUCTION_OR_DIRECTIVE",
+        "PROGRAM_EXCEEDS_MEMORY"
+};
+
+const char * get_error_name(error_code code) {
+    return error_names[code];
+}
+
+const char * get_error_message(error_code code) {
+    return error_messages[code];
+}
+
+void print_error(FILE *stream, error_code code, int line) {
     print_red();
-    printf("Error in line %d", line);
+    fprintf(stream, "Error in line %d", line);
     print_reset();
-    printf(" - %s\n", error_messages[code]);
+    fprintf(stream, " - %s\n", error_messages[code]);
 }
\ No newline at end of file
@@ -48,6 +48,7 @@
  *   - LABEL_NOT_FOUND: The label specified in the code was not found in the symbol table.
  *   - NESTED_MACRO_DEFINITION: Nested macro definitions are not allowed; only top-level macros are supported.
  *   - MACRO_NAME_IS_INSTRUCTION_OR_DIRECTIVE: The macro name provided conflicts with a valid instruction or directive name.
+ *   - PROGRAM_EXCEEDS_MEMORY: The code and the data of the file do not fit in the memory of the machine ('MEMORY_SIZE').
  *
  * Notes:
  *   - The error codes are used to identify and report specific issues encountered during the parsing and processing
@@ -82,7 +83,8 @@ typedef enum {
     INVALID_COMMA_POSITION,
     LABEL_NOT_FOUND,
     NESTED_MACRO_DEFINITION,
-    MACRO_NAME_IS_INSTRUCTION_OR_DIRECTIVE
+    MACRO_NAME_IS_INSTRUCTION_OR_DIRECTIVE,
+    PROGRAM_EXCEEDS_MEMORY
 } error_code;
 
 /*
@@ -93,6 +95,7 @@ typedef enum {
  * The function uses the 'error_code' enum to categorize different error types.
  *
  * Parameters:
+ *   - stream: The stream the error message is printed to (the console messages of the file being assembled).
  *   - code: The 'error_code' representing the specific error situation.
  *   - line: The line number in the assembly code where the error occurred.
  *
@@ -101,6 +104,32 @@ typedef enum {
  *   - It takes the error code and line number as input and prints the corresponding error message.
  *   - The function uses ANSI escape sequences to apply red color to the error message for better visibility.
  */
-void print_error(error_code code, int line);
+void print_error(FILE *stream, error_code code, int line);
+
+/*
+ * Function: get_error_name
+ * ------------------------
+ * Returns the name of an error code (for example "LABEL_ALREADY_EXISTS"), used by the machine-readable diagnostics.
+ *
+ * Parameters:
+ *   - code: The 'error_code'.
+ *
+ * Returns:
+ *   - const char*: The name of the code, as it is written in the 'error_code' enum.
+ */
+const char * get_error_name(error_code code);
+
+/*
+ * Function: get_error_message
+ * ---------------------------
+ * Returns the message of an error code.
+ *
+ * Parameters:
+ *   - code: The 'error_code'.
+ *
+ * Returns:
+ *   - const char*: The message printed after the line of the error.
+ */
+const char * get_error_message(error_code code);
 
 #endif /* ERROR_TOOL_H */
\ No newline at end of file
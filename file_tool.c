@@ -1,6 +1,95 @@
 #include "file_tool.h"
 
-ptr_file create_new_file_struct(char *name_file){
+/* Function: init_file_struct
+ * ---------------------------
+ * Allocates a new file struct and initializes its members with default values (no file is opened).
+ *
+ * Parameters:
+ *   - name_file: A pointer to a string containing the name of the file.
+ *   - file_log: The stream that receives the console messages of the file.
+ *
+ * Returns:
+ *   - A pointer to the newly allocated file struct.
+ */
+static ptr_file init_file_struct(char *name_file, FILE *file_log);
+
+/* Function: reuse_spare_file_struct
+ * ---------------------------------
+ * Takes a spare file struct kept by 'release_file' and resets it for a new file, keeping the memory it holds.
+ *
+ * Parameters:
+ *   - name_file: A pointer to a string containing the name of the file.
+ *   - file_log: The stream that receives the console messages of the file.
+ *
+ * Returns:
+ *   - A pointer to the reset file struct, or NULL if there is no spare struct.
+ */
+static ptr_file reuse_spare_file_struct(char *name_file, FILE *file_log);
+
+/* Function: set_defaults_of_file_struct
+ * -------------------------------------
+ * Sets the members of a file struct that do not hold memory to their default values (no file is opened).
+ *
+ * Parameters:
+ *   - file_struct: A pointer to the file struct.
+ *   - name_file: A pointer to a string containing the name of the file.
+ *   - file_log: The stream that receives the console messages of the file.
+ */
+static void set_defaults_of_file_struct(ptr_file file_struct, char *name_file, FILE *file_log);
+
+/* Function: file_holds_text
+ * -------------------------
+ * Checks if a file on the disk already holds exactly the given text.
+ *
+ * Parameters:
+ *   - full_name: The full name of the file.
+ *   - text: The text (at least 'length' characters).
+ *   - length: The number of characters of the text.
+ *
+ * Returns:
+ *   - bool: TRUE if the file is a regular file of 'length' characters that are the characters of the text, FALSE if
+ *     it differs or cannot be read (a missing file included).
+ *
+ * Notes:
+ *   - The size of the file is checked first ('stat'), so a file of another size is not opened. Otherwise the file is
+ *     read in blocks of 'COMPARE_BUFFER_SIZE' characters.
+ */
+static bool file_holds_text(const char *full_name, const char *text, size_t length);
+
+/* The file structs released by 'release_file', kept to be reused by the next files, and the mutex guarding them */
+static ptr_file spare_files[MAX_SPARE_FILE_STRUCTS];
+static int count_spare_files = 0;
+static pthread_mutex_t lock_spare_files = PTHREAD_MUTEX_INITIALIZER;
+
+ptr_file create_new_file_struct(char *name_file, FILE *file_as, FILE *file_log){
+    ptr_file new_file = reuse_spare_file_struct(name_file, file_log);
+
+    /* Allocate a new struct if there is no spare one */
+    if (new_file == NULL){
+        new_file = init_file_struct(name_file, file_log);
+    }
+
+    /* The source was opened by the caller ('open_source_file') */
+    new_file->file_as = file_as;
+
+    /* Return the pointer to the newly created file struct */
+    return new_file;
+}
+
+ptr_file create_new_memory_file_struct(char *name_file, const char *source_text, size_t source_length, FILE *file_log){
+    ptr_file new_file = init_file_struct(name_file, file_log);
+
+    /* The source is only read, so the text of the caller is used as it is */
+    new_file->memory_flag = TRUE;
+    new_file->memory_texts[EXT_INPUT] = (char *) source_text;
+    new_file->memory_lengths[EXT_INPUT] = source_length;
+    new_file->file_as = open_file_of_struct(new_file, EXT_INPUT);
+
+    /* Return the pointer to the newly created file struct */
+    return new_file;
+}
+
+static ptr_file init_file_struct(char *name_file, FILE *file_log){
     /* Dynamically allocate memory for the new file struct */
     ptr_file new_file = (ptr_file)malloc(sizeof(item_file));
     if (new_file == NULL){
@@ -8,53 +97,166 @@ ptr_file create_new_file_struct(char *name_file){
         exit(EXIT_FAILURE);
     }
 
-    /* Copy the provided 'name_file' into the new file struct's 'name_file' member */
-    strcpy(new_file->name_file,name_file);
+    /* Initialize 'data_array' and 'instruction_array' as empty arrays */
+    init_word_array(&new_file->data_array);
+    init_word_array(&new_file->instruction_array);
+
+    /* Initialize the tables, the arena and the buffers as empty (nothing is allocated yet) */
+    init_arena(&new_file->arena);
+    init_macro_table(&new_file->macro_table, &new_file->arena);
+    init_line_index(&new_file->line_index);
+    init_label_table(&new_file->label_table, &new_file->arena);
+    init_buffer(&new_file->extern_list);
+    init_buffer(&new_file->text_as);
+    init_buffer(&new_file->text_am);
+    init_fixup_list(&new_file->fixup_list);
+    init_diagnostic_list(&new_file->diagnostic_list);
 
-    /* Initialize 'line_text' with all zeroes */
-    memset(new_file->line_text, 0, MAX_ASSEMBLY_LINE_LENGTH);
+    set_defaults_of_file_struct(new_file, name_file, file_log);
+
+    /* Return the pointer to the newly allocated file struct */
+    return new_file;
+}
+
+static ptr_file reuse_spare_file_struct(char *name_file, FILE *file_log){
+    ptr_file spare_file = NULL;
+
+    pthread_mutex_lock(&lock_spare_files);
+    if (count_spare_files > 0){
+        spare_file = spare_files[--count_spare_files];
+    }
+    pthread_mutex_unlock(&lock_spare_files);
+    if (spare_file == NULL){
+        return NULL;
+    }
+
+    /* Empty the images, the tables, the arena and the buffers, keeping their memory */
+    clear_word_array(&spare_file->data_array);
+    clear_word_array(&spare_file->instruction_array);
+    clear_list_macro(&spare_file->macro_table);
+    clear_line_index(&spare_file->line_index);
+    clear_list_label(&spare_file->label_table);
+    reset_arena(&spare_file->arena);
+    truncate_buffer(&spare_file->extern_list, 0);
+    truncate_buffer(&spare_file->text_as, 0);
+    truncate_buffer(&spare_file->text_am, 0);
+    clear_list_fixup(&spare_file->fixup_list);
+    clear_list_diagnostic(&spare_file->diagnostic_list);
+
+    set_defaults_of_file_struct(spare_file, name_file, file_log);
+    return spare_file;
+}
+
+static void set_defaults_of_file_struct(ptr_file file_struct, char *name_file, FILE *file_log){
+    int i;
+
+    /* Copy the provided 'name_file' into the file struct's 'name_file' member */
+    strcpy(file_struct->name_file,name_file);
+
+    /* Start with an empty line, the passes write only the characters of every line they read */
+    file_struct->line_text[0] = '\0';
 
     /* Initialize other members with default values */
-    new_file->current_line = 0;
-    new_file->pos_in_line = 0;
-    new_file->count_macro = 0;
-    new_file->count_error = 0;
-    new_file->count_line = 0;
-    new_file->IC = FIRST_CELL_IN_MEMORY;
-    new_file->DC = 0;
-    new_file->error_flag = FALSE;
-    new_file->extern_flag = FALSE;
-    new_file->entry_flag = FALSE;
-
-    /* Initialize 'data_array' and 'instruction_array' with all zeroes */
-    memset(new_file->data_array, 0, sizeof(new_file->data_array));
-    memset(new_file->instruction_array, 0, sizeof(new_file->instruction_array));
+    file_struct->current_line = 0;
+    file_struct->pos_in_line = 0;
+    file_struct->count_macro = 0;
+    file_struct->count_error = 0;
+    file_struct->count_line = 0;
+    file_struct->IC = FIRST_CELL_IN_MEMORY;
+    file_struct->DC = 0;
+    file_struct->error_flag = FALSE;
+    file_struct->extern_flag = FALSE;
+    file_struct->entry_flag = FALSE;
 
     /* Initialize other pointers to NULL */
-    new_file->line_struct = NULL;
-    new_file->head_macro_list = NULL;
-    new_file->head_label_list = NULL;
+    split_line_to_words(&file_struct->line_struct, "");
+    file_struct->curr_macro = NULL;
 
-    /* Open the file with the provided 'name_file' and 'as' extension in read mode */
-    new_file->file_as = open_file(name_file,EXT_INPUT,"r");
+    /* Initialize the per-file state of the passes */
+    file_struct->curr_macro_name[0] = '\0';
+    file_struct->macro_flag = FALSE;
+    file_struct->pos_in_as = 0;
+    file_struct->source = NULL;
+    file_struct->pos_in_am = 0;
+    file_struct->am_flag = FALSE;
+    file_struct->binary_flag = FALSE;
+    file_struct->single_pass_flag = FALSE;
+    file_struct->count_chunks = 1;
+    file_struct->diagnostics_format = FORMAT_TEXT;
+    file_struct->diagnostic_list.max_diagnostics = 0;
+    init_stats(&file_struct->stats);
+    file_struct->file_log = file_log;
 
-    /* Return the pointer to the newly created file struct */
-    return new_file;
+    /* No file is opened yet, and the files are on the disk */
+    file_struct->file_as = NULL;
+    file_struct->memory_flag = FALSE;
+    for (i = 0; i < COUNT_FILE_EXT; i++){
+        file_struct->memory_texts[i] = NULL;
+        file_struct->memory_lengths[i] = 0;
+    }
 }
 
 void free_file(ptr_file file_struct){
+    int i;
+
     if (file_struct){
+        /* Free the texts of the files kept in memory (the source belongs to the caller) */
+        if (file_struct->memory_flag == TRUE){
+            for (i = EXT_INPUT + 1; i < COUNT_FILE_EXT; i++){
+                free(file_struct->memory_texts[i]);
+            }
+        }
+        free_buffer(&file_struct->extern_list); /* Free the buffer of the external references */
+        free_buffer(&file_struct->text_as); /* Free the source and the source after the pre-assembly */
+        free_buffer(&file_struct->text_am);
+        free_list_fixup(&file_struct->fixup_list); /* Free the fixups of the single-pass mode */
+        free_list_diagnostic(&file_struct->diagnostic_list); /* Free the errors of the file */
+        free_word_array(&file_struct->data_array); /* Free the data and code images */
+        free_word_array(&file_struct->instruction_array);
+        free_list_macro(&file_struct->macro_table); /* Free the tables (their nodes belong to the arena) */
+        free_line_index(&file_struct->line_index);
+        free_list_label(&file_struct->label_table);
+        free_arena(&file_struct->arena); /* Release every small allocation of the file at once */
         free(file_struct); /* Free the memory occupied by the file struct */
     }
 }
 
-file_exists_status file_exists(char* name_file) {
+void release_file(ptr_file file_struct){
+    if (file_struct == NULL){
+        return;
+    }
+
+    /* Keep the struct as a spare if there is room for it */
+    if (file_struct->memory_flag == FALSE){
+        pthread_mutex_lock(&lock_spare_files);
+        if (count_spare_files < MAX_SPARE_FILE_STRUCTS){
+            spare_files[count_spare_files++] = file_struct;
+            file_struct = NULL;
+        }
+        pthread_mutex_unlock(&lock_spare_files);
+    }
+    free_file(file_struct);
+}
+
+void free_spare_files(void){
+    pthread_mutex_lock(&lock_spare_files);
+    while (count_spare_files > 0){
+        free_file(spare_files[--count_spare_files]);
+    }
+    pthread_mutex_unlock(&lock_spare_files);
+}
+
+file_exists_status open_source_file(char* name_file, FILE **file_as) {
+    char full_name[MAX_FULL_FILE_NAME_LENGTH];
+
     /* Check if the file name is too long */
+    *file_as = NULL;
     if (valid_file_name(name_file) == FALSE) {
         return TOO_LONG;
     }
-    /* Check if the file exists using the 'access' function */
-    if (access(get_file_with_extension(name_file, EXT_INPUT), F_OK) != -1) {
+    /* Check if the file exists by opening it, the stream is kept for the pre-assembly */
+    *file_as = fopen(get_file_with_extension(name_file, EXT_INPUT, full_name), "r");
+    if (*file_as != NULL) {
         return EXISTS; /* File exists */
     } else {
         return NO_EXISTS; /* File does not exist */
@@ -69,15 +271,8 @@ bool valid_file_name(char *name_file) {
     }
 }
 
-char* get_file_with_extension(char *name_file, file_ext ext){
-    /* Dynamically allocate memory for the full name */
-    char *full_name = (char *) malloc(strlen(name_file) + MAX_FILE_EXTENSION_LENGTH);
-    if (!full_name){
-        fprintf(stderr, "Error in dynamic memory allocation");
-        exit(EXIT_FAILURE);
-    }
-
-    /* Copying the base name to the new buffer */
+char* get_file_with_extension(char *name_file, file_ext ext, char *full_name){
+    /* Copying the base name to the buffer of the caller */
     strcpy(full_name, name_file);
 
     /* Appending the appropriate extension based on the 'ext' value */
@@ -94,28 +289,145 @@ char* get_file_with_extension(char *name_file, file_ext ext){
         case EXT_ENTRY: /* If the file extension is for entry */
             strcat(full_name, ".ent");
             break;
+        case EXT_BINARY: /* If the file extension is for the binary object file */
+            strcat(full_name, ".obj");
+            break;
         default: /* If the file extension is the original */
             strcat(full_name, ".as");
             break;
     }
-    return full_name; /* Return the pointer to the full file name buffer */
+    return full_name; /* Return the pointer to the full file name buffer of the caller */
 }
 
 FILE* open_file(char *name, file_ext ext, char permission[]) {
     FILE *file;
-    char *full_name = get_file_with_extension(name, ext);
+    char full_name[MAX_FULL_FILE_NAME_LENGTH];
+
+    get_file_with_extension(name, ext, full_name);
 
     /* Attempt to open the file using the provided 'permission' mode */
     if ((file = fopen(full_name, permission)) == NULL) {
         fprintf(stderr, "Error opening the file - %s\n", full_name);
-        free(full_name); /* Free the dynamically allocated buffer for the full file name */
         exit(EXIT_FAILURE); /* Exit the program if the file cannot be opened */
     }
 
-    free(full_name); /* Free the dynamically allocated buffer for the full file name */
     return file; /* Return the pointer to the opened file */
 }
 
+FILE* open_file_of_struct(ptr_file file_struct, file_ext ext) {
+    FILE *file;
+
+    /* Files on the disk are opened by the name of the struct */
+    if (file_struct->memory_flag == FALSE) {
+        return open_file(file_struct->name_file, ext, "r");
+    }
+
+    /* Read the text kept for the file (a file that was never written is read as an empty string) */
+    file = fmemopen(file_struct->memory_texts[ext] != NULL ? file_struct->memory_texts[ext] : "",
+                    file_struct->memory_lengths[ext], "r");
+    if (file == NULL) {
+        fprintf(stderr, "Error opening a file in memory - %s\n", file_struct->name_file);
+        exit(EXIT_FAILURE);
+    }
+    return file;
+}
+
+bool write_file(char *name, file_ext ext, const char *text, size_t length){
+    char full_name[MAX_FULL_FILE_NAME_LENGTH];
+    char temp_name[MAX_FULL_FILE_NAME_LENGTH + TEMP_FILE_SUFFIX_LENGTH];
+    int descriptor = -1;
+    bool written;
+    FILE *file;
+    int i;
+
+    get_file_with_extension(name, ext, full_name);
+    if (text == NULL){
+        text = "";
+    }
+
+    /* An output that did not change is not written again */
+    if (file_holds_text(full_name, text, length) == TRUE){
+        return FALSE;
+    }
+
+    /* Create a new temporary file next to the output, skipping the names that are taken by another thread or run */
+    for (i = 0; descriptor == -1 && i < MAX_TEMP_FILE_TRIES; i++){
+        sprintf(temp_name, "%s.%ld-%d.tmp", full_name, (long) getpid(), i);
+        descriptor = open(temp_name, O_WRONLY | O_CREAT | O_EXCL, 0666);
+        if (descriptor == -1 && errno != EEXIST){
+            break;
+        }
+    }
+    file = (descriptor != -1) ? fdopen(descriptor, "wb") : NULL;
+    if (file == NULL){
+        if (descriptor != -1){
+            close(descriptor);
+            unlink(temp_name);
+        }
+        fprintf(stderr, "Error opening the file - %s\n", full_name);
+        exit(EXIT_FAILURE);
+    }
+
+    /* Write the whole text at once and move the temporary file over the output */
+    written = (fwrite(text, 1, length, file) == length) ? TRUE : FALSE;
+    if (fclose(file) != 0){
+        written = FALSE;
+    }
+    if (written == FALSE || rename(temp_name, full_name) != 0){
+        unlink(temp_name);
+        fprintf(stderr, "Error writing the file - %s\n", full_name);
+        exit(EXIT_FAILURE);
+    }
+    return TRUE;
+}
+
+bool write_file_of_struct(ptr_file file_struct, file_ext ext, const char *text, size_t length){
+    /* Files on the disk are written by the name of the struct */
+    if (file_struct->memory_flag == FALSE) {
+        return write_file(file_struct->name_file, ext, text, length);
+    }
+
+    /* Replace the text of a previous write with a copy of the new text */
+    free(file_struct->memory_texts[ext]);
+    file_struct->memory_texts[ext] = (char *) malloc(length + 1);
+    if (file_struct->memory_texts[ext] == NULL){
+        fprintf(stderr, "Error in dynamic memory allocation");
+        exit(EXIT_FAILURE);
+    }
+    if (length > 0){
+        memcpy(file_struct->memory_texts[ext], text, length);
+    }
+    file_struct->memory_texts[ext][length] = '\0';
+    file_struct->memory_lengths[ext] = length;
+    return TRUE;
+}
+
+static bool file_holds_text(const char *full_name, const char *text, size_t length){
+    char block[COMPARE_BUFFER_SIZE];
+    struct stat status;
+    size_t position = 0;
+    size_t count;
+    FILE *file;
+
+    if (stat(full_name, &status) != 0 || !S_ISREG(status.st_mode) || (size_t) status.st_size != length){
+        return FALSE;
+    }
+    if ((file = fopen(full_name, "rb")) == NULL){
+        return FALSE;
+    }
+
+    /* Compare the file with the text block by block, and make sure the file has no more characters */
+    while ((count = fread(block, 1, sizeof(block), file)) > 0){
+        if (position + count > length || memcmp(block, text + position, count) != 0){
+            fclose(file);
+            return FALSE;
+        }
+        position += count;
+    }
+    fclose(file);
+    return (position == length) ? TRUE : FALSE;
+}
+
 __attribute__((unused)) void print_file(ptr_file head){
     /* Print the file name and the line of text in the file */
     printf("Name file: %s\n",head->name_file);
@@ -146,15 +458,15 @@ __attribute__((unused)) void print_file(ptr_file head){
         puts("Error flag = FALSE");
     }
 
-    /* Print the content of the 'line_struct' linked list */
+    /* Print the content of the 'line_struct' */
     puts("Line struct:");
-    print_line(head->line_struct);
+    print_line(&head->line_struct);
 
-    /* Print the content of the 'head_macro_list' linked list */
+    /* Print the content of the 'macro_table' table */
     puts("Macro list:");
-    print_list_macro(head->head_macro_list);
+    print_list_macro(&head->macro_table);
 
-    /* Print the content of the 'head_label_list' linked list */
+    /* Print the content of the 'label_table' table */
     puts("Label list:");
-    print_list_label(head->head_label_list);
+    print_list_label(&head->label_table);
 }
\ No newline at end of file
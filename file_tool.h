@@ -8,9 +8,15 @@
  *   - stdlib.h: Standard Library. It provides functions for memory allocation, conversion, and other utility functions.
  *   - string.h: C String Library. It provides functions for manipulating strings, such as string copying and comparison.
  *   - unistd.h: POSIX Standard Library. It provides various symbolic constants and types and declares various functions that are useful for interacting with the operating system.
- *   - macro_list.h: Contains data structures and functions for managing the linked list of macro definitions in the pre-assembly process.
+ *   - fcntl.h, sys/stat.h, errno.h: POSIX libraries. They provide 'open' and 'stat', used to write an output file to a
+ *     temporary file and to compare it with the file it replaces.
+ *   - pthread.h: POSIX Threads library. It provides the mutex guarding the spare file structs.
+ *   - macro_list.h: Contains data structures and functions for managing the table of macro definitions in the pre-assembly process.
  *   - file_tool.h: Contains utility functions for file handling operations in the pre-assembly process.
  *   - label_list.h: Contains data structures and functions for managing the linked list of label definitions in the pre-assembly process.
+ *   - fixup_list.h: Contains the list of fixups recorded by the first pass in the single-pass mode.
+ *   - stats_tool.h: Contains the statistics of the assembly of a file (the '--stats' option).
+ *   - arena_tool.h: Contains the arena allocator that serves the small allocations of a file.
  *   - text_tool.h: Contains utility functions for handling text and string operations in the pre-assembly process.
  *   - setting.h: Contains constant definitions and configurations used in the pre-assembly process.
  */
@@ -22,9 +28,17 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <errno.h>
+#include <pthread.h>
 #include "macro_list.h"
 #include "file_tool.h"
 #include "label_list.h"
+#include "fixup_list.h"
+#include "diagnostic_list.h"
+#include "stats_tool.h"
+#include "arena_tool.h"
 #include "text_tool.h"
 #include "setting.h"
 
@@ -60,6 +74,7 @@ typedef enum {
  *   - EXT_OBJECT: Represents an object file.
  *   - EXT_EXTERN: Represents an external references file.
  *   - EXT_ENTRY: Represents an entry labels file.
+ *   - EXT_BINARY: Represents a binary object file ('--binary' option).
  *
  * Notes:
  *   - This enumeration is used to categorize and identify different types of files used during the assembly process.
@@ -69,9 +84,13 @@ typedef enum {
     EXT_MACRO,      /* Macro file. */
     EXT_OBJECT,     /* Object file. */
     EXT_EXTERN,     /* External references file. */
-    EXT_ENTRY       /* Entry labels file. */
+    EXT_ENTRY,      /* Entry labels file. */
+    EXT_BINARY      /* Binary object file. */
 } file_ext;
 
+/* Number of values of 'file_ext' */
+#define COUNT_FILE_EXT 6
+
 /*
  * Struct: file_struct
  * -------------------
@@ -79,8 +98,8 @@ typedef enum {
  * It holds information about the file's name, current line of text, counters, flags, data arrays, and file pointers.
  *
  * Fields:
- *   - name_file: A character array to store the name of the file.
  *   - line_text: A character array to store the current line of text from the file.
+ *   - line_struct: The structure of the current line (item_line), reused for every line.
  *   - current_line: An integer representing the current line number in the file.
  *   - pos_in_line: An integer representing the current position within the current line.
  *   - count_macro: An integer representing the number of macros in the file.
@@ -91,25 +110,51 @@ typedef enum {
  *   - error_flag: A boolean flag indicating if an error occurred while processing the file.
  *   - extern_flag: A boolean flag indicating if there are external references in the file.
  *   - entry_flag: A boolean flag indicating if there are entry labels in the file.
- *   - data_array: An array of unsigned integers to store data values.
- *   - instruction_array: An array of unsigned integers to store instruction values.
- *   - line_struct: A pointer to the current line's structure (item_line).
- *   - head_macro_list: A pointer to the head of the macro list (ptr_macro).
- *   - head_label_list: A pointer to the head of the label list (ptr_label).
+ *   - macro_flag: A boolean flag indicating if the pre-assembly is inside a macro definition.
+ *   - curr_macro: A pointer to the macro found for the first word of the current line (pre-assembly).
+ *   - pos_in_as: The read position of the pre-assembly in 'text_as'.
+ *   - pos_in_am: The read position of the passes in 'text_am'.
+ *   - data_array: A growable array of words to store data values (the data image, indexed by 'DC').
+ *   - instruction_array: A growable array of words to store instruction values (the code image, indexed by
+ *                        'IC' - 'FIRST_CELL_IN_MEMORY').
+ *   - macro_table: The table of macros of the file, holding the bodies of the macros (item_macro_table).
+ *   - line_index: For every line of 'text_am', the record of the line split into words if it comes from a macro body,
+ *                 so the passes copy it instead of splitting the line again (item_line_index).
+ *   - label_table: The table of labels (symbol table) of the file (item_label_table).
+ *   - arena: The arena that serves the small allocations of the file (the nodes of the tables), released by 'free_file'.
+ *   - extern_list: A text buffer holding the lines of the external references file (second pass).
+ *   - text_as: A text buffer holding the source, read at once by the pre-assembly from 'file_as'.
+ *   - source: The source the pre-assembly reads: 'text_as', or a buffer set by the caller before the pre-assembly
+ *             (the source the cache already read to build its key), so the file is read only once. NULL otherwise.
+ *   - text_am: A text buffer holding the source after the pre-assembly, read directly by both passes.
+ *   - am_flag: A boolean flag indicating if 'text_am' is also written to the '.am' file (for debugging).
+ *   - binary_flag: A boolean flag indicating if the binary object file ('.obj') is written too.
+ *   - diagnostic_list: The errors found by the passes, printed when the result of the file is printed.
+ *   - diagnostics_format: The format in which the errors are printed ('--diagnostics' option).
+ *   - count_chunks: The largest number of chunks the first pass splits the source into, each one read on its own
+ *                   thread ('--chunks' option, see 'first_pass.h').
  *   - file_as: A file pointer for the assembly file.
- *   - file_am: A file pointer for the machine code (object) file.
- *   - file_ob: A file pointer for the object file.
- *   - file_ent: A file pointer for the entry labels file.
- *   - file_ext: A file pointer for the external references file.
+ *   - file_log: A file pointer for the console messages (progress and errors) of the file.
+ *   - memory_flag: A boolean flag indicating if the files of the struct are kept in memory instead of on the disk.
+ *   - memory_texts: For a struct kept in memory, the text of every file, by its 'file_ext'.
+ *   - memory_lengths: For a struct kept in memory, the number of characters of every file, by its 'file_ext'.
+ *   - curr_macro_name: A character array to store the name of the macro being defined (pre-assembly).
+ *   - name_file: A character array to store the name of the file (up to 'MAX_FILE_NAME_LENGTH' characters).
  *
  * Notes:
  *   - This struct is used to store relevant data and settings related to a specific assembly file.
  *   - It is designed to facilitate the assembly code processing, error detection, and file handling.
+ *   - The fields are ordered by how often they are touched: the state of the current line first, the names last.
+ *     Only the characters of a line are copied into 'line_text' and 'line_struct' (nothing is cleared), so a line
+ *     touches only the bytes it uses.
+ *   - All the state of the passes lives in this struct, so several files can be assembled at the same time,
+ *     each one with its own struct.
  */
 typedef struct file_struct *ptr_file;
 typedef struct file_struct {
-    char name_file[MAX_FILE_NAME_LENGTH];    /* Name of the file. */
+    /* The state touched by every line comes first, so it shares the first cache lines of the struct. */
     char line_text[MAX_ASSEMBLY_LINE_LENGTH];/* Current line of text from the file. */
+    item_line line_struct;  /* Structure of the current line. */
 
     int current_line;       /* Current line number in the file. */
     int pos_in_line;        /* Current position within the current line. */
@@ -122,20 +167,43 @@ typedef struct file_struct {
     bool error_flag;        /* Flag indicating if an error occurred while processing the file. */
     bool extern_flag;       /* Flag indicating if there are external references in the file. */
     bool entry_flag;        /* Flag indicating if there are entry labels in the file. */
+    bool macro_flag;        /* Flag indicating if the pre-assembly is inside a macro definition. */
+    ptr_macro curr_macro;   /* Macro found for the first word of the current line. */
+    size_t pos_in_as;       /* Read position of the pre-assembly in 'text_as'. */
+    size_t pos_in_am;       /* Read position of the passes in 'text_am'. */
+
+    item_word_array data_array;           /* Array to store data values. */
+    item_word_array instruction_array;    /* Array to store instruction values. */
 
-    unsigned int data_array[MAX_ARRAY_SIZE];           /* Array to store data values. */
-    unsigned int instruction_array[MAX_ARRAY_SIZE];    /* Array to store instruction values. */
+    item_macro_table macro_table; /* Table of macros of the file. */
+    item_line_index line_index;   /* Records of the lines of the expanded code that come from macro bodies. */
+    item_label_table label_table; /* Table of labels (symbol table) of the file. */
+    item_arena arena;           /* Arena of the small allocations of the file. */
 
-    ptr_line line_struct;       /* Pointer to the current line's structure. */
-    ptr_macro head_macro_list;  /* Pointer to the head of the macro list. */
-    ptr_label head_label_list;  /* Pointer to the head of the label list. */
+    item_buffer extern_list;    /* Lines of the external references file. */
+    item_buffer text_as;        /* Source file, read at once by the pre-assembly. */
+    ptr_buffer source;          /* Source read by the pre-assembly ('text_as' or a buffer of the caller). */
+    item_buffer text_am;        /* Source after the pre-assembly. */
+    item_fixup_list fixup_list; /* Fixups recorded by the first pass in the single-pass mode. */
+    item_diagnostic_list diagnostic_list;   /* Errors found by the passes. */
+
+    bool am_flag;               /* Flag indicating if the '.am' file is written. */
+    bool binary_flag;           /* Flag indicating if the '.obj' file is written. */
+    bool single_pass_flag;      /* Flag indicating if the labels are resolved from fixups instead of a second pass. */
+    int count_chunks;           /* Largest number of chunks of the first pass. */
+    diagnostics_format diagnostics_format;  /* Format in which the errors are printed. */
+    item_stats stats;           /* Times and counters of the assembly of the file. */
 
     FILE *file_as;      /* File pointer for the assembly file. */
-    FILE *file_am;      /* File pointer for the machine code (object) file. */
-    FILE *file_ob;      /* File pointer for the object file. */
-    FILE *file_ent;     /* File pointer for the entry labels file. */
-    FILE *file_ext;     /* File pointer for the external references file. */
+    FILE *file_log;     /* File pointer for the console messages of the file. */
+
+    bool memory_flag;                         /* Flag indicating if the files are kept in memory. */
+    char *memory_texts[COUNT_FILE_EXT];       /* Text of every file kept in memory. */
+    size_t memory_lengths[COUNT_FILE_EXT];    /* Number of characters of every file kept in memory. */
 
+    /* The names are only read at the start of a file (or of a macro definition) and in the messages. */
+    char curr_macro_name[MAX_ASSEMBLY_LINE_LENGTH]; /* Name of the macro being defined. */
+    char name_file[MAX_FILE_NAME_LENGTH + 1];       /* Name of the file. */
 } item_file;
 
 /* Function: create_new_file_struct
@@ -146,20 +214,49 @@ typedef struct file_struct {
  *
  * Parameters:
  *   - name_file: A pointer to a string containing the name of the file to be associated with the new file struct.
+ *   - file_as: The stream of the source file opened by 'open_source_file', or NULL for a struct whose text is set
+ *              by the caller (a chunk of the first pass, or a source given in 'source').
+ *   - file_log: The stream that receives the console messages (progress and errors) of the file.
+ *
+ * Returns:
+ *   - A pointer to the newly created and initialized file struct.
+ *
+ * Notes:
+ *   - The pre-assembly reads the source from 'file_as' and closes it, so the file is opened only once, unless the
+ *     caller sets 'source' to a source it already read.
+ *   - If a spare file struct was kept by 'release_file', it is reset and reused instead of allocating a new one.
+ *   - If dynamic memory allocation fails, the function prints an error message to stderr and exits the program.
+ */
+ptr_file create_new_file_struct(char *name_file, FILE *file_as, FILE *file_log);
+
+/* Function: create_new_memory_file_struct
+ * ---------------------------------------
+ * Creates and initializes a new file struct whose files are all kept in memory.
+ *
+ * The source of the file is read from 'source_text' instead of the '.as' file, and every file written by the
+ * passes (the '.am', '.ob', '.ent' and '.ext' files) is collected in 'memory_texts' instead of the disk.
+ *
+ * Parameters:
+ *   - name_file: A pointer to a string containing the name of the file, used only in messages.
+ *   - source_text: The text of the source file. It is not copied, so it must stay valid while the struct is used.
+ *   - source_length: The number of characters of 'source_text'.
+ *   - file_log: The stream that receives the console messages (progress and errors) of the file.
  *
  * Returns:
  *   - A pointer to the newly created and initialized file struct.
  *
  * Notes:
  *   - If dynamic memory allocation fails, the function prints an error message to stderr and exits the program.
+ *   - The texts collected are released by 'free_file', unless the caller takes them first (and sets them to NULL).
  */
-ptr_file create_new_file_struct(char *name_file);
+ptr_file create_new_memory_file_struct(char *name_file, const char *source_text, size_t source_length, FILE *file_log);
 
 /* Function: free_file
  * -------------------
  * Frees the memory allocated for a file struct.
  *
- * This function releases the memory occupied by the file struct pointed to by 'file_struct'.
+ * This function releases the memory occupied by the file struct pointed to by 'file_struct', including its buffers,
+ * the texts of the files kept in memory and the source after the pre-assembly.
  * If 'file_struct' is a valid pointer (not NULL), the memory is deallocated and becomes available
  * for reuse. If 'file_struct' is NULL, the function does nothing and returns immediately.
  *
@@ -174,29 +271,54 @@ ptr_file create_new_file_struct(char *name_file);
  */
 void free_file(ptr_file file_struct);
 
+/* Function: release_file
+ * ----------------------
+ * Releases a file struct that is no longer used, keeping it (with its memory) as a spare for the next file.
+ *
+ * A process that assembles many files ('--server' option, or a long list of files) spends a large part of the time
+ * of a small file allocating the struct, its tables, its arena and its buffers. A released struct is kept with all
+ * of them, and 'create_new_file_struct' resets it instead of allocating a new one.
+ *
+ * Parameters:
+ *   - file_struct: A pointer to the file struct (created by 'create_new_file_struct') that is no longer used.
+ *
+ * Notes:
+ *   - At most 'MAX_SPARE_FILE_STRUCTS' structs are kept, the others are freed with 'free_file'. A struct kept in memory
+ *     ('create_new_memory_file_struct') is always freed.
+ *   - The spare structs are guarded by a mutex, so files assembled at the same time may release them.
+ */
+void release_file(ptr_file file_struct);
+
+/* Function: free_spare_files
+ * --------------------------
+ * Frees every spare file struct kept by 'release_file'.
+ */
+void free_spare_files(void);
+
 /*
- * Function: file_exists
- * ---------------------
- * The 'file_exists' function checks if a file with the given name exists in the current directory. It also
- * verifies that the file name is not too long. The function uses the 'access' function to check for file
- * existence and returns the appropriate status.
+ * Function: open_source_file
+ * --------------------------
+ * The 'open_source_file' function opens the source file ('.as') with the given name in the current directory for
+ * reading. It also verifies that the file name is not too long. Opening the file is the check that it exists, so a
+ * file is looked up on the disk only once: the stream opened here is the one the pre-assembly reads.
  *
  * Parameters:
- *   name_file: A pointer to a string representing the name of the file to check for existence.
+ *   name_file: A pointer to a string representing the name of the file (without the '.as' extension).
+ *   file_as: A pointer that receives the stream of the opened file, or NULL if it was not opened.
  *
  * Returns:
  *   file_exists_status: An enumerated type representing the status of the file existence check.
  *
  * Notes:
- *   - The 'file_exists' function calls the 'valid_file_name' function to ensure that the file name is not too long.
+ *   - The 'open_source_file' function calls the 'valid_file_name' function to ensure that the file name is not too long.
  *   - If the file name is too long, the function returns 'TOO_LONG'.
- *   - The 'access' function is used to check if the file exists. It returns -1 if the file does not exist and 0 otherwise.
- *   - If the file exists, the function returns 'EXISTS'.
- *   - If the file does not exist, the function returns 'NO_EXISTS'.
+ *   - If the file is opened, the function returns 'EXISTS'; the stream is given to 'create_new_file_struct', which
+ *     closes it after the source is read.
+ *   - If the file cannot be opened, the function returns 'NO_EXISTS'.
  *   - The 'get_file_with_extension' function is used to construct the full file name with the appropriate extension
- *     before checking for file existence.
+ *     before opening the file.
  */
-file_exists_status file_exists(char *name_file);
+file_exists_status open_source_file(char *name_file, FILE **file_as);
 
 /* Function: valid_file_name
  * ----------------------
@@ -220,28 +342,28 @@ bool valid_file_name(char *name_file);
  * Adds a file extension to the provided file name.
  *
  * This function appends a file extension to the given 'name_file' based on the 'ext' value.
- * The resulting full file name, including the extension, is stored in a new dynamically allocated
- * buffer, and a pointer to this buffer is returned.
+ * The resulting full file name, including the extension, is stored in the 'full_name' buffer of the caller,
+ * and a pointer to this buffer is returned.
  *
  * Parameters:
- *   - name_file: A pointer to a string containing the base name of the file.
+ *   - name_file: A pointer to a string containing the base name of the file (at most 'MAX_FILE_NAME_LENGTH' characters).
  *   - ext: An enum 'file_ext' specifying the type of file extension to be added.
+ *   - full_name: A buffer of at least 'MAX_FULL_FILE_NAME_LENGTH' characters that receives the full file name.
  *
  * Returns:
- *   - char*: A dynamically allocated pointer to a string containing the full file name with the extension.
- *            The caller is responsible for freeing the memory allocated by this function when it is no
- *            longer needed.
+ *   - char*: A pointer to the 'full_name' buffer, containing the full file name with the extension.
  *
  * Notes:
- *   - If memory allocation fails, an error message is printed to the standard error stream, and the program exits.
+ *   - No memory is allocated, the caller usually keeps the buffer on the stack.
  *   - The 'file_ext' enum values determine the type of extension to be added to the file name:
  *     - EXT_MACRO: Appends ".am" (e.g., "example.am") for pre-assembler output.
  *     - EXT_OBJECT: Appends ".ob" (e.g., "example.ob") for the result after the pass operation.
  *     - EXT_EXTERN: Appends ".ext" (e.g., "example.ext") for external symbols.
  *     - EXT_ENTRY: Appends ".ent" (e.g., "example.ent") for entry symbols.
+ *     - EXT_BINARY: Appends ".obj" (e.g., "example.obj") for the binary object file.
  *     - Default: Appends ".as" (e.g., "example.as") for the original file extension.
  */
-char *get_file_with_extension(char *name_file, file_ext ext);
+char *get_file_with_extension(char *name_file, file_ext ext, char *full_name);
 
 /* Function: open_file
  * ----------------------
@@ -266,6 +388,68 @@ char *get_file_with_extension(char *name_file, file_ext ext);
  */
 FILE *open_file(char *name, file_ext ext, char permission[]);
 
+/* Function: open_file_of_struct
+ * -----------------------------
+ * Opens one of the files of a file struct for reading, on the disk or in memory.
+ *
+ * Parameters:
+ *   - file_struct: A pointer to the file struct.
+ *   - ext: An enum 'file_ext' specifying which file of the struct is opened.
+ *
+ * Returns:
+ *   - FILE*: A pointer to the opened stream.
+ *
+ * Notes:
+ *   - If the struct is not kept in memory, the function calls 'open_file' with the name of the struct.
+ *   - Otherwise, the file is a stream over 'memory_texts[ext]' ('fmemopen').
+ *   - The output files are not written through a stream, but at once with 'write_file_of_struct'.
+ *   - If the stream cannot be opened, an error message is printed to the standard error stream, and the program exits.
+ */
+FILE *open_file_of_struct(ptr_file file_struct, file_ext ext);
+
+/* Function: write_file
+ * --------------------
+ * Writes the whole text of an output file at once, so a reader never sees a half-written file.
+ *
+ * Parameters:
+ *   - name: A pointer to a string containing the base name of the file.
+ *   - ext: An enum 'file_ext' specifying the type of file extension to be added.
+ *   - text: The text of the file (NULL for an empty text).
+ *   - length: The number of characters of the text.
+ *
+ * Returns:
+ *   - bool: TRUE if the file was written, FALSE if it already held exactly the text (it is then not touched).
+ *
+ * Notes:
+ *   - The text is compared with the file it replaces first (its size and then its characters), so an output that did
+ *     not change costs no create, write or rename.
+ *   - Otherwise the text is written to a new temporary file next to the output (its name followed by the process id,
+ *     a number and ".tmp", created with 'O_EXCL' so every thread and run gets its own), which is then renamed over the
+ *     output. The output is therefore replaced at once, and a failed write leaves the old file as it was.
+ *   - If the file cannot be written, the temporary file is removed, an error message is printed to the standard error
+ *     stream, and the program exits (as 'open_file').
+ */
+bool write_file(char *name, file_ext ext, const char *text, size_t length);
+
+/* Function: write_file_of_struct
+ * ------------------------------
+ * Writes the whole text of one of the output files of a file struct, on the disk or in memory.
+ *
+ * Parameters:
+ *   - file_struct: A pointer to the file struct.
+ *   - ext: An enum 'file_ext' specifying which file of the struct is written.
+ *   - text: The text of the file (NULL for an empty text).
+ *   - length: The number of characters of the text.
+ *
+ * Returns:
+ *   - bool: TRUE if the file was written, FALSE if the file on the disk already held exactly the text.
+ *
+ * Notes:
+ *   - If the struct is not kept in memory, the function calls 'write_file' with the name of the struct.
+ *   - Otherwise, a copy of the text (null-terminated) replaces 'memory_texts[ext]'.
+ */
+bool write_file_of_struct(ptr_file file_struct, file_ext ext, const char *text, size_t length);
+
 /* Function: print_file
  * ----------------------
  * (For Debugging) Prints the contents of a file structure and associated lists.
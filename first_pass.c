@@ -1,12 +1,4 @@
 #include "first_pass.h"
-/*
- * Static variable: sfile
- * ----------------------
- * A pointer to the 'file' struct representing the current assembly source file being processed in
- * the first pass stage.
- */
-static ptr_file sfile;
-
 /*
  * Function: first_pass_on_curr_file
  * ---------------------------------
@@ -26,36 +18,115 @@ static ptr_file sfile;
  *   - After processing all lines, updates the addresses of labels used in data directives (if no errors occurred).
  *
  * Notes:
- *   - The global 'sfile' variable contains information about the source file, such as the file streams, line structures,
+ *   - The 'sfile' parameter contains information about the source file, such as the file streams, line structures,
  *     the symbol table, and various counters used during the first pass.
  *   - The function updates the 'error_flag' of the 'sfile' variable if any errors occur during the first pass.
  *     The 'error_flag' indicates whether the first pass was successful without any errors.
  */
-static void first_pass_on_curr_file();
+static void first_pass_on_curr_file(ptr_file sfile);
+
+/*
+ * Function: first_pass_on_lines
+ * -----------------------------
+ * Performs the first pass on the lines of the expanded code from the read position ('pos_in_am') up to a position.
+ *
+ * Parameters:
+ *   end_in_am (size_t): The position in 'text_am' where the pass stops (the end of the text, or the end of a chunk).
+ *
+ * Notes:
+ *   - 'count_line' must hold the number of lines before the read position, so the errors show the lines of the file.
+ */
+static void first_pass_on_lines(ptr_file sfile, size_t end_in_am);
+
+/*
+ * Function: first_pass_on_chunks
+ * ------------------------------
+ * Performs the first pass on the chunks of the expanded code at the same time and merges them (see 'item_chunk').
+ *
+ * Returns:
+ *   bool: TRUE if the chunks were read and merged, FALSE if the file must be read by a single thread (it is too
+ *         short to be split, it has errors or its chunks cannot be merged). The state of the first pass is then the
+ *         same as before the call.
+ */
+static bool first_pass_on_chunks(ptr_file sfile);
+
+/*
+ * Function: split_to_chunks
+ * -------------------------
+ * Splits the expanded code at line boundaries into chunks of about the same number of lines.
+ *
+ * Parameters:
+ *   chunks (ptr_chunk): An array of 'count_chunks' chunks that receives the chunks.
+ *
+ * Returns:
+ *   int: The number of chunks, at most 'count_chunks' of the file, with at least 'MIN_CHUNK_LINES' lines in every chunk
+ *        (zero or one if the file is too short to be split).
+ *
+ * Notes:
+ *   - The lines are found with 'get_line_view_of_buffer', so they are split exactly as the pass reads them.
+ */
+static int split_to_chunks(ptr_file sfile, ptr_chunk chunks);
+
+/*
+ * Function: run_chunk_task
+ * ------------------------
+ * Reads one chunk into a file struct of its own (a task of the pool).
+ *
+ * Parameters:
+ *   index (int): The number of the chunk.
+ *   chunks (void*): The array of the chunks (item_chunk).
+ */
+static void run_chunk_task(int index, void *chunks);
+
+/*
+ * Function: merge_chunk
+ * ---------------------
+ * Adds the labels, the words and the fixups of a chunk to the file, after those of the chunks before it.
+ *
+ * Parameters:
+ *   chunk (ptr_chunk): A pointer to the chunk, after it was read.
+ *
+ * Returns:
+ *   bool: TRUE if the chunk was merged, FALSE if it has errors, if one of its labels is already defined by a chunk
+ *         before it or if the code and the data merged so far do not fit in the memory.
+ *
+ * Notes:
+ *   - The addresses of the code labels and of the operand fixups are moved by the code words of the chunks before it,
+ *     and the addresses of the data labels by their data words. The external labels keep their address (zero).
+ */
+static bool merge_chunk(ptr_file sfile, ptr_chunk chunk);
+
+/*
+ * Function: reset_first_pass
+ * --------------------------
+ * Drops the labels, the words and the fixups merged from the chunks, so the file can be read again from its beginning.
+ *
+ * Notes:
+ *   - The label nodes merged so far stay in the arena of the file until it is released.
+ */
+static void reset_first_pass(ptr_file sfile);
 
 /*
  * Function: update_files
  * ----------------------
- * Updates the file streams for the pre-assembly process.
+ * Updates the file streams for the first pass.
  *
- * This function is responsible for updating the file streams used during the pre-assembly process.
- * It first closes the currently opened file streams, then opens the intermediate file ('file_am')
- * for reading and assigns the file stream to it.
+ * This function is responsible for updating the file streams used during the first pass.
+ * It moves the read position of the expanded code ('pos_in_am') to its beginning (the assembly source file
+ * was already read and closed by the pre-assembly).
  *
  * Notes:
- *   - The function uses the 'fclose' function to close the currently opened file streams for the
- *     assembly source file ('file_as') and the intermediate file ('file_am').
- *   - After closing the file streams, the function opens the intermediate file in read mode ('r')
- *     using the 'open_file' utility function and assigns the new file stream to 'file_am'.
+ *   - The expanded code is read directly from the 'text_am' buffer filled by the pre-assembly, so the
+ *     intermediate file is neither closed nor reopened.
  */
-static void update_files();
+static void update_files(ptr_file sfile);
 
 /*
  * Function: update_next_line
  * --------------------------
  * Updates the 'line_text' buffer with the next line from the intermediate file and returns it.
  *
- * This function is responsible for reading the next line from the intermediate file ('file_am')
+ * This function is responsible for reading the next line from the expanded code ('text_am')
  * and updating the 'line_text' buffer with its content. The 'line_text' buffer is used to store
  * the current line being processed during the pre-assembly process.
  *
@@ -63,26 +134,28 @@ static void update_files();
  *   char *: A pointer to the 'line_text' buffer containing the next line from the intermediate file.
  *
  * Notes:
- *   - The function uses the 'memset' function to clear the 'line_text' buffer before reading the next line.
- *   - It then uses the 'fgets' function to read the next line from the intermediate file and stores it in 'line_text'.
+ *   - It uses the 'read_line_of_buffer' function (which splits lines exactly like 'fgets') to read the next line
+ *     from the expanded code and stores it in 'line_text'. The line is copied at once and null-terminated, so the
+ *     buffer is not cleared before the read.
  */
-static char * update_next_line();
+static char * update_next_line(ptr_file sfile);
 
 /*
  * Function: update_line_to_array
  * ------------------------------
- * Updates the 'line_struct' pointer with a new line structure created from the 'line_text' buffer.
+ * Updates the 'line_struct' of the file with the words of the 'line_text' buffer.
  *
  * This function is responsible for creating a new line structure using the content of the 'line_text' buffer.
  * The 'line_text' buffer contains the current line being processed during the pre-assembly process.
  * The line structure is used to parse the line into separate words and store relevant information for further processing.
  *
  * Notes:
- *   - The function uses the 'create_new_line_struct' function from 'text_tool.h' to create a new line structure.
- *   - The new line structure is then assigned to the 'line_struct' pointer in the global 'sfile' variable,
- *     updating it with the parsed information from the 'line_text' buffer.
+ *   - The function uses the 'split_line_to_words' function from 'text_tool.h' to split the line into words. A line
+ *     copied from the body of a macro has a record in the line index of the file, split when the macro was defined,
+ *     and the record is copied instead ('copy_line_struct').
+ *   - The 'line_struct' of the 'sfile' struct is reused for every line, so no memory is allocated for the line.
  */
-static void update_line_to_array();
+static void update_line_to_array(ptr_file sfile);
 
 /*
  * Function: actions_on_label
@@ -96,7 +169,7 @@ static void update_line_to_array();
  * Notes:
  *   - The function first checks if the current line contains a label using the 'is_label' function from 'text_tool.h'.
  *   - If a label is found in the line, the function determines the type of label (instruction, directive, entry, or extern)
- *     using the 'get_word_status' function from 'text_tool.h'.
+ *     using the 'get_directive_status' function from 'text_tool.h'.
  *   - Based on the label type, the function takes appropriate actions:
  *       - If the label is of type STATUS_ENTRY or STATUS_EXTERN, it indicates an error because these labels should not be defined
  *         before the corresponding entry or extern directives. The function reports the error using the 'add_error' function from 'error_tool.h'.
@@ -104,7 +177,7 @@ static void update_line_to_array();
  *       - The label is then deleted from the line structure using the 'delete_label_from_line_struct' function from 'text_tool.h'
  *         to facilitate further processing of the line without the label keyword.
  */
-static void actions_on_label();
+static void actions_on_label(ptr_file sfile);
 
 /*
  * Function: add_new_label_to_list
@@ -127,32 +200,7 @@ static void actions_on_label();
  *       - If the label is of type STATUS_CODE, it adds the label with the current 'IC' value as the address and the 'CODE' type.
  *   - If the label name is invalid, the function reports an error of type INVALID_LABEL_NAME using the 'add_error' function from 'error_tool.h'.
  */
-static void add_new_label_to_list(line_status temp_status);
-
-/*
- * Function: get_word_status
- * -------------------------
- * Determines the status of a given word based on predefined keywords during the first pass.
- *
- * This function determines the status of a given word based on predefined keywords during the first pass of the assembly process.
- * It compares the input 'word_text' with predefined directives and instructions to identify the type of the word. The function returns
- * the corresponding 'line_status' enumeration value representing the status of the word.
- *
- * Parameters:
- *   word_text (char*): The text of the word to be evaluated for its status.
- *
- * Returns:
- *   line_status: The status of the word, represented by one of the 'line_status' enumeration values:
- *                - STATUS_DATA: Indicates that the word is a ".data" directive.
- *                - STATUS_STRING: Indicates that the word is a ".string" directive.
- *                - STATUS_EXTERN: Indicates that the word is a ".extern" directive.
- *                - STATUS_ENTRY: Indicates that the word is an ".entry" directive.
- *                - STATUS_CODE: Indicates that the word is an instruction or label (code status).
- *
- * Notes:
- *   - The function compares the 'word_text' with predefined directives and instructions to determine its status.
- */
-static line_status get_word_status(char *word_text);
+static void add_new_label_to_list(ptr_file sfile, line_status temp_status);
 
 /*
  * Function: action_by_status
@@ -160,11 +208,11 @@ static line_status get_word_status(char *word_text);
  * Performs appropriate actions based on the given line status during the first pass.
  *
  * This function performs the appropriate actions based on the given 'status' during the first pass of the assembly process.
- * The 'status' parameter represents the status of the current line, which is determined using the 'get_word_status' function.
+ * The 'status' parameter represents the status of the current line, which is determined using the 'get_directive_status' function.
  * Depending on the line status, this function takes different actions to process the line appropriately during the first pass.
  *
  * Parameters:
- *   status (line_status): The status of the current line, as determined by the 'get_word_status' function.
+ *   status (line_status): The status of the current line, as determined by the 'get_directive_status' function.
  *
  * Notes:
  *   - The function uses a switch-case statement to handle different line statuses.
@@ -175,7 +223,7 @@ static line_status get_word_status(char *word_text);
  *     - For STATUS_ENTRY, it returns without taking any action, as the ".entry" directive is handled separately during the second pass.
  *     - For STATUS_CODE, it calls the 'add_instructions' function to handle instructions and labels in the code section.
  */
-static void action_by_status(line_status status);
+static void action_by_status(ptr_file sfile, line_status status);
 
 /*
  * Function: add_error
@@ -183,13 +231,15 @@ static void action_by_status(line_status status);
  * Add an error to the first pass process and update the error status of the current file.
  *
  * This function is responsible for adding an error with the specified 'error_code' to the first pass process.
- * It calls the 'print_error' function to display the error message associated with the 'error_code' and the current line number.
+ * It records the error with the current line number in the list of diagnostics of the file ('add_to_list_diagnostic'), which is
+ * printed once with the result of the file.
  * Additionally, it sets the 'error_flag' of the current file ('sfile') to TRUE to indicate that an error has occurred in the assembly process.
  *
  * Parameters:
  *   error_code (error_code): The error code indicating the type of error encountered during the pre-assembly process.
+ *   column (int): The column of the error in the line, from 1 (0 if the error refers to the whole line).
  */
-static void add_error(error_code error_code);
+static void add_error(ptr_file sfile, error_code error_code, int column);
 
 /*
  * Function: update_error_status
@@ -202,13 +252,14 @@ static void add_error(error_code error_code);
  *
  * Parameters:
  *   error_code (error_code): The error code indicating the type of error encountered during the first pass process.
+ *   column (int): The column of the error in the line, from 1 (0 if the error refers to the whole line).
  *
  * Notes:
  *   - This function is used to manage error status during the first pass process.
  *   - It is typically called when an operation returns an error code.
  *   - If the 'error_code' is not equal to 'NO_ERROR', the 'add_error' function is called to handle the error.
  */
-static void update_error_status(error_code error_code);
+static void update_error_status(ptr_file sfile, error_code error_code, int column);
 
 /*
  * Function: save_data
@@ -224,7 +275,7 @@ static void update_error_status(error_code error_code);
  *   - The function handles error conditions, such as missing values after the ".data" directive and invalid comma positions.
  *   - If a word in the line is not a valid number, an error is added to the file's error list.
  */
-static void save_data();
+static void save_data(ptr_file sfile);
 
 /*
  * Function: save_string
@@ -241,7 +292,7 @@ static void save_data();
  *   - The function handles various error conditions, such as missing quotes, invalid string structure, and extra parameters.
  *   - If the string does not start or end in quotes or contains an invalid structure, an appropriate error is added to the file's error list.
  */
-static void save_string();
+static void save_string(ptr_file sfile);
 
 /*
  * Function: add_extern_labels
@@ -258,7 +309,7 @@ static void save_string();
  *   - The function handles various error conditions, such as missing labels, invalid label names, and invalid comma positions.
  *   - If a label name is not valid or the comma is not correctly placed, an appropriate error is added to the file's error list.
  */
-static void add_extern_labels();
+static void add_extern_labels(ptr_file sfile);
 
 /*
  * Function: add_instructions
@@ -273,33 +324,12 @@ static void add_extern_labels();
  *
  * Notes:
  *   - The 'get_instruction_type' function is used to determine the type of instruction based on the first word of the line.
- *   - The 'update_addressing_method_type' function updates the addressing method type for the current instruction.
+ *   - The 'update_operands_of_line' function updates the addressing method type for the current instruction.
  *   - The 'check_errors_for_instructions' function checks for errors related to the instruction, such as invalid operands or missing labels.
  *   - If any errors are encountered during processing, the 'error_flag' of the 'sfile' is set to TRUE, indicating the presence of errors.
  *   - If no errors are found, the binary representation of the instruction and its operands are added to the machine code array.
  */
-static void add_instructions();
-
-/*
- * Function: update_addressing_method_type
- * ---------------------------------------
- * Update the addressing method types for the operands of the given instruction.
- *
- * This function updates the addressing method types for the source and destination operands of the given instruction,
- * based on the instruction type. It also handles special cases where the instruction has a single operand.
- * The updated addressing method types are stored in the 'line_struct' of the current file struct.
- *
- * Parameters:
- *   type (instruction_type): The type of the instruction, obtained from the first word of the line.
- *
- * Notes:
- *   - The 'get_addressing_method_type' function is used to determine the addressing method type of an operand based on its text.
- *   - Depending on the instruction type, the function updates the 'source' and 'destination' fields of the 'line_struct'.
- *   - In special cases where the instruction has a single operand, the 'source' field is set to NOT_EXIST, and the 'destination'
- *     field is set to the addressing method type of the operand (word2).
- *   - The 'word4' of the 'line_struct' is updated with the content of 'word2' in cases where the instruction has a single operand.
- */
-static void update_addressing_method_type(instruction_type type);
+static void add_instructions(ptr_file sfile);
 
 /*
  * Function: check_errors_for_instructions
@@ -315,11 +345,11 @@ static void update_addressing_method_type(instruction_type type);
  *
  * Notes:
  *   - The 'count' field in the 'line_struct' represents the number of words in the instruction line.
- *   - The function uses the 'instruction_type' to handle specific checks for each instruction type.
- *   - The 'get_addressing_method_type' function is used to obtain the addressing method type of operands.
- *   - Depending on the instruction type, the function checks for valid operand counts and correct comma usage.
+ *   - The number of operands of the instruction and the addressing methods its operands accept are looked up in the
+ *     table of the instructions ('get_instruction_spec' and 'is_valid_addressing' of 'word_tool.h').
+ *   - Depending on the number of operands, the function checks for valid operand counts and correct comma usage.
  */
-static void check_errors_for_instructions(instruction_type type);
+static void check_errors_for_instructions(ptr_file sfile, instruction_type type);
 
 /*
  * Function: add_first_word_of_instruction_to_array
@@ -340,9 +370,9 @@ static void check_errors_for_instructions(instruction_type type);
  *   - The 'encoding_type' field is set to 'ABSOLUTE' as all instructions are absolute in the first pass.
  *   - The 'destination_address' and 'source_address' fields are obtained from the 'line_struct'.
  *   - The 'opcode' field is set based on the 'type' of the instruction.
- *   - The 'memcpy' function is used to copy the bit-field structure to the 'instruction_array'.
+ *   - The word is built with 'ENCODE_FIRST_WORD' (see 'word_tool.h' for the layout).
  */
-static void add_first_word_of_instruction_to_array(instruction_type type);
+static void add_first_word_of_instruction_to_array(ptr_file sfile, instruction_type type);
 
 /*
  * Function: add_the_rest_of_the_instruction_to_array
@@ -357,13 +387,13 @@ static void add_first_word_of_instruction_to_array(instruction_type type);
  *     'IC' (Instruction Counter), 'instruction_array', and the 'data_array'.
  *   - The 'instruction_array' is an array that stores the binary representation of the instructions.
  *   - The 'IC' represents the index in the 'instruction_array' where the next word of the instruction should be added.
- *   - The function uses bit-field structures to construct the different word formats of the instruction.
+ *   - The words are built with the 'ENCODE_*' macros of 'word_tool.h', which hold the layouts of the words.
  *   - The 'ABSOLUTE' encoding type is used for all instructions in the first pass.
  *   - The function converts numeric values from the instruction line to integers using 'atoi'.
  *   - Depending on the addressing method of the source and destination operands, the appropriate fields of the
  *     word(s) of the instruction are constructed and added to the 'instruction_array'.
  */
-static void add_the_rest_of_the_instruction_to_array();
+static void add_the_rest_of_the_instruction_to_array(ptr_file sfile);
 
 /*
  * Function: get_next_word_without_comma
@@ -372,17 +402,20 @@ static void add_the_rest_of_the_instruction_to_array();
  *
  * This function extracts the next word from the current line text, starting from the current position
  * indicated by 'pos_in_line'. It reads characters until it encounters a space, tab, newline, comma, or
- * the end of the line. The function stores the extracted word in the 'temp_word' buffer and increments
- * the 'pos_in_line' index accordingly.
+ * the end of the line. The function stores the extracted word in the 'word_text' buffer supplied by the
+ * caller and increments the 'pos_in_line' index accordingly.
+ *
+ * Parameters:
+ *   word_text (char*): A buffer of at least 'MAX_ASSEMBLY_LINE_LENGTH' characters that receives the extracted word.
  *
  * Returns:
- *   char*: A pointer to the 'temp_word' buffer containing the extracted word.
+ *   char*: A pointer to the 'word_text' buffer containing the extracted word.
  *
  * Notes:
  *   - After extracting the word, the function skips any white characters to move to the next word or
  *     the end of the line.
  */
-static char * get_next_word_without_comma();
+static char * get_next_word_without_comma(ptr_file sfile, char *word_text);
 
 /*
  * Function: check_for_comma
@@ -397,7 +430,7 @@ static char * get_next_word_without_comma();
  * Returns:
  *   bool: TRUE if a comma is found at the current position; FALSE otherwise.
  */
-static bool check_for_comma();
+static bool check_for_comma(ptr_file sfile);
 
 /*
  * Function: update_address_label_of_data
@@ -405,28 +438,102 @@ static bool check_for_comma();
  * Update the addresses of data labels.
  *
  * This function updates the addresses of data labels in the linked list of labels represented by
- * 'head_label_list'. The update is performed based on the 'IC' (Instruction Counter) value of the current
+ * 'label_table'. The update is performed based on the 'IC' (Instruction Counter) value of the current
  * source file 'sfile'. The 'IC' represents the current address of the first instruction in the instruction
  * array. The function traverses the linked list of labels and updates the address of data labels found in
  * the data array (starting from the 'IC' value).
  */
-static void update_address_label_of_data();
+static void update_address_label_of_data(ptr_file sfile);
+
+/*
+ * Function: add_operand_fixups
+ * ----------------------------
+ * Records a fixup for every operand of the current instruction with the direct addressing method (single-pass mode).
+ *
+ * The words of these operands can only be completed when every label of the file is known. The fixup keeps the address
+ * of the word of the operand, the number of the current line and the name of the label, so the words are completed at
+ * the end of the file ('start_second_pass') without reading the source again.
+ *
+ * Notes:
+ *   - The function must be called after 'update_operands_of_line'. The source operand word follows the first word
+ *     of the instruction, and the destination operand word follows the source operand word (if there is one).
+ *   - The fixups are recorded even if the file has errors, so a missing label is reported as in the second pass.
+ */
+static void add_operand_fixups(ptr_file sfile);
+
+/*
+ * Function: add_entry_fixup
+ * -------------------------
+ * Records a fixup with the text of the current '.entry' line (single-pass mode).
+ *
+ * Notes:
+ *   - The labels of the line are marked as entry points (and the errors of the line are reported) when every label of
+ *     the file is known, as they are in the second pass.
+ */
+static void add_entry_fixup(ptr_file sfile);
+
+/*
+ * Function: get_code_word
+ * -----------------------
+ * Returns a pointer to the word of the code image at the current 'IC', growing the image if needed.
+ *
+ * Notes:
+ *   - The code image is indexed from 'FIRST_CELL_IN_MEMORY', so its first word is at index zero.
+ *   - If the new word does not fit in the memory of the machine ('MEMORY_SIZE' cells for the code and the data together),
+ *     the 'PROGRAM_EXCEEDS_MEMORY' error is reported once, on the line of the first word that does not fit. The word is
+ *     still stored, so the rest of the file is checked as usual.
+ */
+static unsigned int * get_code_word(ptr_file sfile);
+
+/*
+ * Function: get_data_word
+ * -----------------------
+ * Returns a pointer to the word of the data image at the current 'DC', growing the image if needed.
+ *
+ * Notes:
+ *   - The memory of the machine is checked the same way as in 'get_code_word'.
+ */
+static unsigned int * get_data_word(ptr_file sfile);
+
+/*
+ * Function: check_memory_size
+ * ---------------------------
+ * Reports the 'PROGRAM_EXCEEDS_MEMORY' error if the word that is about to be stored is the first one that does not fit in
+ * the memory of the machine.
+ *
+ * Notes:
+ *   - 'IC' (which starts at 'FIRST_CELL_IN_MEMORY') plus 'DC' is the number of memory cells used so far. Both counters only
+ *     grow by one word at a time, so the number reaches 'MEMORY_SIZE' exactly once and the error is reported only once.
+ */
+static void check_memory_size(ptr_file sfile);
 
 void start_first_pass(ptr_file original_file_struct){
-    /* Set the global 'sfile' variable to the provided 'original_file_struct'. */
-    sfile = original_file_struct;
+    double start = get_time_now();
 
     /* Initiate the first pass of the assembly process for the current file. */
-    first_pass_on_curr_file();
+    first_pass_on_curr_file(original_file_struct);
+    add_time_of_phase(&original_file_struct->stats, PHASE_FIRST_PASS, start);
 }
 
-static void first_pass_on_curr_file(){
+static void first_pass_on_curr_file(ptr_file sfile){
     /* Open the intermediate files for writing. */
-    update_files();
+    update_files(sfile);
     sfile->count_line = 0;
 
-    /* Process each line in the current file. */
-    while(update_next_line() != NULL){
+    /* Process each line in the current file, in chunks at the same time if the file is split. */
+    if (first_pass_on_chunks(sfile) == FALSE){
+        first_pass_on_lines(sfile, sfile->text_am.length);
+    }
+
+    /* If no errors occurred during the first pass, update the addresses of labels used in data directives. */
+    if (sfile->error_flag == FALSE){
+        update_address_label_of_data(sfile);
+    }
+}
+
+static void first_pass_on_lines(ptr_file sfile, size_t end_in_am){
+    /* Process each line up to the end position. */
+    while(sfile->pos_in_am < end_in_am && update_next_line(sfile) != NULL){
         /* Increment the count of processed lines. */
         (sfile->count_line)++;
 
@@ -439,137 +546,278 @@ static void first_pass_on_curr_file(){
         sfile->pos_in_line = 0;
 
         /* Update the line data structure to store information about the current line. */
-        update_line_to_array();
+        update_line_to_array(sfile);
 
         /* Process any labels found in the line. */
-        actions_on_label();
-        if (sfile->line_struct->count == 0){
+        actions_on_label(sfile);
+        if (sfile->line_struct.count == 0){
             continue;
         }
 
         /* Determine the type of line (instruction, directive, etc.) and process it accordingly. */
-        action_by_status(get_word_status(sfile->line_struct->word1));
+        action_by_status(sfile, get_directive_status(WORD_OF_LINE(&sfile->line_struct, 1)));
+    }
+}
+
+static bool first_pass_on_chunks(ptr_file sfile){
+    ptr_chunk chunks;
+    int count_chunks;
+    bool result = TRUE;
+    int i;
 
-        /* Free the memory occupied by the line data structure. */
-        free_line(sfile->line_struct);
+    /* A file with errors of the pre-assembly is read by a single thread, as its instructions add no words. */
+    if (sfile->count_chunks < 2 || sfile->error_flag == TRUE){
+        return FALSE;
+    }
+    chunks = (ptr_chunk) malloc(sizeof(item_chunk) * (size_t) sfile->count_chunks);
+    if (chunks == NULL){
+        fprintf(stderr, "Error in dynamic memory allocation");
+        exit(EXIT_FAILURE);
+    }
+    count_chunks = split_to_chunks(sfile, chunks);
+    if (count_chunks < 2){
+        free(chunks);
+        return FALSE;
     }
 
-    /* If no errors occurred during the first pass, update the addresses of labels used in data directives. */
-    if (sfile->error_flag == FALSE){
-        update_address_label_of_data();
+    /* Read all the chunks at the same time, then merge them in their order. */
+    run_tasks(count_chunks, count_chunks, run_chunk_task, NULL, chunks);
+    for (i = 0; i < count_chunks; i++){
+        if (result == TRUE && merge_chunk(sfile, &chunks[i]) == FALSE){
+            result = FALSE;
+        }
+
+        /* The text and the line index of the chunk belong to the file, so they are not released with the struct of the chunk. */
+        init_buffer(&chunks[i].chunk_file->text_am);
+        init_line_index(&chunks[i].chunk_file->line_index);
+        release_file(chunks[i].chunk_file);
+    }
+    free(chunks);
+
+    /* The errors recorded by the chunks are dropped with them: a file with errors is read again, so they are reported in order. */
+    if (result == FALSE){
+        reset_first_pass(sfile);
     }
+    return result;
 }
 
-static void update_files(){
-    /* Close the currently opened file streams. */
-    fclose(sfile->file_as);
-    fclose(sfile->file_am);
+static int split_to_chunks(ptr_file sfile, ptr_chunk chunks){
+    size_t position = 0;
+    size_t length;
+    int count_lines = 0;
+    int count_chunks;
+    int lines_per_chunk;
+    int i;
+
+    /* Count the lines of the file to find how many chunks it holds. */
+    while (get_line_view_of_buffer(&sfile->text_am, &position, sizeof(sfile->line_text), &length) != NULL){
+        count_lines++;
+    }
+    count_chunks = count_lines / MIN_CHUNK_LINES;
+    if (count_chunks > sfile->count_chunks){
+        count_chunks = sfile->count_chunks;
+    }
+    if (count_chunks < 2){
+        return count_chunks;
+    }
 
-    /* Open the intermediate file for reading. */
-    sfile->file_am = open_file(sfile->name_file, EXT_MACRO,"r"); /* */
+    /* Every chunk but the last one holds 'lines_per_chunk' lines. */
+    lines_per_chunk = (count_lines + count_chunks - 1) / count_chunks;
+    position = 0;
+    count_lines = 0;
+    for (i = 0; i < count_chunks; i++){
+        chunks[i].sfile = sfile;
+        chunks[i].chunk_file = NULL;
+        chunks[i].start_in_am = position;
+        chunks[i].first_line = count_lines;
+        while (count_lines < (i + 1) * lines_per_chunk &&
+               get_line_view_of_buffer(&sfile->text_am, &position, sizeof(sfile->line_text), &length) != NULL){
+            count_lines++;
+        }
+        chunks[i].end_in_am = position;
+    }
+    return count_chunks;
+}
+
+static void run_chunk_task(int index, void *chunks){
+    ptr_chunk chunk = &((ptr_chunk) chunks)[index];
+    ptr_file chunk_file;
+
+    /* The chunk is read like a file of its own, whose code starts at 'FIRST_CELL_IN_MEMORY' and data at zero. Its errors
+     * are only recorded in its list of diagnostics, so it needs no console stream. */
+    chunk_file = create_new_file_struct(chunk->sfile->name_file, NULL, NULL);
+    chunk_file->single_pass_flag = chunk->sfile->single_pass_flag;
+    free_buffer(&chunk_file->text_am);
+    chunk_file->text_am = chunk->sfile->text_am;
+    free_line_index(&chunk_file->line_index);
+    chunk_file->line_index = chunk->sfile->line_index;
+    chunk_file->pos_in_am = chunk->start_in_am;
+    chunk_file->count_line = chunk->first_line;
+    first_pass_on_lines(chunk_file, chunk->end_in_am);
+    chunk->chunk_file = chunk_file;
 }
 
-static char * update_next_line(){
-    /* Clear the 'line_text' buffer before reading the next line. */
-    memset(sfile->line_text, 0, MAX_ASSEMBLY_LINE_LENGTH);
+static bool merge_chunk(ptr_file sfile, ptr_chunk chunk){
+    ptr_file chunk_file = chunk->chunk_file;
+    ptr_label label_node;
+    ptr_fixup fixup;
+    int offset_code = sfile->IC - FIRST_CELL_IN_MEMORY;
+    int offset_data = sfile->DC;
+    int address;
+    int i;
 
-    /* Read the next line from the intermediate file and store it in 'line_text'. */
-    return fgets(sfile->line_text,sizeof (sfile->line_text),sfile->file_am);
+    if (chunk_file->error_flag == TRUE){
+        return FALSE;
+    }
+
+    /* Add the labels of the chunk in their order, at their addresses in the file. */
+    for (label_node = chunk_file->label_table.head_label; label_node != NULL; label_node = label_node->next){
+        address = label_node->address_label;
+        if (label_node->type == CODE){
+            address += offset_code;
+        } else if (label_node->type == DATA){
+            address += offset_data;
+        }
+        if (add_to_list_label(&sfile->label_table, label_node->name_label, address, label_node->type) != NO_ERROR){
+            return FALSE;
+        }
+    }
+    sfile->label_table.count_probe += chunk_file->label_table.count_probe;
+
+    /* Append the code and the data words of the chunk. */
+    for (i = 0; i < chunk_file->IC - FIRST_CELL_IN_MEMORY; i++){
+        *get_word_of_array(&sfile->instruction_array, offset_code + i) = *get_word_of_array(&chunk_file->instruction_array, i);
+    }
+    for (i = 0; i < chunk_file->DC; i++){
+        *get_word_of_array(&sfile->data_array, offset_data + i) = *get_word_of_array(&chunk_file->data_array, i);
+    }
+
+    /* Append the fixups of the chunk; their line numbers are already those of the file. */
+    for (i = 0; i < chunk_file->fixup_list.count_fixup; i++){
+        fixup = &chunk_file->fixup_list.fixups[i];
+        add_to_list_fixup(&sfile->fixup_list, fixup->type,
+                          (fixup->type == FIXUP_OPERAND) ? fixup->address + offset_code : fixup->address, fixup->line,
+                          fixup->column, get_text_of_fixup(&chunk_file->fixup_list, fixup));
+    }
+
+    /* Move the counters of the file past the chunk. */
+    sfile->IC += chunk_file->IC - FIRST_CELL_IN_MEMORY;
+    sfile->DC += chunk_file->DC;
+    sfile->count_line = chunk_file->count_line;
+    if (chunk_file->extern_flag == TRUE){
+        sfile->extern_flag = TRUE;
+    }
+    return (sfile->IC + sfile->DC <= MEMORY_SIZE) ? TRUE : FALSE;
 }
 
-static void update_line_to_array(){
-    /* Create a new line structure using the content of the 'line_text' buffer. */
-    sfile->line_struct = create_new_line_struct(sfile->line_text);
+static void reset_first_pass(ptr_file sfile){
+    clear_list_label(&sfile->label_table);
+    clear_word_array(&sfile->instruction_array);
+    clear_word_array(&sfile->data_array);
+    clear_list_fixup(&sfile->fixup_list);
+    sfile->IC = FIRST_CELL_IN_MEMORY;
+    sfile->DC = 0;
+    sfile->extern_flag = FALSE;
+    sfile->count_line = 0;
+    sfile->pos_in_am = 0;
 }
 
-static void actions_on_label(){
+static void update_files(ptr_file sfile){
+    /* Read the expanded code from its beginning. */
+    sfile->pos_in_am = 0;
+}
+
+static char * update_next_line(ptr_file sfile){
+    /* Read the next line from the expanded code and store it in 'line_text' (null-terminated, no clearing needed). */
+    return read_line_of_buffer(&sfile->text_am, &sfile->pos_in_am, sfile->line_text, sizeof (sfile->line_text));
+}
+
+static void update_line_to_array(ptr_file sfile){
+    ptr_line record = get_from_line_index(&sfile->line_index, sfile->count_line - 1);
+
+    /* A line of a macro body was split when the macro was defined, so its record is copied. Otherwise, create a new line structure using the content of the 'line_text' buffer. */
+    if (record != NULL){
+        copy_line_struct(&sfile->line_struct, record);
+    } else {
+        split_line_to_words(&sfile->line_struct, sfile->line_text);
+    }
+}
+
+static void actions_on_label(ptr_file sfile){
     line_status temp_status;
 
     /* Check if the current line contains a label. */
-    if(is_label(sfile->line_struct) == TRUE){
+    if(is_label(&sfile->line_struct) == TRUE){
         /* Determine the type of label (instruction, directive, entry, or extern). */
-        temp_status = get_word_status(sfile->line_struct->word2);
+        temp_status = get_directive_status(WORD_OF_LINE(&sfile->line_struct, 2));
         switch (temp_status) {
             case STATUS_ENTRY:
                 /* Error: Entry label should not be defined before the entry directive. */
-                add_error(CANT_DEFINE_LABEL_BEFORE_ENTRY);
-                sfile->line_struct->count = 0;
+                add_error(sfile, CANT_DEFINE_LABEL_BEFORE_ENTRY, COLUMN_OF_LINE(&sfile->line_struct, 1));
+                add_entry_fixup(sfile);
+                sfile->line_struct.count = 0;
                 break;
             case STATUS_EXTERN:
                 /* Error: Extern label should not be defined before the extern directive. */
-                add_error(CANT_DEFINE_LABEL_BEFORE_EXTERN);
-                sfile->line_struct->count = 0;
+                add_error(sfile, CANT_DEFINE_LABEL_BEFORE_EXTERN, COLUMN_OF_LINE(&sfile->line_struct, 1));
+                sfile->line_struct.count = 0;
                 break;
             default:
                 /* Add the label to the label list and remove the label from the line structure. */
                 sfile->pos_in_line = skip_one_word_in_line(sfile->pos_in_line, sfile->line_text);
-                add_new_label_to_list(temp_status);
-                delete_label_from_line_struct(sfile->line_struct);
+                add_new_label_to_list(sfile, temp_status);
+                delete_label_from_line_struct(&sfile->line_struct);
                 break;
         }
     }
 }
 
-static void add_new_label_to_list(line_status temp_status){
+static void add_new_label_to_list(ptr_file sfile, line_status temp_status){
     /* Check if the label name is valid. */
-    if (is_label_name_valid(sfile->line_struct->word1) == TRUE){
+    if (is_label_name_valid(WORD_OF_LINE(&sfile->line_struct, 1)) == TRUE){
         /* Add the label to the label list with the corresponding address and type. */
         if (temp_status == STATUS_DATA || temp_status == STATUS_STRING){
-            update_error_status(add_to_list_label(&sfile->head_label_list, sfile->line_struct->word1, sfile->DC, DATA));
+            update_error_status(sfile, add_to_list_label(&sfile->label_table, WORD_OF_LINE(&sfile->line_struct, 1), sfile->DC, DATA),
+                                COLUMN_OF_LINE(&sfile->line_struct, 1));
         }
         if (temp_status == STATUS_CODE){
-            update_error_status(add_to_list_label(&sfile->head_label_list, sfile->line_struct->word1, sfile->IC, CODE));
+            update_error_status(sfile, add_to_list_label(&sfile->label_table, WORD_OF_LINE(&sfile->line_struct, 1), sfile->IC, CODE),
+                                COLUMN_OF_LINE(&sfile->line_struct, 1));
         }
     } else {
         /* Error: Invalid label name. */
-        add_error(INVALID_LABEL_NAME);
-    }
-}
-
-static line_status get_word_status(char *word_text){
-    /* Compare the 'word_text' with predefined directives and instructions. */
-    if (strcmp(word_text, DOT_DATA) == 0){
-        return STATUS_DATA;
-    }
-    if (strcmp(word_text, DOT_STRING) == 0){
-        return STATUS_STRING;
+        add_error(sfile, INVALID_LABEL_NAME, COLUMN_OF_LINE(&sfile->line_struct, 1));
     }
-    if (strcmp(word_text, DOT_EXTERN) == 0){
-        return STATUS_EXTERN;
-    }
-    if (strcmp(word_text, DOT_ENTRY) == 0){
-        return STATUS_ENTRY;
-    }
-    /* If the 'word_text' does not match any predefined directive, it is considered an instruction or label (code status). */
-    return STATUS_CODE;
 }
 
-static void action_by_status(line_status status){
+static void action_by_status(ptr_file sfile, line_status status){
     switch (status) {
         case STATUS_DATA:
             /* Handle the ".data" directive and save data values. */
-            save_data();
+            save_data(sfile);
             break;
         case STATUS_STRING:
             /* Handle the ".string" directive and save string characters. */
-            save_string();
+            save_string(sfile);
             break;
         case STATUS_EXTERN:
             /* Handle the ".extern" directive and add external labels. */
-            add_extern_labels();
+            add_extern_labels(sfile);
             break;
         case STATUS_ENTRY:
-            return; /* Return without taking any action for ".entry" directive (handled during second pass). */
+            /* The ".entry" directive is handled during the second pass (or from its fixup in the single-pass mode). */
+            add_entry_fixup(sfile);
+            break;
         case STATUS_CODE:
             /* Handle instructions and labels in the code section. */
-            add_instructions();
+            add_instructions(sfile);
             break;
     }
 }
 
-static void add_error(error_code error_code){
-    /* Print the error message along with the line number where the error occurred. */
-    print_error(error_code,sfile->count_line);
+static void add_error(ptr_file sfile, error_code error_code, int column){
+    /* Record the error with the line number and the column; it is printed with the result of the file. */
+    add_to_list_diagnostic(&sfile->diagnostic_list, error_code, sfile->count_line, column);
 
     /* Set the error flag to indicate the presence of errors during the assembly process. */
     sfile->error_flag = TRUE;
@@ -578,16 +826,17 @@ static void add_error(error_code error_code){
     (sfile->count_error)++;
 }
 
-static void update_error_status(error_code error_code){
+static void update_error_status(ptr_file sfile, error_code error_code, int column){
     if (error_code != NO_ERROR){
         /* Call the function to add the error to the file's error list. */
-        add_error(error_code);
+        add_error(sfile, error_code, column);
     }
 }
 
-static void save_data(){
+static void save_data(ptr_file sfile){
     char temp_word[MAX_ASSEMBLY_LINE_LENGTH] = "";
     int temp_number;
+    int column;
 
     /* Skip the first word (assumed to be ".data") in the current line. */
     sfile->pos_in_line = skip_one_word_in_line(sfile->pos_in_line, sfile->line_text);
@@ -595,7 +844,7 @@ static void save_data(){
     /* Check if there are no values provided after the ".data" directive. */
     if (is_end_line(sfile->pos_in_line, sfile->line_text) == TRUE){
         /* Error: No values provided after ".data" directive. */
-        add_error(MUST_PROVIDE_VALUES_TO_DATA);
+        add_error(sfile, MUST_PROVIDE_VALUES_TO_DATA, COLUMN_OF_LINE(&sfile->line_struct, 1));
         return;
     } else {
         do {
@@ -605,29 +854,32 @@ static void save_data(){
             /* Check if there is an invalid comma position. */
             if (sfile->line_text[sfile->pos_in_line] == ','){
                 /* Error: Comma found at an invalid position. */
-                add_error(INVALID_COMMA_POSITION);
+                add_error(sfile, INVALID_COMMA_POSITION, sfile->pos_in_line + 1);
                 return;
             }
 
             /* Get the next word without the comma (if any) and store it in 'temp_word'. */
-            strcpy(temp_word, get_next_word_without_comma()); /* */
+            column = sfile->pos_in_line + 1;
+            get_next_word_without_comma(sfile, temp_word);
 
             /* Check if the extracted word is a valid number. */
             if (is_number(temp_word) == TRUE){
                 temp_number = atoi(temp_word);
 
                 /* Store the data value in the data array and increment the Data Counter. */
-                sfile->data_array[sfile->DC] = (unsigned int) temp_number;
+                *get_data_word(sfile) = (unsigned int) temp_number;
                 (sfile->DC)++;
             } else {
                 /* Error: Data value is not a valid number. */
-                add_error(DATA_NEED_NUM_VALUE);
+                add_error(sfile, DATA_NEED_NUM_VALUE, column);
             }
-        } while (check_for_comma() == TRUE); /* Continue processing while there is a comma. */
+        } while (check_for_comma(sfile) == TRUE); /* Continue processing while there is a comma. */
     }
 }
 
-static void save_string(){
+static void save_string(ptr_file sfile){
+    int column;
+
     /* Skip the first word (assumed to be ".string") in the current line. */
     sfile->pos_in_line = skip_one_word_in_line(sfile->pos_in_line, sfile->line_text);
 
@@ -635,6 +887,7 @@ static void save_string(){
     sfile->pos_in_line = skip_white_character(sfile->pos_in_line, sfile->line_text);
 
     /* Check if the first character after ".string" is a quote. */
+    column = sfile->pos_in_line + 1;
     if (sfile->line_text[sfile->pos_in_line] == '"'){
         /* Move to the next character after the opening quote. */
         (sfile->pos_in_line)++;
@@ -642,7 +895,7 @@ static void save_string(){
         /* Process the characters within the quotes until a closing quote is found. */
         while(is_end_line(sfile->pos_in_line, sfile->line_text) == FALSE && sfile->line_text[sfile->pos_in_line] != '"'){
             /* Store the ASCII value of the current character in the data array and increment the Data Counter. */
-            sfile->data_array[sfile->DC] = (unsigned int) sfile->line_text[sfile->pos_in_line];
+            *get_data_word(sfile) = (unsigned int) sfile->line_text[sfile->pos_in_line];
             (sfile->DC)++;
             (sfile->pos_in_line)++;
         }
@@ -653,26 +906,28 @@ static void save_string(){
             (sfile->pos_in_line)++;
 
             /* Null-terminate the string in the data array and increment the Data Counter. */
-            sfile->data_array[sfile->DC] = '\0';
+            *get_data_word(sfile) = '\0';
             (sfile->DC)++;
 
             /* Check for additional parameters after the closing quote. */
             if (is_end_line(sfile->pos_in_line, sfile->line_text) == FALSE){
                 /* Error: String directive should have only one parameter (the string). */
-                add_error(STRING_DIRECTIVE_ACCEPTS_ONE_PARAMETER);
+                add_error(sfile, STRING_DIRECTIVE_ACCEPTS_ONE_PARAMETER,
+                          skip_white_character(sfile->pos_in_line, sfile->line_text) + 1);
             }
         } else {
             /* Error: String must end in quotes. */
-            add_error(STRING_MUST_END_IN_QUOTES);
+            add_error(sfile, STRING_MUST_END_IN_QUOTES, column);
         }
     } else {
         /* Error: Invalid string structure. */
-        add_error(STRING_STRUCTURE_NOT_VALID);
+        add_error(sfile, STRING_STRUCTURE_NOT_VALID, column);
     }
 }
 
-static void add_extern_labels(){
+static void add_extern_labels(ptr_file sfile){
     char temp_word[MAX_ASSEMBLY_LINE_LENGTH] = "";
+    int column;
 
     /* Set the extern_flag to TRUE, indicating that the current file contains extern labels. */
     sfile->extern_flag = TRUE;
@@ -683,7 +938,7 @@ static void add_extern_labels(){
     /* Check if the line is empty after the ".extern" directive. */
     if (is_end_line(sfile->pos_in_line, sfile->line_text) == TRUE){
         /* Error: No labels provided after the ".extern" directive. */
-        add_error(MUST_PROVIDE_LABELS_TO_EXTERN);
+        add_error(sfile, MUST_PROVIDE_LABELS_TO_EXTERN, COLUMN_OF_LINE(&sfile->line_struct, 1));
         return;
     } else {
         /* Process each label separated by commas in the line. */
@@ -694,194 +949,107 @@ static void add_extern_labels(){
             /* Check for an invalid comma position. */
             if (sfile->line_text[sfile->pos_in_line] == ','){
                 /* Error: Comma found at an invalid position. */
-                add_error(INVALID_COMMA_POSITION);
+                add_error(sfile, INVALID_COMMA_POSITION, sfile->pos_in_line + 1);
                 return;
             }
 
             /* Extract the next label without the comma and store it in 'temp_word'. */
-            strcpy(temp_word, get_next_word_without_comma());
+            column = sfile->pos_in_line + 1;
+            get_next_word_without_comma(sfile, temp_word);
 
             /* Validate the label name extracted from 'temp_word'. */
             if (is_label_name_valid(temp_word) == TRUE){
                 /* Add the valid label to the external label list with the 'EXTERN' label type and address 0. */
-                update_error_status(add_to_list_label(&sfile->head_label_list, temp_word, 0, EXTERN));
+                update_error_status(sfile, add_to_list_label(&sfile->label_table, temp_word, 0, EXTERN), column);
             } else {
                 /* Error: Invalid label name. */
-                add_error(INVALID_LABEL_NAME);
+                add_error(sfile, INVALID_LABEL_NAME, column);
             }
-        } while (check_for_comma() == TRUE); /* Check if there are more labels to process. */
+        } while (check_for_comma(sfile) == TRUE); /* Check if there are more labels to process. */
     }
 }
 
 
-static void add_instructions(){
+static void add_instructions(ptr_file sfile){
     instruction_type type;
 
     /* Determine the type of instruction based on the first word of the line. */
-    type = get_instruction_type(sfile->line_struct->word1);
+    type = get_instruction_type(WORD_OF_LINE(&sfile->line_struct, 1));
 
     /* Update the addressing method type for the instruction. */
-    update_addressing_method_type(type);
+    update_operands_of_line(&sfile->line_struct, type);
+
+    /* Record the operands that refer to labels, to be completed at the end of the file. */
+    add_operand_fixups(sfile);
 
     /* Check for errors related to the instruction. */
-    check_errors_for_instructions(type);
+    check_errors_for_instructions(sfile, type);
 
     /* If no errors are found, add the instruction and its operands to the machine code array. */
     if (sfile->error_flag == FALSE){
         /* Add the binary representation of the instruction's first word to the machine code array. */
-        add_first_word_of_instruction_to_array(type);
+        add_first_word_of_instruction_to_array(sfile, type);
 
         /* Add the rest of the instruction (operands) to the machine code array. */
-        add_the_rest_of_the_instruction_to_array();
-    }
-}
-
-static void update_addressing_method_type(instruction_type type){
-    /* Check the type of instruction and update addressing method types accordingly */
-    switch (type) {
-        case MOV: case CMP: case ADD: case SUB: case LEA:
-            /* For instructions with two operands, update the addressing method type for both source and destination. */
-            sfile->line_struct->source = get_addressing_method_type(sfile->line_struct->word2);
-            sfile->line_struct->destination = get_addressing_method_type(sfile->line_struct->word4);
-            break;
-        case NOT: case CLR: case INC: case DEC: case JMP: case BNE: case RED: case PRN: case JSR:
-            /* For instructions with a single operand, update the destination field, and set the source field to NOT_EXIST. */
-            sfile->line_struct->source = NOT_EXIST;
-            sfile->line_struct->destination = get_addressing_method_type(sfile->line_struct->word2);
-
-            /* Copy the operand to word4 since there's only one operand for these instructions. */
-            strcpy(sfile->line_struct->word4, sfile->line_struct->word2);
-            break;
-        default:
-            /* For instructions with no operands, set both source and destination fields to NOT_EXIST. */
-            sfile->line_struct->source = NOT_EXIST;
-            sfile->line_struct->destination = NOT_EXIST;
-            break;
+        add_the_rest_of_the_instruction_to_array(sfile);
     }
 }
 
-static void check_errors_for_instructions(instruction_type type){
+static void check_errors_for_instructions(ptr_file sfile, instruction_type type){
     /* Check for errors related to the number of operands */
-    if (sfile->line_struct->count == TOO_MUCH || sfile->line_struct->count == FIVE){
-        add_error(TOO_MUCH_WORDS_FOR_INSTRUCTION);
+    if (sfile->line_struct.count == TOO_MUCH || sfile->line_struct.count == FIVE){
+        add_error(sfile, TOO_MUCH_WORDS_FOR_INSTRUCTION, COLUMN_OF_LINE(&sfile->line_struct, 1));
     }
 
-    /* Check for instruction-specific errors */
-    switch (type) {
-        case MOV: case CMP: case ADD: case SUB: case LEA:
-            if (sfile->line_struct->count != FOUR){ add_error(INSTRUCTION_SHOULD_RECEIVE_TWO_OPERANDS); }
-            if (strcmp(sfile->line_struct->word3, ",") != 0) { add_error(COMMA_REQUIRED_BETWEEN_OPERANDS); }
+    /* Check the number of operands of the instruction (from the table of the instructions) */
+    switch (get_instruction_spec(type)->count_operands) {
+        case 2:
+            if (sfile->line_struct.count != FOUR){ add_error(sfile, INSTRUCTION_SHOULD_RECEIVE_TWO_OPERANDS, COLUMN_OF_LINE(&sfile->line_struct, 1)); }
+            if (strcmp(WORD_OF_LINE(&sfile->line_struct, 3), ",") != 0) { add_error(sfile, COMMA_REQUIRED_BETWEEN_OPERANDS, COLUMN_OF_LINE(&sfile->line_struct, 3)); }
             break;
-        case NOT: case CLR: case INC: case DEC: case JMP: case BNE: case RED: case PRN: case JSR:
-            if (sfile->line_struct->count != TWO){ add_error(INSTRUCTION_SHOULD_RECEIVE_ONE_OPERAND); }
+        case 1:
+            if (sfile->line_struct.count != TWO){ add_error(sfile, INSTRUCTION_SHOULD_RECEIVE_ONE_OPERAND, COLUMN_OF_LINE(&sfile->line_struct, 1)); }
             break;
-        case RTS: case STOP:
-            if (sfile->line_struct->count != ONE){ add_error(INSTRUCTION_SHOULD_NOT_RECEIVE_OPERANDS); }
+        case 0:
+            if (sfile->line_struct.count != ONE){ add_error(sfile, INSTRUCTION_SHOULD_NOT_RECEIVE_OPERANDS, COLUMN_OF_LINE(&sfile->line_struct, 1)); }
             break;
-        case NOT_INSTRUCTION:
-            add_error(INSTRUCTION_NAME_NOT_EXIST);
+        default:
+            add_error(sfile, INSTRUCTION_NAME_NOT_EXIST, COLUMN_OF_LINE(&sfile->line_struct, 1));
             break;
     }
 
-    /* Check for invalid addressing methods for specific instructions */
-    if (type == MOV || type == ADD || type == SUB){
-        if (sfile->line_struct->destination == IMMEDIATE) {
-            add_error(INVALID_ADDRESS_METHOD_FOR_INSTRUCTION);
-            return;
-        }
-    }
-    if (type == LEA){
-        if (sfile->line_struct->destination == IMMEDIATE ||
-            sfile->line_struct->source != DIRECT) {
-            add_error(INVALID_ADDRESS_METHOD_FOR_INSTRUCTION);
-            return;
-        }
-    }
-    if (type == NOT || type == CLR || type == INC || type == DEC || type == JMP || type == BNE ||
-        type == RED || type == JSR){
-        if (sfile->line_struct->destination == IMMEDIATE) {
-            add_error(INVALID_ADDRESS_METHOD_FOR_INSTRUCTION);
-            return;
-        }
+    /* Check the addressing methods of the operands against the bitmasks of the instruction */
+    if (is_valid_addressing(type, sfile->line_struct.source, sfile->line_struct.destination) == FALSE){
+        add_error(sfile, INVALID_ADDRESS_METHOD_FOR_INSTRUCTION, COLUMN_OF_LINE(&sfile->line_struct, 1));
     }
 }
 
-static void add_first_word_of_instruction_to_array(instruction_type type){
-    /* Bit-field structure to construct the first word of the instruction */
-    struct {
-        unsigned int encoding_type:2; /* Encoding type field (2 bits) */
-        unsigned int destination_address:3; /* Destination address field (3 bits) */
-        unsigned int opcode:4; /* Opcode field (4 bits) */
-        unsigned int source_address:3; /* Source address field (3 bits) */
-    } first_word_of_instruction;
-
-    /* Set the values of the bit-field structure fields */
-    first_word_of_instruction.encoding_type = ABSOLUTE;
-    first_word_of_instruction.destination_address = sfile->line_struct->destination;
-    first_word_of_instruction.opcode = type;
-    first_word_of_instruction.source_address = sfile->line_struct->source;
-
-    /* Copy the constructed first word to the instruction array at the current 'IC' index */
-    memcpy(&sfile->instruction_array[sfile->IC], &first_word_of_instruction, sizeof(unsigned int));
+static void add_first_word_of_instruction_to_array(ptr_file sfile, instruction_type type){
+    /* Build the first word of the instruction at the current 'IC' index */
+    *get_code_word(sfile) = ENCODE_FIRST_WORD(type, sfile->line_struct.source, sfile->line_struct.destination);
 
     /* Increment the 'IC' for the next word of the instruction */
     (sfile->IC)++;
 }
 
-static void add_the_rest_of_the_instruction_to_array(){
-    int temp_number;
-
+static void add_the_rest_of_the_instruction_to_array(ptr_file sfile){
     /* Handle the source operand of the instruction */
-    switch (sfile->line_struct->source) {
+    switch (sfile->line_struct.source) {
         case REGISTER:
-            {
-                /* Bit-field structure for source operand with register addressing */
-                struct {
-                    unsigned int encoding_type:2; /* Encoding type field (2 bits) */
-                    unsigned int register_number_destination:5; /* Register number for destination operand (5 bits) */
-                    unsigned int register_number_source:5; /* Register number for source operand (5 bits) */
-                } word_of_instruction;
-
-                /* Set the values of the bit-field structure fields */
-                word_of_instruction.encoding_type = ABSOLUTE;
-                word_of_instruction.register_number_source = get_number_of_register(sfile->line_struct->word2);
-
-                /* Check if the destination operand is also a register */
-                if (sfile->line_struct->destination == REGISTER){
-                    word_of_instruction.register_number_destination = get_number_of_register(sfile->line_struct->word4);
-                } else {
-                    word_of_instruction.register_number_destination = NOT_EXIST;
-                }
-
-                /* Copy the constructed word to the instruction array at the current 'IC' index */
-                memcpy(&sfile->instruction_array[sfile->IC], &word_of_instruction, sizeof(unsigned int));
-                (sfile->IC)++;
-            }
+            /* The word of the source register also holds the destination register, if the destination is a register too */
+            *get_code_word(sfile) = ENCODE_REGISTER_WORD(get_number_of_register(WORD_OF_LINE(&sfile->line_struct, 2)),
+                    (sfile->line_struct.destination == REGISTER) ?
+                    get_number_of_register(WORD_OF_LINE(&sfile->line_struct, 4)) : 0);
+            (sfile->IC)++;
             break;
         case IMMEDIATE:
-            {
-                /* Bit-field structure for source operand with immediate addressing */
-                struct {
-                    unsigned int encoding_type:2; /* Encoding type field (2 bits) */
-                    unsigned int value:10; /* Value field for immediate operand (10 bits) */
-                } word_of_instruction;
-
-                /* Set the values of the bit-field structure fields */
-                word_of_instruction.encoding_type = ABSOLUTE;
-                temp_number = atoi(sfile->line_struct->word2);
-                word_of_instruction.value = temp_number;
-
-                /* Copy the constructed word to the instruction array at the current 'IC' index */
-                memcpy(&sfile->instruction_array[sfile->IC], &word_of_instruction, sizeof(unsigned int));
-                (sfile->IC)++;
-            }
+            *get_code_word(sfile) = ENCODE_VALUE_WORD(atoi(WORD_OF_LINE(&sfile->line_struct, 2)), ABSOLUTE);
+            (sfile->IC)++;
             break;
         case DIRECT:
-            {
-                /* Direct addressing method does not require additional words in the instruction */
-                sfile->instruction_array[sfile->IC] = 0;
-                (sfile->IC)++;
-            }
+            /* The address of the label is completed by the second pass (or by the fixups) */
+            *get_code_word(sfile) = 0;
+            (sfile->IC)++;
             break;
         case NOT_EXIST:
             /* No source operand, nothing to add */
@@ -889,51 +1057,22 @@ static void add_the_rest_of_the_instruction_to_array(){
     }
 
     /* Handle the destination operand of the instruction */
-    switch (sfile->line_struct->destination) {
+    switch (sfile->line_struct.destination) {
         case REGISTER:
             /* Check if the source operand is not a register to avoid duplication */
-            if (sfile->line_struct->source != REGISTER){
-                /* Bit-field structure for destination operand with register addressing */
-                struct {
-                    unsigned int encoding_type:2; /* Encoding type field (2 bits) */
-                    unsigned int register_number_destination:5; /* Register number for destination operand (5 bits) */
-                    unsigned int register_number_source:5; /* Source register number set to NOT_EXIST (5 bits) */
-                } word_of_instruction;
-
-                /* Set the values of the bit-field structure fields */
-                word_of_instruction.encoding_type = ABSOLUTE;
-                word_of_instruction.register_number_source = NOT_EXIST;
-                word_of_instruction.register_number_destination = get_number_of_register(sfile->line_struct->word4);
-
-                /* Copy the constructed word to the instruction array at the current 'IC' index */
-                memcpy(&sfile->instruction_array[sfile->IC], &word_of_instruction, sizeof(unsigned int));
+            if (sfile->line_struct.source != REGISTER){
+                *get_code_word(sfile) = ENCODE_REGISTER_WORD(0, get_number_of_register(WORD_OF_LINE(&sfile->line_struct, 4)));
                 (sfile->IC)++;
             }
             break;
         case IMMEDIATE:
-            {
-                /* Bit-field structure for destination operand with immediate addressing */
-                struct {
-                    unsigned int encoding_type:2; /* Encoding type field (2 bits) */
-                    unsigned int value:10; /* Value field for immediate operand (10 bits) */
-                } word_of_instruction;
-
-                /* Set the values of the bit-field structure fields */
-                word_of_instruction.encoding_type = ABSOLUTE;
-                temp_number = atoi(sfile->line_struct->word4);
-                word_of_instruction.value = temp_number;
-
-                /* Copy the constructed word to the instruction array at the current 'IC' index */
-                memcpy(&sfile->instruction_array[sfile->IC], &word_of_instruction, sizeof(unsigned int));
-                (sfile->IC)++;
-            }
+            *get_code_word(sfile) = ENCODE_VALUE_WORD(atoi(WORD_OF_LINE(&sfile->line_struct, 4)), ABSOLUTE);
+            (sfile->IC)++;
             break;
         case DIRECT:
-            {
-                /* Direct addressing method does not require additional words in the instruction */
-                sfile->instruction_array[sfile->IC] = 0;
-                (sfile->IC)++;
-            }
+            /* The address of the label is completed by the second pass (or by the fixups) */
+            *get_code_word(sfile) = 0;
+            (sfile->IC)++;
             break;
         case NOT_EXIST:
             /* No destination operand, nothing to add */
@@ -941,9 +1080,7 @@ static void add_the_rest_of_the_instruction_to_array(){
     }
 }
 
-static char * get_next_word_without_comma(){
-    /* Static buffer to store the extracted word */
-    static char temp_word[MAX_ASSEMBLY_LINE_LENGTH] = "";
+static char * get_next_word_without_comma(ptr_file sfile, char *word_text){
     int j = 0;
 
     /* Read characters until a space, tab, newline, comma, or the end of the line is encountered */
@@ -952,20 +1089,20 @@ static char * get_next_word_without_comma(){
            sfile->line_text[sfile->pos_in_line] != '\n' &&
            sfile->line_text[sfile->pos_in_line] != ',' &&
            sfile->line_text[sfile->pos_in_line] != '\0') {
-                temp_word[j] = sfile->line_text[sfile->pos_in_line];
+                word_text[j] = sfile->line_text[sfile->pos_in_line];
                 (sfile->pos_in_line)++;
                 j++;
     }
 
     /* Null-terminate the extracted word */
-    temp_word[j] = '\0';
+    word_text[j] = '\0';
 
     /* Skip any white characters to move to the next word or the end of the line */
     sfile->pos_in_line = skip_white_character(sfile->pos_in_line, sfile->line_text);
-    return temp_word;
+    return word_text;
 }
 
-static bool check_for_comma(){
+static bool check_for_comma(ptr_file sfile){
     if (sfile->line_text[sfile->pos_in_line] == ','){
         /* A comma is found, increment the position and return TRUE. */
         (sfile->pos_in_line)++;
@@ -973,13 +1110,53 @@ static bool check_for_comma(){
     } else {
         /* If the current character is not a comma and not the end of the line, add an error message. */
         if (sfile->line_text[sfile->pos_in_line] != '\n' && sfile->line_text[sfile->pos_in_line] != '\0'){
-            add_error(COMMA_REQUIRED_BETWEEN_VALUES);
+            add_error(sfile, COMMA_REQUIRED_BETWEEN_VALUES, sfile->pos_in_line + 1);
         }
         /* Return FALSE as a comma is not found at the current position. */
         return FALSE;
     }
 }
 
-static void update_address_label_of_data(){
-    update_address_of_data(sfile->head_label_list, sfile->IC);
-}
\ No newline at end of file
+static void update_address_label_of_data(ptr_file sfile){
+    update_address_of_data(&sfile->label_table, sfile->IC);
+}
+static void add_operand_fixups(ptr_file sfile){
+    int address = sfile->IC + 1;
+
+    if (sfile->single_pass_flag == FALSE){
+        return;
+    }
+    if (sfile->line_struct.source == DIRECT){
+        add_to_list_fixup(&sfile->fixup_list, FIXUP_OPERAND, address, sfile->count_line,
+                          COLUMN_OF_LINE(&sfile->line_struct, 2), WORD_OF_LINE(&sfile->line_struct, 2));
+    }
+    if (sfile->line_struct.source != NOT_EXIST){
+        address++;
+    }
+    if (sfile->line_struct.destination == DIRECT){
+        add_to_list_fixup(&sfile->fixup_list, FIXUP_OPERAND, address, sfile->count_line,
+                          COLUMN_OF_LINE(&sfile->line_struct, 4), WORD_OF_LINE(&sfile->line_struct, 4));
+    }
+}
+
+static void add_entry_fixup(ptr_file sfile){
+    if (sfile->single_pass_flag == TRUE){
+        add_to_list_fixup(&sfile->fixup_list, FIXUP_ENTRY, 0, sfile->count_line, 0, sfile->line_text);
+    }
+}
+
+static unsigned int * get_code_word(ptr_file sfile){
+    check_memory_size(sfile);
+    return get_word_of_array(&sfile->instruction_array, sfile->IC - FIRST_CELL_IN_MEMORY);
+}
+
+static unsigned int * get_data_word(ptr_file sfile){
+    check_memory_size(sfile);
+    return get_word_of_array(&sfile->data_array, sfile->DC);
+}
+
+static void check_memory_size(ptr_file sfile){
+    if (sfile->IC + sfile->DC == MEMORY_SIZE){
+        add_error(sfile, PROGRAM_EXCEEDS_MEMORY, 0);
+    }
+}
@@ -11,6 +11,9 @@
  *   - text_tool.h: Contains utility functions for string manipulation and parsing in the first pass.
  *   - error_tool.h: Contains functions and error codes for handling errors in the first pass.
  *   - label_list.h: Contains data structures and functions for managing the linked list of labels in the first pass.
+ *   - fixup_list.h: Contains the list of fixups, which the chunks of the first pass record and the file merges.
+ *   - pool_tool.h: Contains the pool of worker threads that reads the chunks of a file at the same time.
+ *   - word_tool.h: Contains the layouts of the machine words and the table of the instructions.
  *   - setting.h: Contains constant definitions and configurations used in the first pass of the assembly process.
  */
 
@@ -23,8 +26,40 @@
 #include "text_tool.h"
 #include "error_tool.h"
 #include "label_list.h"
+#include "fixup_list.h"
+#include "pool_tool.h"
+#include "word_tool.h"
 #include "setting.h"
 
+/*
+ * Struct: item_chunk
+ * ------------------
+ * A structure representing one chunk of the source of a file, read by the first pass on its own thread ('--chunks'
+ * option).
+ *
+ * The expanded source is split at line boundaries into chunks of at least 'MIN_CHUNK_LINES' lines. Every chunk is
+ * read by the usual first pass into a file struct of its own, as if its code started at 'FIRST_CELL_IN_MEMORY' and
+ * its data at zero, so it builds its own table of labels, code and data words and fixups. The chunks are then merged
+ * in their order: the counters of the chunks before a chunk (a prefix sum) are added to the addresses of its labels,
+ * of its words and of its fixups.
+ *
+ * Fields:
+ *   - sfile: A pointer to the file struct of the file the chunk belongs to.
+ *   - chunk_file: A pointer to the file struct the chunk is read into. Its 'text_am' and 'line_index' are those of the
+ *                 file (not copies of them), so they are emptied before the struct is released.
+ *   - start_in_am: The position of the first line of the chunk in 'text_am'.
+ *   - end_in_am: The position right after the last line of the chunk.
+ *   - first_line: The number of lines of the file before the chunk.
+ */
+typedef struct chunk_struct * ptr_chunk;
+typedef struct chunk_struct {
+    ptr_file sfile;
+    ptr_file chunk_file;
+    size_t start_in_am;
+    size_t end_in_am;
+    int first_line;
+} item_chunk;
+
 /*
  * Function: start_first_pass
  * --------------------------
@@ -39,9 +74,12 @@
  *                                    such as the file streams and line structures.
  *
  * Notes:
- *   - The function updates the static global variable 'sfile' with the 'original_file_struct' pointer,
- *     allowing other functions within the 'first_pass.c' file to access and modify information related
- *     to the source file being processed.
+ *   - The 'original_file_struct' is passed down to every function within the 'first_pass.c' file (as 'sfile'),
+ *     so files processed concurrently do not share any state.
+ *   - If 'count_chunks' of the file is more than one and the file is long enough, the source is read in chunks at the
+ *     same time (see 'item_chunk'). If a chunk has an error, a label is defined in two chunks or the merged image does
+ *     not fit in the memory, the chunks are dropped and the file is read again from its beginning, so the errors are
+ *     reported exactly as by a single thread; the chunks only pay off on a file without errors.
  */
 void start_first_pass(ptr_file original_file_struct);
 
@@ -0,0 +1,50 @@
+#include "fixup_list.h"
+
+void init_fixup_list(ptr_fixup_list list){
+    list->fixups = NULL;
+    list->count_fixup = 0;
+    list->size_fixups = 0;
+    init_buffer(&list->text_fixups);
+}
+
+void add_to_list_fixup(ptr_fixup_list list, type_of_fixup type, int address, int line, int column, const char *text){
+    ptr_fixup new_fixups;
+    ptr_fixup fixup;
+    int new_size;
+
+    /* Double the array if it is full. */
+    if (list->count_fixup == list->size_fixups){
+        new_size = (list->size_fixups == 0) ? INITIAL_FIXUP_LIST_SIZE : list->size_fixups * 2;
+        new_fixups = (ptr_fixup)realloc(list->fixups, sizeof(item_fixup) * (size_t) new_size);
+        if (new_fixups == NULL){
+            fprintf(stderr, "Error in dynamic memory allocation");
+            exit(EXIT_FAILURE);
+        }
+        list->fixups = new_fixups;
+        list->size_fixups = new_size;
+    }
+
+    /* Fill the next fixup, its text is copied to the end of the text buffer together with its null terminator. */
+    fixup = &list->fixups[(list->count_fixup)++];
+    fixup->type = type;
+    fixup->address = address;
+    fixup->line = line;
+    fixup->column = column;
+    fixup->offset_text = list->text_fixups.length;
+    append_to_buffer(&list->text_fixups, text, strlen(text) + 1);
+}
+
+const char * get_text_of_fixup(ptr_fixup_list list, ptr_fixup fixup){
+    return list->text_fixups.text + fixup->offset_text;
+}
+
+void clear_list_fixup(ptr_fixup_list list){
+    list->count_fixup = 0;
+    truncate_buffer(&list->text_fixups, 0);
+}
+
+void free_list_fixup(ptr_fixup_list list){
+    free(list->fixups);
+    free_buffer(&list->text_fixups);
+    init_fixup_list(list);
+}
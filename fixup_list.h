@@ -0,0 +1,152 @@
+/*
+ * Header: fixup_list.h
+ * --------------------
+ * This is the header file for managing the list of fixups of a file in the single-pass mode of the assembler.
+ *
+ * In the single-pass mode the first pass does not leave the operands that refer to labels for a second walk of the source.
+ * Instead, it records a fixup for every such operand (the address of the word to be completed, the line of the reference
+ * and the name of the label) and for every '.entry' line (its line and its text). When the first pass is done, the fixups
+ * are resolved in the order in which they were recorded, which is the order of the lines, so the messages and the
+ * external references are the same as those of the second pass.
+ *
+ * Included Files:
+ *   - stdlib.h: Standard Library. It provides functions for memory allocation, conversion, and other utility functions.
+ *   - stdio.h: Standard Input/Output library. It provides functions for input and output operations, such as file handling.
+ *   - string.h: C String Library. It provides functions for manipulating strings, such as string copying and comparison.
+ *   - buffer_tool.h: Contains the growable text buffer that keeps the texts of the fixups.
+ *   - setting.h: Contains constant definitions and configurations used throughout the assembly process.
+ */
+
+#ifndef FIXUP_LIST_H
+#define FIXUP_LIST_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "buffer_tool.h"
+#include "setting.h"
+
+/*
+ * Enum: type_of_fixup
+ * -------------------
+ * An enumeration representing the types of fixups.
+ *
+ * Enum Values:
+ *   - FIXUP_OPERAND: An operand with the direct addressing method. Its text is the name of the label, and its word in the
+ *                    code image is completed with the address of the label.
+ *   - FIXUP_ENTRY: A '.entry' line. Its text is the whole line, which is parsed again when the labels are all known.
+ */
+typedef enum {FIXUP_OPERAND, FIXUP_ENTRY} type_of_fixup;
+
+/*
+ * Struct: item_fixup
+ * ------------------
+ * A structure representing one fixup.
+ *
+ * Fields:
+ *   - type: The type of the fixup (FIXUP_OPERAND or FIXUP_ENTRY).
+ *   - address: The address (IC) of the word of the operand (not used by FIXUP_ENTRY).
+ *   - line: The number of the line of the fixup in the expanded source, for the messages.
+ *   - column: The column of the operand in its line, for the messages (0 for FIXUP_ENTRY, whose line is split again).
+ *   - offset_text: The offset of the text of the fixup in the text buffer of the list.
+ */
+typedef struct fixup_struct * ptr_fixup;
+typedef struct fixup_struct {
+    type_of_fixup type;
+    int address;
+    int line;
+    int column;
+    size_t offset_text;
+} item_fixup;
+
+/*
+ * Struct: item_fixup_list
+ * -----------------------
+ * A structure representing the list of fixups of a file, in the order in which they were added.
+ *
+ * Fields:
+ *   - fixups: A dynamically allocated array of 'size_fixups' fixups (NULL before the first fixup is added).
+ *   - count_fixup: The number of fixups stored in the list.
+ *   - size_fixups: The number of fixups allocated for 'fixups'.
+ *   - text_fixups: The texts of the fixups, each one followed by a null terminator.
+ *
+ * Notes:
+ *   - The array is doubled whenever it is full, so adding n fixups takes amortized O(n) time.
+ */
+typedef struct fixup_list * ptr_fixup_list;
+typedef struct fixup_list {
+    ptr_fixup fixups;
+    int count_fixup;
+    int size_fixups;
+    item_buffer text_fixups;
+} item_fixup_list;
+
+/*
+ * Function: init_fixup_list
+ * -------------------------
+ * Initializes an empty fixup list.
+ *
+ * Parameters:
+ *   - list: A pointer to the fixup list to be initialized.
+ *
+ * Notes:
+ *   - No memory is allocated here; the array is allocated when the first fixup is added to the list.
+ */
+void init_fixup_list(ptr_fixup_list list);
+
+/*
+ * Function: add_to_list_fixup
+ * ---------------------------
+ * Adds a new fixup at the end of the fixup list.
+ *
+ * Parameters:
+ *   - list: A pointer to the fixup list.
+ *   - type: The type of the fixup.
+ *   - address: The address of the word of the operand (0 for FIXUP_ENTRY).
+ *   - line: The number of the line of the fixup.
+ *   - column: The column of the operand in the line (0 for FIXUP_ENTRY).
+ *   - text: The name of the label (FIXUP_OPERAND) or the text of the line (FIXUP_ENTRY). It is copied into the list.
+ *
+ * Notes:
+ *   - If dynamic memory allocation fails, the function prints an error message to stderr and exits the program.
+ */
+void add_to_list_fixup(ptr_fixup_list list, type_of_fixup type, int address, int line, int column, const char *text);
+
+/*
+ * Function: get_text_of_fixup
+ * ---------------------------
+ * Returns the text of a fixup of the list.
+ *
+ * Parameters:
+ *   - list: A pointer to the fixup list.
+ *   - fixup: A pointer to a fixup of the list.
+ *
+ * Returns:
+ *   - const char*: The null-terminated text of the fixup. It is valid until the next fixup is added to the list.
+ */
+const char * get_text_of_fixup(ptr_fixup_list list, ptr_fixup fixup);
+
+/*
+ * Function: clear_list_fixup
+ * --------------------------
+ * Removes every fixup of the fixup list, keeping its memory for the next fixups.
+ *
+ * Parameters:
+ *   - list: A pointer to the fixup list to be cleared.
+ */
+void clear_list_fixup(ptr_fixup_list list);
+
+/*
+ * Function: free_list_fixup
+ * -------------------------
+ * Frees the memory occupied by the fixup list.
+ *
+ * Parameters:
+ *   - list: A pointer to the fixup list to be freed.
+ *
+ * Notes:
+ *   - The list is left empty (as after 'init_fixup_list'), so it can be used again.
+ */
+void free_list_fixup(ptr_fixup_list list);
+
+#endif /* FIXUP_LIST_H */
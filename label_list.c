@@ -9,6 +9,7 @@
  * are set accordingly. The 'next' pointer of the label node is initialized to NULL.
  *
  * Parameters:
+ *   - table: A pointer to the label table, whose arena serves the node.
  *   - name: A pointer to a character array (string) representing the name of the label.
  *   - address: An integer representing the address associated with the label.
  *   - type: An enumerated type representing the type of the label (DATA, CODE, EXTERN, or ENTRY).
@@ -17,12 +18,12 @@
  *   - ptr_label: A pointer to the newly created label node.
  *
  * Remarks:
- *   - The function allocates memory for the label node using dynamic memory allocation (malloc).
- *   - The caller is also responsible for managing the memory of the created label node and freeing it when no longer needed.
+ *   - The function allocates memory for the label node from the arena of the table ('alloc_from_arena'), so the node is
+ *     released together with the arena and is never freed by itself.
  *   - If dynamic memory allocation fails, the function prints an error message to stderr and exits the program.
  *     Memory allocation failure may occur if there is insufficient memory available to create the label node.
  */
-static ptr_label create_node_label(const char* name, int address, type_of_label type);
+static ptr_label create_node_label(ptr_label_table table, const char* name, int address, type_of_label type);
 
 /* Function: get_type_as_text
  * --------------------------
@@ -39,49 +40,113 @@ static ptr_label create_node_label(const char* name, int address, type_of_label
  */
 static char * get_type_as_text(type_of_label type);
 
-error_code add_to_list_label(ptr_label *head, const char* name, int address, type_of_label type) {
-    /* Create a new label node using the provided name, address, and type. */
-    ptr_label new_node = create_node_label(name, address, type);
+/* Function: find_slot_label
+ * -------------------------
+ * Find the slot of a label name in the hash table of the label table.
+ *
+ * This function hashes the 'name' and probes the slots of the table (linear probing) starting from the home slot of the name,
+ * until it finds a slot holding a label with the same name or an empty slot.
+ *
+ * Parameters:
+ *   - table: A pointer to the label table. The slots array must already be allocated.
+ *   - name: A pointer to a character array (string) representing the name of the label.
+ *
+ * Returns:
+ *   - ptr_label*: A pointer to the slot holding the label with the given name, or to the empty slot where it should be stored.
+ */
+static ptr_label * find_slot_label(ptr_label_table table, const char *name);
 
-    /* If the list is initially empty, the new node becomes the head of the list. */
-    if (!(*head)){
-        *head = new_node;
-        return NO_ERROR;
+/* Function: grow_label_table
+ * --------------------------
+ * Allocate a larger slots array for the label table and rehash every label into it.
+ *
+ * Parameters:
+ *   - table: A pointer to the label table to be grown.
+ *
+ * Remarks:
+ *   - The first call allocates 'INITIAL_HASH_TABLE_SIZE' slots, every next call doubles the size of the array.
+ *   - The labels are rehashed by walking the list, so the list itself is not changed.
+ *   - If dynamic memory allocation fails, the function prints an error message to stderr and exits the program.
+ */
+static void grow_label_table(ptr_label_table table);
+
+void init_label_table(ptr_label_table table, ptr_arena arena){
+    table->head_label = NULL;
+    table->tail_label = NULL;
+    table->slots = NULL;
+    table->size_slots = 0;
+    table->count_label = 0;
+    table->count_probe = 0;
+    table->arena = arena;
+}
 
-    /* If the list is not empty, traverse the list to check for an existing node with the same name. */
-    } else {
-        ptr_label temp_node = *head;
-        while(temp_node->next != NULL && strcmp(temp_node->name_label,name) != 0){
-            temp_node = temp_node->next;
-        }
+error_code add_to_list_label(ptr_label_table table, const char* name, int address, type_of_label type) {
+    ptr_label *slot;
+
+    /* Grow the slots array if the table would become more than half full. */
+    if ((table->count_label + 1) * 2 > table->size_slots){
+        grow_label_table(table);
+    }
 
-        /* An existing node with the same name was found, update its address and type. */
-        if (strcmp(temp_node->name_label,name) == 0){
-            /* Free the memory allocated for the new node to avoid duplicates. */
-            free(new_node);
+    /* Probe the hash table for an existing node with the same name. */
+    slot = find_slot_label(table, name);
+    if (*slot != NULL){
+        /* Return an error code to indicate that the label already exists. */
+        return LABEL_ALREADY_EXISTS;
+    }
 
-            /* Return an error code to indicate that the label already exists. */
-            return LABEL_ALREADY_EXISTS;
-        } else {
+    /* Create a new label node and store it in the empty slot. */
+    *slot = create_node_label(table, name, address, type);
+    (table->count_label)++;
 
-            /* Attach the new node at the end of the list. */
-            temp_node->next = new_node;
+    /* Attach the new node at the end of the list (keeps the insertion order). */
+    if (table->tail_label == NULL){
+        table->head_label = *slot;
+    } else {
+        table->tail_label->next = *slot;
+    }
+    table->tail_label = *slot;
 
-            /* Return a success code to indicate that the label was added to the list. */
-            return NO_ERROR;
-        }
+    /* Return a success code to indicate that the label was added to the table. */
+    return NO_ERROR;
+}
+
+static ptr_label * find_slot_label(ptr_label_table table, const char *name){
+    /* The size of the slots array is a power of two, so the mask selects the home slot of the name. */
+    unsigned long mask = (unsigned long) table->size_slots - 1;
+    unsigned long index = hash_name(name) & mask;
+
+    /* Linear probing: move to the next slot until the label or an empty slot is found. */
+    (table->count_probe)++;
+    while (table->slots[index] != NULL && strcmp(table->slots[index]->name_label, name) != 0){
+        index = (index + 1) & mask;
+        (table->count_probe)++;
     }
+    return &table->slots[index];
 }
 
-static ptr_label create_node_label(const char* name, int address, type_of_label type) {
-    /* Dynamically allocate memory for the new label node. */
-    ptr_label new_node = (ptr_label)malloc(sizeof(item_label));
+static void grow_label_table(ptr_label_table table){
+    ptr_label temp_node;
+    int new_size = (table->size_slots == 0) ? INITIAL_HASH_TABLE_SIZE : table->size_slots * 2;
 
-    /* Check if memory allocation was successful. */
-    if (new_node == NULL){
+    /* Allocate the new (empty) slots array and release the old one. */
+    free(table->slots);
+    table->slots = (ptr_label *)calloc((size_t) new_size, sizeof(ptr_label));
+    if (table->slots == NULL){
         fprintf(stderr, "Error in dynamic memory allocation");
         exit(EXIT_FAILURE);
     }
+    table->size_slots = new_size;
+
+    /* Rehash every label of the list into the new slots array. */
+    for (temp_node = table->head_label; temp_node != NULL; temp_node = temp_node->next){
+        *find_slot_label(table, temp_node->name_label) = temp_node;
+    }
+}
+
+static ptr_label create_node_label(ptr_label_table table, const char* name, int address, type_of_label type) {
+    /* Allocate memory for the new label node from the arena of the table. */
+    ptr_label new_node = (ptr_label)alloc_from_arena(table->arena, sizeof(item_label));
 
     /* Copy the provided 'name' string to the 'name_label' field of the label node. */
     strcpy(new_node->name_label, name);
@@ -97,9 +162,9 @@ static ptr_label create_node_label(const char* name, int address, type_of_label
     return new_node;
 }
 
-void update_address_of_data(ptr_label head_label, int ic){
+void update_address_of_data(ptr_label_table table, int ic){
     /* Create a temporary pointer to traverse the label list, starting from the head. */
-    ptr_label temp_head = head_label;
+    ptr_label temp_head = table->head_label;
 
     /* Iterate through the label list until the end is reached (temp_head becomes NULL). */
     while (temp_head){
@@ -113,119 +178,61 @@ void update_address_of_data(ptr_label head_label, int ic){
     }
 }
 
-ptr_label search_in_list_label(ptr_label head_label, const char *name_label){
-    /* Create a temporary pointer to traverse the label list, starting from the head. */
-    ptr_label temp_head = head_label;
-
-    /* Iterate through the label list until the end is reached (temp_head becomes NULL). */
-    while(temp_head){
-        /* Compare the 'name_label' parameter with the 'name_label' field of the current label node. */
-        if (strcmp(name_label,temp_head->name_label) == 0){
-            /* If a matching label is found, return a pointer to that label node. */
-            return temp_head;
-        }
-        /* Move to the next label node in the list. */
-        temp_head = temp_head->next;
+ptr_label search_in_list_label(ptr_label_table table, const char *name_label){
+    /* An empty table has no slots array yet. */
+    if (table->size_slots == 0){
+        return NULL;
     }
-    /* If no matching label is found in the list, return NULL. */
-    return NULL;
+
+    /* Return the label stored in the slot of the name (NULL if the probe ended in an empty slot). */
+    return *find_slot_label(table, name_label);
 }
 
-error_code mark_label_as_entry(ptr_label head_label, const char *name_label){
-    /* Create a temporary pointer to traverse the label list, starting from the head. */
-    ptr_label temp_head = head_label;
+error_code mark_label_as_entry(ptr_label_table table, const char *name_label){
+    ptr_label label_node = search_in_list_label(table, name_label);
 
-    /* Iterate through the label list until the end is reached (temp_head becomes NULL). */
-    while(temp_head){
-        /* Compare the 'name_label' parameter with the 'name_label' field of the current label node. */
-        if (strcmp(name_label,temp_head->name_label) == 0){
-            /* If a matching label is found, mark it as an ENTRY type and return NO_ERROR. */
-            temp_head->type = ENTRY;
-            return NO_ERROR;
-        }
-        /* Move to the next label node in the list. */
-        temp_head = temp_head->next;
+    /* If a matching label is found, mark it as an ENTRY type and return NO_ERROR. */
+    if (label_node != NULL){
+        label_node->type = ENTRY;
+        return NO_ERROR;
     }
-    /* If no matching label is found in the list, return CANT_FIND_LABEL_TO_ENTRY. */
+    /* If no matching label is found in the table, return CANT_FIND_LABEL_TO_ENTRY. */
     return CANT_FIND_LABEL_TO_ENTRY;
 }
 
-char *get_entry_list(ptr_label head_label) {
-    char *entry_list;
-    /* Create a buffer to hold the address converted to a string. */
-    char int_address[MAX_DIGITS_FOR_ADDRESS];
-
-    /* Initialize the size of the entry list to 0. */
-    size_t entry_list_size = 0;
-
+void add_entry_list_to_buffer(ptr_label_table table, ptr_buffer buffer) {
     /* Create a temporary pointer to traverse the label list, starting from the head. */
-    ptr_label temp_node = head_label;
+    ptr_label temp_node = table->head_label;
 
-    /* Calculate the required memory size to store the entry list. */
+    /* Append a line with the name and the address of every label marked as ENTRY, in insertion order. */
     while (temp_node) {
-        /* Check if the label node's type is ENTRY. */
         if (temp_node->type == ENTRY) {
-            /* Calculate the size needed for the label name, address, and formatting characters. */
-            entry_list_size += strlen(temp_node->name_label) + MAX_DIGITS_FOR_ADDRESS + 3;
+            append_address_line_to_buffer(buffer, temp_node->name_label, temp_node->address_label);
         }
         /* Move to the next label node in the list. */
         temp_node = temp_node->next;
     }
+}
 
-    /* Allocate memory for the entry list string based on the calculated size. */
-    entry_list = (char *)malloc(entry_list_size + 1);
-    if (entry_list == NULL){
-        fprintf(stderr, "Error in dynamic memory allocation");
-        exit(EXIT_FAILURE);
-    }
-
-    /* Initialize the entry list string as an empty string. */
-    entry_list[0] = '\0';
-
-    /* Reset the temporary pointer to the head of the label list for traversal. */
-    temp_node = head_label;
-
-    /* Build the formatted entry list string by appending label names and addresses. */
-    while (temp_node) {
-        /* Check if the label node's type is ENTRY. */
-        if (temp_node->type == ENTRY) {
-            /* Convert the address to a string representation. */
-            sprintf(int_address, "%d", temp_node->address_label);
-
-            /* Concatenate the label name, tab character, address, and newline characters to the entry list string. */
-            strcat(entry_list, temp_node->name_label);
-            strcat(entry_list, "\t");
-            strcat(entry_list, int_address);
-            strcat(entry_list, "\n");
-        }
-        /* Move to the next label node in the list. */
-        temp_node = temp_node->next;
+void clear_list_label(ptr_label_table table){
+    /* Empty every slot, the size of the slots array is kept. */
+    if (table->slots != NULL){
+        memset(table->slots, 0, sizeof(ptr_label) * (size_t) table->size_slots);
     }
-    /* Return the generated entry list string. */
-    return entry_list;
+    table->head_label = NULL;
+    table->tail_label = NULL;
+    table->count_label = 0;
+    table->count_probe = 0;
 }
 
-void free_list_label(ptr_label *head){
-    /* Create a temporary pointer to traverse the label list. */
-    ptr_label temp_head;
-
-    /* Iterate through the label list and free the memory for each label node. */
-    while (*head){
-        /* Store the next node's address in 'temp_head'. */
-        temp_head = *head;
-
-        /* Move 'head' to the next node in the list. */
-        *head = (*head)->next;
-
-        /* Free the memory allocated for the current label node. */
-        free(temp_head);
-    }
-    /* Set the 'head' pointer to NULL, indicating an empty label list. */
-    *head = NULL;
+void free_list_label(ptr_label_table table){
+    /* The label nodes belong to the arena, so only the slots array is freed before the table is reset to an empty table. */
+    free(table->slots);
+    init_label_table(table, table->arena);
 }
 
-__attribute__((unused)) void print_list_label(ptr_label head){
-    ptr_label temp_head = head;
+__attribute__((unused)) void print_list_label(ptr_label_table table){
+    ptr_label temp_head = table->head_label;
     while(temp_head){
         printf("Name: %s\tAddress: %d\tType: %s\n",temp_head->name_label, temp_head->address_label,get_type_as_text(temp_head->type));
         temp_head = temp_head->next;
@@ -1,18 +1,21 @@
 /*
  * Header: label_list.h
  * --------------------
- * This is the header file for managing a linked list of labels in an assembly code.
+ * This is the header file for managing the table of labels (symbol table) in an assembly code.
  *
- * The "label_list.h" header file provides function prototypes and data structures to manage a linked list of labels. Labels are
+ * The "label_list.h" header file provides function prototypes and data structures to manage the labels of a file. Labels are
  * essential components of assembly code, representing specific memory addresses or symbols within the program. The header file defines
  * the 'type_of_label' enumeration, which categorizes the types of labels (DATA, CODE, EXTERN, or ENTRY). It also defines the 'item_label'
- * structure, representing a single label node in the linked list, and the 'ptr_label' type, which is a pointer to a label node.
+ * structure, representing a single label node, and the 'item_label_table' structure, which keeps the labels in a linked list (in
+ * insertion order) and indexes them with an open-addressing hash table, so a lookup or an insert does not walk the whole list.
  *
  * Included Files:
  *   - stdlib.h: Standard Library. It provides functions for memory allocation, conversion, and other utility functions.
  *   - stdio.h: Standard Input/Output library. It provides functions for input and output operations, such as file handling.
  *   - string.h: C String Library. It provides functions for manipulating strings, such as string copying and comparison.
  *   - error_tool.h: Contains functions for error handling and printing error messages during the pre-assembly process.
+ *   - arena_tool.h: Contains the arena allocator from which the label nodes are allocated.
+ *   - buffer_tool.h: Contains the growable text buffer that receives the list of entry labels.
  *   - setting.h: Contains constant definitions and configurations used in the pre-assembly process.
  */
 
@@ -23,6 +26,8 @@
 #include <stdio.h>
 #include <string.h>
 #include "error_tool.h"
+#include "arena_tool.h"
+#include "buffer_tool.h"
 #include "setting.h"
 
 /*
@@ -68,19 +73,60 @@ typedef struct node_label {
     ptr_label next;
 } item_label;
 
+/*
+ * Struct: item_label_table
+ * ------------------------
+ * A structure representing the table of labels of a file (the symbol table).
+ *
+ * The labels are kept in a linked list in the order in which they were added, so the entry list and the debug print keep their
+ * original order. In addition, every label is indexed by its name in an open-addressing hash table with linear probing. The slots
+ * array is allocated on the first insert and doubled whenever it becomes half full.
+ *
+ * Fields:
+ *   - head_label: A pointer to the first label node in the table (in insertion order).
+ *   - tail_label: A pointer to the last label node in the table, used to append a new node without walking the list.
+ *   - slots: An array of 'size_slots' pointers to label nodes. An empty slot holds NULL.
+ *   - size_slots: The number of slots in the 'slots' array (always a power of two, or zero before the first insert).
+ *   - count_label: The number of labels stored in the table.
+ *   - count_probe: The number of slots visited by the lookups of the table (for the statistics).
+ *   - arena: The arena from which the label nodes are allocated (the arena of the file).
+ */
+typedef struct label_table * ptr_label_table;
+typedef struct label_table {
+    ptr_label head_label;
+    ptr_label tail_label;
+    ptr_label *slots;
+    int size_slots;
+    int count_label;
+    long count_probe;
+    ptr_arena arena;
+} item_label_table;
+
+/*
+ * Function: init_label_table
+ * --------------------------
+ * Initializes an empty label table.
+ *
+ * Parameters:
+ *   - table: A pointer to the label table to be initialized.
+ *   - arena: The arena from which the label nodes are allocated.
+ *
+ * Notes:
+ *   - No memory is allocated here; the slots array is allocated when the first label is added to the table.
+ */
+void init_label_table(ptr_label_table table, ptr_arena arena);
+
 /*
  * Function: add_to_list_label
  * ---------------------------
- * Adds a new label node to the label list.
+ * Adds a new label node to the label table.
  *
- * This function adds a new label node with the specified 'name', 'address', and 'type' to the label list. The label list is
- * represented by a linked list of 'ptr_label' nodes, where each node contains information about a label, including its name,
- * address, and type (DATA, CODE, EXTERN, or ENTRY). If a node with the same 'name' already exists in the list, the function
- * does nothing and returns an error.
+ * This function adds a new label node with the specified 'name', 'address', and 'type' to the label table. Each node contains
+ * information about a label, including its name, address, and type (DATA, CODE, EXTERN, or ENTRY). If a node with the same 'name'
+ * already exists in the table, the function does nothing and returns an error.
  *
  * Parameters:
- *   - head: A pointer to the pointer of the head node of the label list. The function uses a double pointer to modify the
- *           'head' pointer itself when adding the first node to an empty list.
+ *   - table: A pointer to the label table.
  *   - name: A string representing the name of the label to be added or updated.
  *   - address: The integer value representing the address associated with the label.
  *   - type: The type_of_label enum value representing the type of the label (DATA, CODE, EXTERN, or ENTRY).
@@ -91,147 +137,134 @@ typedef struct node_label {
  *     - LABEL_ALREADY_EXISTS: A node with the same 'name' already exists in the list, and the list was not modified.
  *
  * Notes:
- *   - The function first calls 'create_node_label' to create a new label node with the specified 'name', 'address', and 'type'.
- *   - If the 'head' pointer is initially NULL (empty list), the new node becomes the head of the list.
- *   - If the list is not empty, the function traverses the list to check if a node with the same 'name' already exists.
- *   - If a matching node is found, the function frees the memory allocated for the new node to avoid duplicates and returns
- *     the 'LABEL_ALREADY_EXISTS' error code.
- *   - If no matching node is found, the new node is attached at the end of the list.
+ *   - The function probes the hash table for the 'name'. If a matching node is found, the table is not modified and the
+ *     'LABEL_ALREADY_EXISTS' error code is returned.
+ *   - Otherwise, the function calls 'create_node_label' to create a new label node, stores it in the empty slot that ended the
+ *     probe and attaches it at the end of the list.
+ *   - The slots array is grown before the insert if the table would become more than half full.
  */
-error_code add_to_list_label(ptr_label *head, const char* name, int address, type_of_label type);
+error_code add_to_list_label(ptr_label_table table, const char* name, int address, type_of_label type);
 
 /* Function: update_address_of_data
  * --------------------------------
- * Updates the addresses of data labels in the label list by adding a given offset.
+ * Updates the addresses of data labels in the label table by adding a given offset.
  *
- * This function is used to update the memory addresses of data labels in the label list. It iterates through the label list
- * starting from the 'head_label' and checks the 'type' field of each label node. If the label is of type DATA, the function adds
+ * This function is used to update the memory addresses of data labels in the label table. It iterates through the label list
+ * of the table and checks the 'type' field of each label node. If the label is of type DATA, the function adds
  * the provided 'ic' (instruction counter) value to its current address. This is typically done after the first pass of an assembly
  * process, where the addresses of data labels are determined based on the location counter (IC) at that point in the assembly code.
  *
  * Parameters:
- *   - head_label: A pointer to the head of the label list. The 'head_label' should point to the first node of the label list, and
- *                 the function iterates through the list from this starting point.
+ *   - table: A pointer to the label table.
  *   - ic: An integer value representing the instruction counter. The 'ic' value is used to update the addresses of data labels in
  *         the label list.
  */
-void update_address_of_data(ptr_label head_label, int ic);
+void update_address_of_data(ptr_label_table table, int ic);
 
 /* Function: search_in_list_label
  * ------------------------------
- * Search for a label node in the label list based on its name.
+ * Search for a label node in the label table based on its name.
  *
  * Parameters:
- *   - head_label: A pointer to the head of the label list. The 'head_label' should point to the first node of the label list, and
- *                 the function iterates through the list from this starting point.
+ *   - table: A pointer to the label table.
  *   - name_label: A pointer to a constant character string representing the name of the label to search for. The 'name_label'
- *                 parameter specifies the label's name to be found in the list.
+ *                 parameter specifies the label's name to be found in the table.
  *
  * Returns:
- *   - If a matching label node is found in the label list, a pointer to that label node is returned.
- *   - If no matching label is found in the list, the function returns NULL.
+ *   - If a matching label node is found in the label table, a pointer to that label node is returned.
+ *   - If no matching label is found in the table, the function returns NULL.
  *
  * Notes:
- *   - If a label with a matching name is found, a pointer to that label node is returned immediately, and the function exits.
- *   - If no matching label is found after iterating through the entire list, the function returns NULL to indicate that the label
- *     was not found in the list.
+ *   - The lookup hashes the 'name_label' and probes the slots from its home slot until the label or an empty slot is found,
+ *     so it does not depend on the number of labels in the table.
  *   - This function is useful for searching for a specific label in the list, for example, during the second pass of an assembly
  *     process, where references to labels need to be resolved to their memory addresses.
  */
-ptr_label search_in_list_label(ptr_label head_label, const char *name_label);
+ptr_label search_in_list_label(ptr_label_table table, const char *name_label);
 
 /* Function: mark_label_as_entry
  * -----------------------------
- * Mark a label node as an ENTRY type in the label list.
+ * Mark a label node as an ENTRY type in the label table.
  *
  * Parameters:
- *   - head_label: A pointer to the head of the label list. The 'head_label' should point to the first node of the label list, and
- *                 the function iterates through the list from this starting point.
+ *   - table: A pointer to the label table.
  *   - name_label: A pointer to a constant character string representing the name of the label to mark as ENTRY. The 'name_label'
  *                 parameter specifies the label's name to be marked as an ENTRY type.
  *
  * Returns:
- *   - If a matching label node is found in the label list, its 'type' field is updated to ENTRY, and the function returns 'NO_ERROR'.
- *   - If no matching label is found in the list, the function returns 'CANT_FIND_LABEL_TO_ENTRY' to indicate that the specified label
+ *   - If a matching label node is found in the label table, its 'type' field is updated to ENTRY, and the function returns 'NO_ERROR'.
+ *   - If no matching label is found in the table, the function returns 'CANT_FIND_LABEL_TO_ENTRY' to indicate that the specified label
  *     was not found and, therefore, could not be marked as an ENTRY type.
  *
  * Notes:
- *   - For each label node in the list, the function compares the 'name_label' parameter with the 'name_label' field of the current
- *     label node using the 'strcmp' function from the C standard library.
- *   - If a label with a matching name is found, its 'type' field is updated to ENTRY, indicating that it is now an ENTRY type label.
- *   - If no matching label is found after iterating through the entire list, the function returns 'CANT_FIND_LABEL_TO_ENTRY' to
- *     indicate that the specified label was not found and, therefore, could not be marked as an ENTRY type.
+ *   - The label is found with 'search_in_list_label'.
  */
-error_code mark_label_as_entry(ptr_label head_label, const char *name_label);
+error_code mark_label_as_entry(ptr_label_table table, const char *name_label);
 
-/* Function: get_entry_list
- * ------------------------
- * Generate a list of ENTRY type labels and their corresponding addresses.
+/* Function: add_entry_list_to_buffer
+ * ----------------------------------
+ * Appends the list of ENTRY type labels and their corresponding addresses to a text buffer.
  *
- * This function traverses the label list starting from the 'head_label' and generates a formatted string containing the names
- * and addresses of all the labels marked as ENTRY type in the list. The function calculates the required memory size to store the
- * list and allocates memory dynamically to hold the generated string. The generated string is formatted as follows:
+ * This function traverses the label list of the table in insertion order and appends a line for every label marked as
+ * ENTRY type, formatted as follows:
  *
  *   "<label_name_1>\t<address_1>\n"
  *   "<label_name_2>\t<address_2>\n"
  *   ...
  *
- * Each line represents an ENTRY type label and its associated address separated by a tab character. The '\n' character is used to
- * separate each label-entry pair and create a newline in the final string. The memory allocated for the string should be freed by
- * the caller when it is no longer needed.
- *
  * Parameters:
- *   - head_label: A pointer to the head of the label list. The 'head_label' should point to the first node of the label list, and
- *                 the function iterates through the list from this starting point.
+ *   - table: A pointer to the label table.
+ *   - buffer: A pointer to the text buffer that receives the lines (the text of the '.ent' file).
  *
- * Returns:
- *   - If there are ENTRY type labels in the label list, this function returns a dynamically allocated character string containing
- *     the list of ENTRY labels and their corresponding addresses in the specified format. The caller is responsible for freeing
- *     the allocated memory when it is no longer needed.
- *   - If there are no ENTRY type labels in the label list or the label list is empty, the function returns NULL.
+ * Notes:
+ *   - Every line is written at the end of the buffer with 'append_address_line_to_buffer', so the list is built in a
+ *     single walk of the labels, in time linear in its length.
+ *   - If there are no ENTRY type labels, nothing is appended.
+ */
+void add_entry_list_to_buffer(ptr_label_table table, ptr_buffer buffer);
+
+/* Function: clear_list_label
+ * --------------------------
+ * Removes every label of the label table, keeping its slots array for the next labels.
+ *
+ * Parameters:
+ *   - table: A pointer to the label table to be cleared.
  *
  * Notes:
- *   - The function iterates through the label list, starting from the 'head_label', to calculate the required memory size for the
- *     generated list.
- *   - For each label node in the list, the function checks if the 'type' field is set to ENTRY. If so, it calculates the size needed
- *     to store the label name, address, and formatting characters.
- *   - After allocating memory, the function iterates through the label list again, starting from the 'head_label', to build the
- *     formatted string by appending each ENTRY label's name and address to the string.
+ *   - The label nodes belong to the arena of the table, so the arena must be reset (or released) with the table.
  */
-char * get_entry_list(ptr_label head);
+void clear_list_label(ptr_label_table table);
 
 /* Function: free_list_label
  * -------------------------
- * Free the memory occupied by the label list.
+ * Free the memory occupied by the label table.
  *
  * Parameters:
- *   - head: A pointer to the head of the label list. The 'head' should point to the first node of the label list to begin freeing
- *           the memory.
+ *   - table: A pointer to the label table to be freed.
  *
  * Notes:
- *   - This function is designed to work with a linked list of labels, where each label node is of type 'item_label' (ptr_label).
- *   - The function assumes that the 'head' pointer points to a valid label list. If 'head' is NULL or points to an empty list, the
- *     function has no effect.
+ *   - The function frees the slots array and leaves the table empty (as after 'init_label_table'), so it can be used
+ *     again. The label nodes belong to the arena of the table, so they are released with the arena.
  */
-void free_list_label(ptr_label *head);
+void free_list_label(ptr_label_table table);
 
 /* Function: print_list_label
  * --------------------------
  * (For Debugging) Print the list of labels with their details.
  *
- * This function prints the details of the labels in the linked list, starting from the specified head node. The details include the
+ * This function prints the details of the labels in the table, in insertion order. The details include the
  * name, address, and type of each label in the list. The label type is represented as a textual string using the 'get_type_as_text'
  * function.
  *
  * Parameters:
- *   - head: The head node of the linked list containing the labels.
+ *   - table: A pointer to the label table containing the labels.
  *
  * Remarks:
  *   - The function is marked with the '__attribute__((unused))' attribute, which tells the compiler not to produce a warning if the
  *     function is unused (not called) in the code.
  *   - The 'print_list_label' function is intended for debugging or informational purposes when you want to see the details of the
- *     labels in the linked list. It does not return any values; it only prints the information to the standard output (console).
+ *     labels in the table. It does not return any values; it only prints the information to the standard output (console).
  */
-__attribute__((unused)) void print_list_label(ptr_label head);
+__attribute__((unused)) void print_list_label(ptr_label_table table);
 
 #endif /* LABEL_LIST_H */
\ No newline at end of file
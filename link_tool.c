@@ -0,0 +1,401 @@
+#include "link_tool.h"
+
+/*
+ * Function: read_file_of_module
+ * -----------------------------
+ * Reads a whole file of a module into a buffer.
+ *
+ * Parameters:
+ *   - module: A pointer to the module.
+ *   - ext: The extension of the file.
+ *   - buffer: A pointer to the (empty) buffer that receives the text of the file.
+ *
+ * Returns:
+ *   - bool: TRUE if the file was read, FALSE if it cannot be opened.
+ */
+static bool read_file_of_module(ptr_link_module module, file_ext ext, ptr_buffer buffer);
+
+/*
+ * Function: read_header_of_module
+ * -------------------------------
+ * Reads the header of the object file of a module (the number of its code words and of its data words).
+ *
+ * Parameters:
+ *   - module: A pointer to the module, whose 'count_instructions' and 'count_data' receive the header.
+ *
+ * Returns:
+ *   - bool: TRUE if the header was read, FALSE if the object file is missing or damaged.
+ */
+static bool read_header_of_module(ptr_link_module module);
+
+/*
+ * Function: parse_address_line
+ * ----------------------------
+ * Reads a line of an '.ent' or an '.ext' file: a label name, a tab and an address.
+ *
+ * Parameters:
+ *   - line: A pointer to the first character of the line (not null-terminated).
+ *   - length: The number of characters of the line.
+ *   - name: A buffer of 'MAX_NAME_LABEL_LENGTH' characters that receives the name.
+ *   - address: A pointer that receives the address.
+ *
+ * Returns:
+ *   - bool: TRUE if the line is valid, FALSE otherwise.
+ */
+static bool parse_address_line(const char *line, size_t length, char *name, int *address);
+
+/*
+ * Function: relocate_address
+ * --------------------------
+ * Moves an address of a module to its place in the image.
+ *
+ * Parameters:
+ *   - module: A pointer to the module.
+ *   - address: An address of the module (of its code, or of its data that follows its code).
+ *
+ * Returns:
+ *   - int: The address in the image.
+ */
+static int relocate_address(ptr_link_module module, int address);
+
+/*
+ * Function: add_entries_of_module
+ * -------------------------------
+ * Adds the entry labels of a module, at their addresses in the image, to the table of the entry labels of the link.
+ *
+ * Parameters:
+ *   - module: A pointer to the module.
+ *   - table: A pointer to the table of the entry labels.
+ *   - file_log: The stream that receives the messages of the link.
+ *
+ * Returns:
+ *   - int: The number of errors found.
+ */
+static int add_entries_of_module(ptr_link_module module, ptr_label_table table, FILE *file_log);
+
+/*
+ * Function: add_words_of_module
+ * -----------------------------
+ * Copies the words of a module to their places in the image: its code words, relocated and with their external
+ * references completed, and its data words.
+ *
+ * Parameters:
+ *   - module: A pointer to the module.
+ *   - table: A pointer to the table of the entry labels of the link.
+ *   - image: A pointer to the words of the image (the word of every address, from 'FIRST_CELL_IN_MEMORY').
+ *   - file_log: The stream that receives the messages of the link.
+ *
+ * Returns:
+ *   - int: The number of errors found.
+ */
+static int add_words_of_module(ptr_link_module module, ptr_label_table table, ptr_word_array image, FILE *file_log);
+
+/*
+ * Function: write_image
+ * ---------------------
+ * Writes the image of the link to the object file and its entry labels to the entry file.
+ *
+ * Parameters:
+ *   - name_output: The name of the output files (without extension).
+ *   - table: A pointer to the table of the entry labels of the link.
+ *   - image: A pointer to the words of the image.
+ *   - count_instructions: The number of code words of the image.
+ *   - count_data: The number of data words of the image.
+ */
+static void write_image(char *name_output, ptr_label_table table, ptr_word_array image, int count_instructions,
+                        int count_data);
+
+void init_link_module(ptr_link_module module, char *name_file){
+    module->name_file = name_file;
+    module->object_flag = FALSE;
+    module->entry_flag = FALSE;
+    module->extern_flag = FALSE;
+    module->count_instructions = 0;
+    module->count_data = 0;
+    module->code_base = FIRST_CELL_IN_MEMORY;
+    module->data_base = FIRST_CELL_IN_MEMORY;
+}
+
+bool link_modules(ptr_link_module modules, int count_modules, char *name_output, FILE *file_log){
+    item_arena arena;
+    item_label_table table;
+    item_word_array image;
+    int count_instructions = 0;
+    int count_data = 0;
+    int count_errors = 0;
+    int i;
+
+    fputs("\n", file_log);
+    fputs("--------------------------------------------------------------------------------\n", file_log);
+    fprintf(file_log, "Link: %s:\n\n", name_output);
+
+    /* Place the code of every module after the code of the modules before it */
+    for (i = 0; i < count_modules; i++){
+        if (modules[i].object_flag == FALSE){
+            print_red();
+            fprintf(file_log, "ERROR- The module %s was not assembled successfully, it cannot be linked.\n",
+                    modules[i].name_file);
+            print_reset();
+            count_errors++;
+        } else if (read_header_of_module(&modules[i]) == FALSE){
+            print_red();
+            fprintf(file_log, "ERROR- The object file of the module %s is damaged.\n", modules[i].name_file);
+            print_reset();
+            count_errors++;
+        } else {
+            modules[i].code_base = FIRST_CELL_IN_MEMORY + count_instructions;
+            count_instructions += modules[i].count_instructions;
+            count_data += modules[i].count_data;
+        }
+    }
+
+    /* The data of every module follows the code of all the modules, and the whole image must fit in the memory */
+    if (count_errors == 0 && FIRST_CELL_IN_MEMORY + count_instructions + count_data > MEMORY_SIZE){
+        print_red();
+        fprintf(file_log, "ERROR- The linked image needs %d words, more than the %d words of the memory.\n",
+                count_instructions + count_data, MEMORY_SIZE - FIRST_CELL_IN_MEMORY);
+        print_reset();
+        count_errors++;
+    }
+
+    init_arena(&arena);
+    init_label_table(&table, &arena);
+    init_word_array(&image);
+    if (count_errors == 0){
+        count_data = 0;
+        for (i = 0; i < count_modules; i++){
+            modules[i].data_base = FIRST_CELL_IN_MEMORY + count_instructions + count_data;
+            count_data += modules[i].count_data;
+        }
+
+        /* Merge the entry labels of all the modules, then copy the words of every module to the image */
+        for (i = 0; i < count_modules; i++){
+            count_errors += add_entries_of_module(&modules[i], &table, file_log);
+        }
+        for (i = 0; i < count_modules; i++){
+            count_errors += add_words_of_module(&modules[i], &table, &image, file_log);
+        }
+    }
+
+    if (count_errors == 0){
+        write_image(name_output, &table, &image, count_instructions, count_data);
+        fprintf(file_log, "\nLink completed successfully.\n");
+        fprintf(file_log, "Modules linked: %d, words: %d.\n", count_modules, count_instructions + count_data);
+    } else {
+        fprintf(file_log, "\nNumber of link errors: %d.\n", count_errors);
+        fprintf(file_log, "Link not completed.\n");
+    }
+
+    free_word_array(&image);
+    free_list_label(&table);
+    free_arena(&arena);
+    return (count_errors == 0) ? TRUE : FALSE;
+}
+
+static bool read_file_of_module(ptr_link_module module, file_ext ext, ptr_buffer buffer){
+    char full_name[MAX_FULL_FILE_NAME_LENGTH];
+    FILE *file = fopen(get_file_with_extension(module->name_file, ext, full_name), "r");
+
+    if (file == NULL){
+        return FALSE;
+    }
+    read_file_to_buffer(buffer, file);
+    fclose(file);
+    return TRUE;
+}
+
+static bool read_header_of_module(ptr_link_module module){
+    char full_name[MAX_FULL_FILE_NAME_LENGTH];
+    char line[MAX_ASSEMBLY_LINE_LENGTH];
+    FILE *file = fopen(get_file_with_extension(module->name_file, EXT_OBJECT, full_name), "r");
+    bool result;
+
+    if (file == NULL){
+        return FALSE;
+    }
+
+    /* Only the first line is read here, the words are read when the module is copied to the image */
+    result = (fgets(line, sizeof(line), file) != NULL &&
+              sscanf(line, "%d\t%d", &module->count_instructions, &module->count_data) == 2 &&
+              module->count_instructions >= 0 && module->count_data >= 0) ? TRUE : FALSE;
+    fclose(file);
+    return result;
+}
+
+static bool parse_address_line(const char *line, size_t length, char *name, int *address){
+    const char *tab = (const char *) memchr(line, '\t', length);
+    char text_address[MAX_DIGITS_FOR_NUMBER];
+    size_t length_address;
+
+    if (tab == NULL || tab == line || (size_t) (tab - line) >= MAX_NAME_LABEL_LENGTH){
+        return FALSE;
+    }
+    memcpy(name, line, (size_t) (tab - line));
+    name[tab - line] = '\0';
+
+    /* The address, up to the end of the line */
+    length_address = length - (size_t) (tab - line) - 1;
+    if (length_address > 0 && tab[length_address] == '\n'){
+        length_address--;
+    }
+    if (length_address == 0 || length_address >= MAX_DIGITS_FOR_NUMBER){
+        return FALSE;
+    }
+    memcpy(text_address, tab + 1, length_address);
+    text_address[length_address] = '\0';
+    return (sscanf(text_address, "%d", address) == 1) ? TRUE : FALSE;
+}
+
+static int relocate_address(ptr_link_module module, int address){
+    if (address < FIRST_CELL_IN_MEMORY + module->count_instructions){
+        return module->code_base + (address - FIRST_CELL_IN_MEMORY);
+    }
+    return module->data_base + (address - FIRST_CELL_IN_MEMORY - module->count_instructions);
+}
+
+static int add_entries_of_module(ptr_link_module module, ptr_label_table table, FILE *file_log){
+    item_buffer text_ent;
+    const char *line;
+    size_t position = 0;
+    size_t length;
+    char name[MAX_NAME_LABEL_LENGTH];
+    int address;
+    int count_errors = 0;
+
+    if (module->entry_flag == FALSE){
+        return 0;
+    }
+    init_buffer(&text_ent);
+    if (read_file_of_module(module, EXT_ENTRY, &text_ent) == FALSE){
+        print_red();
+        fprintf(file_log, "ERROR- The entry file of the module %s is missing.\n", module->name_file);
+        print_reset();
+        free_buffer(&text_ent);
+        return 1;
+    }
+
+    while ((line = get_line_view_of_buffer(&text_ent, &position, MAX_ASSEMBLY_LINE_LENGTH, &length)) != NULL){
+        if (parse_address_line(line, length, name, &address) == FALSE){
+            print_red();
+            fprintf(file_log, "ERROR- The entry file of the module %s is damaged.\n", module->name_file);
+            print_reset();
+            count_errors++;
+            break;
+        }
+        if (add_to_list_label(table, name, relocate_address(module, address), ENTRY) == LABEL_ALREADY_EXISTS){
+            print_red();
+            fprintf(file_log, "ERROR- The label %s of the module %s is already an entry of another module.\n", name,
+                    module->name_file);
+            print_reset();
+            count_errors++;
+        }
+    }
+    free_buffer(&text_ent);
+    return count_errors;
+}
+
+static int add_words_of_module(ptr_link_module module, ptr_label_table table, ptr_word_array image, FILE *file_log){
+    item_buffer text_module;
+    const char *line;
+    size_t position = 0;
+    size_t length;
+    char name[MAX_NAME_LABEL_LENGTH];
+    unsigned int *word;
+    ptr_label label_node;
+    int address;
+    int value;
+    int count_errors = 0;
+    int i;
+
+    /* The words of the object file, one word (two base64 characters) on every line after the header */
+    init_buffer(&text_module);
+    if (read_file_of_module(module, EXT_OBJECT, &text_module) == FALSE ||
+        get_line_view_of_buffer(&text_module, &position, MAX_ASSEMBLY_LINE_LENGTH, &length) == NULL){
+        count_errors++;
+    }
+    for (i = 0; count_errors == 0 && i < module->count_instructions + module->count_data; i++){
+        line = get_line_view_of_buffer(&text_module, &position, MAX_ASSEMBLY_LINE_LENGTH, &length);
+        if (line == NULL || length < 2 || (value = decode_64base_to_word(line)) == -1){
+            count_errors++;
+        } else if (i < module->count_instructions){
+            /* A relocatable word holds an address of the module, which is moved with the module */
+            if (ENCODING_OF_WORD(value) == RELOCATABLE){
+                value = (int) ENCODE_VALUE_WORD(relocate_address(module, (int) VALUE_OF_WORD(value)), RELOCATABLE);
+            }
+            *get_word_of_array(image, module->code_base - FIRST_CELL_IN_MEMORY + i) = (unsigned int) value;
+        } else {
+            *get_word_of_array(image, module->data_base - FIRST_CELL_IN_MEMORY + (i - module->count_instructions)) =
+                    (unsigned int) value;
+        }
+    }
+    if (count_errors != 0){
+        print_red();
+        fprintf(file_log, "ERROR- The object file of the module %s is damaged.\n", module->name_file);
+        print_reset();
+        free_buffer(&text_module);
+        return count_errors;
+    }
+
+    /* Complete every word that refers to an external label with the address of its entry */
+    if (module->extern_flag == TRUE){
+        truncate_buffer(&text_module, 0);
+        position = 0;
+        if (read_file_of_module(module, EXT_EXTERN, &text_module) == FALSE){
+            print_red();
+            fprintf(file_log, "ERROR- The external file of the module %s is missing.\n", module->name_file);
+            print_reset();
+            free_buffer(&text_module);
+            return 1;
+        }
+        while ((line = get_line_view_of_buffer(&text_module, &position, MAX_ASSEMBLY_LINE_LENGTH, &length)) != NULL){
+            if (parse_address_line(line, length, name, &address) == FALSE || address < FIRST_CELL_IN_MEMORY ||
+                address >= FIRST_CELL_IN_MEMORY + module->count_instructions){
+                print_red();
+                fprintf(file_log, "ERROR- The external file of the module %s is damaged.\n", module->name_file);
+                print_reset();
+                count_errors++;
+                break;
+            }
+            label_node = search_in_list_label(table, name);
+            if (label_node == NULL){
+                print_red();
+                fprintf(file_log, "ERROR- The external label %s of the module %s (used at address %d) is not an entry of any module.\n",
+                        name, module->name_file, address);
+                print_reset();
+                count_errors++;
+            } else {
+                word = get_word_of_array(image, relocate_address(module, address) - FIRST_CELL_IN_MEMORY);
+                *word = ENCODE_VALUE_WORD(label_node->address_label, RELOCATABLE);
+            }
+        }
+    }
+    free_buffer(&text_module);
+    return count_errors;
+}
+
+static void write_image(char *name_output, ptr_label_table table, ptr_word_array image, int count_instructions,
+                        int count_data){
+    item_buffer entry_list;
+    char *text_ob;
+    size_t length;
+
+    /* The object file of the image, in the format of the object file of a module */
+    text_ob = (char *) malloc(OBJECT_HEADER_LENGTH + (size_t) (count_instructions + count_data) * BASE64_WORD_LENGTH);
+    if (text_ob == NULL){
+        fprintf(stderr, "Error in dynamic memory allocation");
+        exit(EXIT_FAILURE);
+    }
+    length = (size_t) sprintf(text_ob, "%d\t%d\n", count_instructions, count_data);
+    get_word_of_array(image, count_instructions + count_data);
+    length += encode_words_to_64base(get_word_of_array(image, 0), count_instructions + count_data, text_ob + length);
+    write_file(name_output, EXT_OBJECT, text_ob, length);
+    free(text_ob);
+
+    /* The entry labels of all the modules, at their addresses in the image */
+    if (table->count_label > 0){
+        init_buffer(&entry_list);
+        add_entry_list_to_buffer(table, &entry_list);
+        write_file(name_output, EXT_ENTRY, entry_list.text, entry_list.length);
+        free_buffer(&entry_list);
+    }
+}
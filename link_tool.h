@@ -0,0 +1,112 @@
+/*
+ * Header: link_tool.h
+ * -------------------
+ * This header file defines the link step ('--link NAME' option), which merges the files assembled in one run (the
+ * modules) into one image.
+ *
+ * Every module is assembled as if it was alone: its code starts at 'FIRST_CELL_IN_MEMORY' and its data follows its
+ * code, its '.entry' labels are listed in its '.ent' file and the words that refer to its '.extern' labels are listed
+ * in its '.ext' file. The link step places the code of all the modules one after the other, followed by the data of
+ * all the modules in the same order, and:
+ *
+ *   - moves every relocatable word (and every entry label) of a module by the distance its code or its data was moved,
+ *   - merges the entry labels of all the modules into one table of labels (the hashed label table), where a label
+ *     that is an entry of two modules is an error,
+ *   - completes every word that refers to an external label with the address of the entry of that name, as a
+ *     relocatable word, where a label that is not an entry of any module is an error.
+ *
+ * The result is written to 'NAME.ob' (in the format of the '.ob' files) and 'NAME.ent' (the entry labels of all the
+ * modules, at their addresses in the image). An image without errors has no external references, so no '.ext' file
+ * is written. The modules are read one at a time, so the memory of the link grows with the number of entry labels
+ * and the size of the image, and the time with the total size of the modules.
+ *
+ * Included Files:
+ *   - stdio.h: Standard Input/Output library. It provides functions for input and output operations, such as file handling.
+ *   - stdlib.h: Standard Library. It provides functions for memory allocation, conversion, and other utility functions.
+ *   - string.h: C String Library. It provides functions for manipulating strings, such as string copying and comparison.
+ *   - file_tool.h: Contains the functions that open the files of a module.
+ *   - buffer_tool.h: Contains the buffer the files of a module are read into, and the word arrays of the image.
+ *   - label_list.h: Contains the table of labels, which holds the entry labels of all the modules.
+ *   - arena_tool.h: Contains the arena of the nodes of the table of labels.
+ *   - text_tool.h: Contains the encoding and the decoding of the words of the object files.
+ *   - word_tool.h: Contains the layouts of the machine words and the table of the instructions.
+ *   - setting.h: Contains constant definitions and configurations used throughout the assembly process.
+ */
+
+#ifndef LINK_TOOL_H
+#define LINK_TOOL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "file_tool.h"
+#include "buffer_tool.h"
+#include "label_list.h"
+#include "arena_tool.h"
+#include "text_tool.h"
+#include "word_tool.h"
+#include "setting.h"
+
+/*
+ * Struct: item_link_module
+ * ------------------------
+ * A structure representing one module of the link: the files its assembly produced, and its place in the image.
+ *
+ * Fields:
+ *   - name_file: The name of the module (its source without the '.as' extension).
+ *   - object_flag: A boolean flag indicating if the module was assembled without errors (its '.ob' file is current).
+ *   - entry_flag: A boolean flag indicating if the module has entry labels (its '.ent' file is current).
+ *   - extern_flag: A boolean flag indicating if the module refers to external labels (its '.ext' file is current).
+ *   - count_instructions: The number of code words of the module (from the header of its '.ob' file).
+ *   - count_data: The number of data words of the module.
+ *   - code_base: The address of the first code word of the module in the image.
+ *   - data_base: The address of the first data word of the module in the image.
+ *
+ * Notes:
+ *   - The flags are set by the assembly of the run, so files left by an older assembly are never linked.
+ */
+typedef struct link_module_struct * ptr_link_module;
+typedef struct link_module_struct {
+    char *name_file;
+    bool object_flag;
+    bool entry_flag;
+    bool extern_flag;
+    int count_instructions;
+    int count_data;
+    int code_base;
+    int data_base;
+} item_link_module;
+
+/*
+ * Function: init_link_module
+ * --------------------------
+ * Initializes a module of the link: no file of the module is current yet.
+ *
+ * Parameters:
+ *   - module: A pointer to the module.
+ *   - name_file: The name of the module (not copied, it must stay valid during the link).
+ */
+void init_link_module(ptr_link_module module, char *name_file);
+
+/*
+ * Function: link_modules
+ * ----------------------
+ * Links the modules into one image and writes it to 'name_output.ob' and 'name_output.ent'.
+ *
+ * Parameters:
+ *   - modules: An array of the modules, in the order of their code and data in the image.
+ *   - count_modules: The number of modules.
+ *   - name_output: The name of the output files (without extension).
+ *   - file_log: The stream that receives the messages of the link.
+ *
+ * Returns:
+ *   - bool: TRUE if the image was linked and written, FALSE if there were errors (nothing is written).
+ *
+ * Notes:
+ *   - Every error is reported (a module that was not assembled, a damaged object file, an entry label of two
+ *     modules, an external label without an entry, an image larger than the memory), then the link stops.
+ *   - If dynamic memory allocation fails, the function prints an error message to stderr and exits the program.
+ */
+bool link_modules(ptr_link_module modules, int count_modules, char *name_output, FILE *file_log);
+
+#endif /* LINK_TOOL_H */
@@ -3,64 +3,213 @@
 /*
  * Function: create_node_macro
  * ---------------------------
- * Creates a new macro node with the provided 'name' and 'text' and returns a pointer to the newly
+ * Creates a new macro node with the provided 'name' and slice of body and returns a pointer to the newly
  * allocated node.
  *
  * Parameters:
+ *   table (ptr_macro_table): A pointer to the macro table, whose arena serves the node.
  *   name (const char*): The name to be assigned to the new macro node.
- *   text (const char*): The text or content to be assigned to the new macro node.
+ *   offset_text (size_t): The offset of the body of the macro in the text buffer of the macro table.
+ *   length_text (size_t): The number of characters in the body of the macro.
+ *   first_line (int): The index of the record of the first line of the body in the line records of the table.
+ *   count_lines (int): The number of lines of the body.
  *
  * Returns:
  *   ptr_macro: A pointer to the newly created macro node.
  *
  * Notes:
- *   - The function dynamically allocates memory for the new macro node using 'malloc'.
- *   - The 'name' and 'text' provided are copied to the respective fields of the newly created node.
+ *   - The function allocates memory for the new macro node from the arena of the table ('alloc_from_arena').
+ *   - The 'name' provided is copied to the name field of the newly created node.
  *   - The 'next' pointer of the node is initialized to NULL as it is not yet linked to any other nodes.
  */
-static ptr_macro create_node_macro(const char* name, const char* text);
+static ptr_macro create_node_macro(ptr_macro_table table, const char* name, size_t offset_text, size_t length_text,
+                                   int first_line, int count_lines);
 
-error_code add_to_list_macro(ptr_macro *head, const char* name, const char* text) {
-    /* Create a new macro node using the provided 'name' and 'text'. */
-    ptr_macro new_node = create_node_macro(name, text);
+/*
+ * Function: find_slot_macro
+ * -------------------------
+ * Finds the slot of a macro name in the hash table of the macro table.
+ *
+ * Parameters:
+ *   table (ptr_macro_table): A pointer to the macro table. The slots array must already be allocated.
+ *   name (const char*): The name of the macro.
+ *
+ * Returns:
+ *   ptr_macro*: A pointer to the slot holding the macro with the given name, or to the empty slot where it should be stored.
+ */
+static ptr_macro * find_slot_macro(ptr_macro_table table, const char *name);
 
-    /* Check if the linked list is empty (head is NULL). */
-    if (!(*head)){
-        /* If the list is empty, set the new node as the head of the list. */
-        *head = new_node;
-        return NO_ERROR;
-    } else {
-        /* If the list is not empty, traverse the list to check if a macro with the same name already exists. */
-        ptr_macro  temp_node = *head;
-        while(temp_node->next != NULL && strcmp(temp_node->name_macro,name) != 0){
-            temp_node = temp_node->next;
-        }
+/*
+ * Function: grow_macro_table
+ * --------------------------
+ * Allocates a larger slots array for the macro table and rehashes every macro into it.
+ *
+ * Parameters:
+ *   table (ptr_macro_table): A pointer to the macro table to be grown.
+ *
+ * Notes:
+ *   - The first call allocates 'INITIAL_HASH_TABLE_SIZE' slots, every next call doubles the size of the array.
+ *   - If dynamic memory allocation fails, the function prints an error message to stderr and exits the program.
+ */
+static void grow_macro_table(ptr_macro_table table);
 
-        /* If a macro with the same name already exists, free the new node and return an error code. */
-        if (strcmp(temp_node->name_macro,name) == 0){
-            free(new_node);
-            return MACRO_ALREADY_EXISTS;
-        } else {
-            /* If the macro with the given 'name' doesn't exist, add the new node to the end of the list. */
-            temp_node->next = new_node;
-            return NO_ERROR;
+/*
+ * Function: get_end_of_bodies
+ * ---------------------------
+ * Returns the offset in the text buffer right after the body of the last macro added to the table, which is where the
+ * body of the macro that is currently being defined starts.
+ *
+ * Parameters:
+ *   table (ptr_macro_table): A pointer to the macro table.
+ *
+ * Returns:
+ *   size_t: The offset of the first character that does not belong to a macro of the table.
+ */
+static size_t get_end_of_bodies(ptr_macro_table table);
+
+/*
+ * Function: get_end_of_lines
+ * --------------------------
+ * Returns the index in the line records right after the lines of the last macro added to the table, which is where the
+ * lines of the macro that is currently being defined start.
+ *
+ * Parameters:
+ *   table (ptr_macro_table): A pointer to the macro table.
+ *
+ * Returns:
+ *   int: The index of the first record that does not belong to a macro of the table.
+ */
+static int get_end_of_lines(ptr_macro_table table);
+
+void init_macro_table(ptr_macro_table table, ptr_arena arena){
+    table->head_macro = NULL;
+    table->tail_macro = NULL;
+    table->slots = NULL;
+    table->size_slots = 0;
+    table->count_macro = 0;
+    table->count_probe = 0;
+    init_buffer(&table->text_macros);
+    table->lines_macros = NULL;
+    table->count_lines = 0;
+    table->size_lines = 0;
+    table->arena = arena;
+}
+
+void append_text_to_macro(ptr_macro_table table, const char *text, const item_line *line){
+    ptr_line record;
+
+    append_text_to_buffer(&table->text_macros, text);
+
+    /* Keep a copy of the split line in the arena, to be handed to the passes for every call of the macro. */
+    if (table->count_lines == table->size_lines){
+        table->size_lines = (table->size_lines == 0) ? INITIAL_LINE_RECORDS_SIZE : table->size_lines * 2;
+        table->lines_macros = (ptr_line *)realloc(table->lines_macros, sizeof(ptr_line) * (size_t) table->size_lines);
+        if (table->lines_macros == NULL){
+            fprintf(stderr, "Error in dynamic memory allocation");
+            exit(EXIT_FAILURE);
         }
     }
+    record = (ptr_line)alloc_from_arena(table->arena, sizeof(item_line));
+    copy_line_struct(record, line);
+    table->lines_macros[(table->count_lines)++] = record;
 }
 
-static ptr_macro create_node_macro(const char* name, const char* text) {
-    /* Allocate memory for the new macro node. */
-    ptr_macro new_node = (ptr_macro)malloc(sizeof(item_macro));
+void discard_text_of_macro(ptr_macro_table table){
+    truncate_buffer(&table->text_macros, get_end_of_bodies(table));
+    table->count_lines = get_end_of_lines(table);
+}
+
+error_code add_to_list_macro(ptr_macro_table table, const char* name) {
+    ptr_macro *slot;
+    size_t offset_text = get_end_of_bodies(table);
+    int first_line = get_end_of_lines(table);
+
+    /* Grow the slots array if the table would become more than half full. */
+    if ((table->count_macro + 1) * 2 > table->size_slots){
+        grow_macro_table(table);
+    }
+
+    /* If a macro with the same name already exists, drop the new body and return an error code. */
+    slot = find_slot_macro(table, name);
+    if (*slot != NULL){
+        truncate_buffer(&table->text_macros, offset_text);
+        table->count_lines = first_line;
+        return MACRO_ALREADY_EXISTS;
+    }
 
-    /* Check if memory allocation was successful. */
-    if (new_node == NULL){
+    /* Create a new macro node for the pending body (and its lines) and store it in the empty slot. */
+    *slot = create_node_macro(table, name, offset_text, table->text_macros.length - offset_text, first_line,
+                              table->count_lines - first_line);
+    (table->count_macro)++;
+
+    /* Attach the new node at the end of the list. */
+    if (table->tail_macro == NULL){
+        table->head_macro = *slot;
+    } else {
+        table->tail_macro->next = *slot;
+    }
+    table->tail_macro = *slot;
+    return NO_ERROR;
+}
+
+static size_t get_end_of_bodies(ptr_macro_table table){
+    if (table->tail_macro == NULL){
+        return 0;
+    }
+    return table->tail_macro->offset_text + table->tail_macro->length_text;
+}
+
+static int get_end_of_lines(ptr_macro_table table){
+    if (table->tail_macro == NULL){
+        return 0;
+    }
+    return table->tail_macro->first_line + table->tail_macro->count_lines;
+}
+
+static ptr_macro * find_slot_macro(ptr_macro_table table, const char *name){
+    /* The size of the slots array is a power of two, so the mask selects the home slot of the name. */
+    unsigned long mask = (unsigned long) table->size_slots - 1;
+    unsigned long index = hash_name(name) & mask;
+
+    /* Linear probing: move to the next slot until the macro or an empty slot is found. */
+    (table->count_probe)++;
+    while (table->slots[index] != NULL && strcmp(table->slots[index]->name_macro, name) != 0){
+        index = (index + 1) & mask;
+        (table->count_probe)++;
+    }
+    return &table->slots[index];
+}
+
+static void grow_macro_table(ptr_macro_table table){
+    ptr_macro temp_node;
+    int new_size = (table->size_slots == 0) ? INITIAL_HASH_TABLE_SIZE : table->size_slots * 2;
+
+    /* Allocate the new (empty) slots array and release the old one. */
+    free(table->slots);
+    table->slots = (ptr_macro *)calloc((size_t) new_size, sizeof(ptr_macro));
+    if (table->slots == NULL){
         fprintf(stderr, "Error in dynamic memory allocation");
         exit(EXIT_FAILURE);
     }
+    table->size_slots = new_size;
+
+    /* Rehash every macro of the list into the new slots array. */
+    for (temp_node = table->head_macro; temp_node != NULL; temp_node = temp_node->next){
+        *find_slot_macro(table, temp_node->name_macro) = temp_node;
+    }
+}
+
+static ptr_macro create_node_macro(ptr_macro_table table, const char* name, size_t offset_text, size_t length_text,
+                                   int first_line, int count_lines) {
+    /* Allocate memory for the new macro node from the arena of the table. */
+    ptr_macro new_node = (ptr_macro)alloc_from_arena(table->arena, sizeof(item_macro));
 
-    /* Copy the provided 'name' and 'text' to the respective fields of the macro node. */
+    /* Copy the provided 'name' and the slice of the body to the respective fields of the macro node. */
     strcpy(new_node->name_macro, name);
-    strcpy(new_node->text_macro, text);
+    new_node->offset_text = offset_text;
+    new_node->length_text = length_text;
+    new_node->first_line = first_line;
+    new_node->count_lines = count_lines;
 
     /* Initialize the 'next' pointer of the macro node to NULL. */
     new_node->next = NULL;
@@ -69,48 +218,103 @@ static ptr_macro create_node_macro(const char* name, const char* text) {
     return new_node;
 }
 
-ptr_macro search_in_list_macro(ptr_macro head_macro, const char *name_macro) {
-    /* Start the search from the head of the linked list. */
-    ptr_macro temp_head = head_macro;
+ptr_macro search_in_list_macro(ptr_macro_table table, const char *name_macro) {
+    /* An empty table has no slots array yet. */
+    if (table->size_slots == 0){
+        return NULL;
+    }
+
+    /* Return the macro stored in the slot of the name (NULL if the probe ended in an empty slot). */
+    return *find_slot_macro(table, name_macro);
+}
+
+const char * get_text_of_macro(ptr_macro_table table, ptr_macro macro){
+    return table->text_macros.text + macro->offset_text;
+}
+
+ptr_line * get_lines_of_macro(ptr_macro_table table, ptr_macro macro){
+    return table->lines_macros + macro->first_line;
+}
+
+void init_line_index(ptr_line_index index){
+    index->lines = NULL;
+    index->count_lines = 0;
+    index->size_lines = 0;
+}
+
+void add_to_line_index(ptr_line_index index, ptr_line line){
+    int i;
+
+    /* Only count the lines until the first record is added. */
+    if (line == NULL && index->lines == NULL){
+        (index->count_lines)++;
+        return;
+    }
 
-    /* Traverse the linked list until the end or until a matching macro node is found. */
-    while (temp_head) {
-        /* Compare the 'name_macro' of the current node with the provided 'name_macro'. */
-        if (strcmp(name_macro, temp_head->name_macro) == 0) {
-            /* If a matching macro node is found, return a pointer to that node. */
-            return temp_head;
+    /* Make room for the line, every line counted before the first record has no record. */
+    if (index->count_lines >= index->size_lines){
+        i = (index->lines == NULL) ? 0 : index->size_lines;
+        index->size_lines = (index->size_lines == 0) ? INITIAL_LINE_RECORDS_SIZE : index->size_lines;
+        while (index->count_lines >= index->size_lines){
+            index->size_lines *= 2;
+        }
+        index->lines = (ptr_line *)realloc(index->lines, sizeof(ptr_line) * (size_t) index->size_lines);
+        if (index->lines == NULL){
+            fprintf(stderr, "Error in dynamic memory allocation");
+            exit(EXIT_FAILURE);
+        }
+        for (; i < index->count_lines; i++){
+            index->lines[i] = NULL;
         }
-        /* Move to the next node in the linked list. */
-        temp_head = temp_head->next;
     }
-    /* If the macro with the specified name is not found, return NULL. */
-    return NULL;
+    index->lines[(index->count_lines)++] = line;
 }
 
-void free_list_macro(ptr_macro *head){
-    ptr_macro temp_head;
+ptr_line get_from_line_index(ptr_line_index index, int number){
+    if (index->lines == NULL || number < 0 || number >= index->count_lines){
+        return NULL;
+    }
+    return index->lines[number];
+}
 
-    /* Traverse the linked list and free memory occupied by each node. */
-    while (*head){
-        /* Save the address of the next node. */
-        temp_head = *head;
+void clear_line_index(ptr_line_index index){
+    index->count_lines = 0;
+}
 
-        /* Update 'head' to point to the next node in the linked list. */
-        *head = (*head)->next;
+void free_line_index(ptr_line_index index){
+    free(index->lines);
+    init_line_index(index);
+}
 
-        /* Free the memory occupied by the current node. */
-        free(temp_head);
+void clear_list_macro(ptr_macro_table table){
+    /* Empty every slot, the text of the bodies and the line records, their memory is kept. */
+    if (table->slots != NULL){
+        memset(table->slots, 0, sizeof(ptr_macro) * (size_t) table->size_slots);
     }
-    /* After freeing all nodes, set the 'head' pointer to NULL to indicate an empty list. */
-    *head = NULL;
+    truncate_buffer(&table->text_macros, 0);
+    table->count_lines = 0;
+    table->head_macro = NULL;
+    table->tail_macro = NULL;
+    table->count_macro = 0;
+    table->count_probe = 0;
 }
 
-__attribute__((unused)) void print_list_macro(ptr_macro head){
-    ptr_macro temp_head = head;
+void free_list_macro(ptr_macro_table table){
+    /* The macro nodes and the line records belong to the arena, so only the slots array, the text buffer and the array of
+     * the records are freed before the table is reset to an empty table. */
+    free(table->slots);
+    free_buffer(&table->text_macros);
+    free(table->lines_macros);
+    init_macro_table(table, table->arena);
+}
+
+__attribute__((unused)) void print_list_macro(ptr_macro_table table){
+    ptr_macro temp_head = table->head_macro;
 
     /* Traverse the linked list and print the name and text of each macro node. */
     while (temp_head){
-        printf("Name: %s\tText of macro: %s\n",temp_head->name_macro, temp_head->text_macro);
+        printf("Name: %s\tText of macro: %.*s\n", temp_head->name_macro, (int) temp_head->length_text,
+               get_text_of_macro(table, temp_head));
         temp_head = temp_head->next;
     }
-}
\ No newline at end of file
+}
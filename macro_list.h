@@ -1,16 +1,26 @@
 /*
  * Header: macro_list.h
  * --------------------
- * This header file defines the data structures and function prototypes related to the macro list used for storing macro information
+ * This header file defines the data structures and function prototypes related to the macro table used for storing macro information
  * in the assembly code. It includes other necessary headers and provides access to the functions and data structures needed for
  * macro management.
  *
+ * The macros of a file are kept in a linked list (in definition order) and indexed by name in an open-addressing hash table, so the
+ * lookup done for every line of the source file does not depend on the number of macros. The bodies of all the macros are stored
+ * one after the other in a single growable text buffer, and each macro node only keeps the slice (offset and length) of its body.
+ * Every line of a body is also kept split into words (an 'item_line' record), since the pre-assembly already split it to find the
+ * end of the macro. A call of the macro hands these records to the passes through the line index of the file ('item_line_index'),
+ * so the lines of a macro called many times are not split again for every call.
+ *
  * Included Files:
  *   - stdlib.h: Standard Library. It provides functions for memory management and conversions.
  *   - stdio.h: Standard Input/Output library. It provides functions for input and output operations, such as file handling.
  *   - string.h: C String Library. It provides functions for manipulating strings, such as string copying and comparison.
  *   - setting.h: Contains constant definitions and configurations used in the macro list and macro management.
  *   - error_tool.h: Contains functions and error codes for handling errors related to macro list operations.
+ *   - buffer_tool.h: Contains the growable text buffer used to store the bodies of the macros.
+ *   - arena_tool.h: Contains the arena allocator from which the macro nodes and the line records are allocated.
+ *   - text_tool.h: Contains the line struct ('item_line') of the line records and the function that copies it.
  */
 
 #ifndef MACRO_LIST_H
@@ -21,114 +31,304 @@
 #include <string.h>
 #include "setting.h"
 #include "error_tool.h"
+#include "buffer_tool.h"
+#include "arena_tool.h"
+#include "text_tool.h"
 
 /*
  * Struct: node_macro
  * ------------------
- * Represents a node in the macro list used for storing macro information.
+ * Represents a node in the macro table used for storing macro information.
  *
  * Fields:
  *  - name_macro: An array to store the name of the macro.
- *  - text_macro: An array to store the text associated with the macro.
+ *  - offset_text: The offset of the body of the macro in the text buffer of the macro table.
+ *  - length_text: The number of characters in the body of the macro.
+ *  - first_line: The index of the record of the first line of the body in the line records of the macro table.
+ *  - count_lines: The number of lines of the body.
  *  - next: A pointer to the next node in the macro list.
  */
 typedef struct node_macro * ptr_macro;
 typedef struct node_macro {
     char name_macro[MAX_ASSEMBLY_LINE_LENGTH];
-    char text_macro[MAX_CHARACTERS_ASSEMBLY_FILE];
+    size_t offset_text;
+    size_t length_text;
+    int first_line;
+    int count_lines;
     ptr_macro next;
 } item_macro;
 
+/*
+ * Struct: item_macro_table
+ * ------------------------
+ * Represents the table of macros of a file.
+ *
+ * Fields:
+ *  - head_macro: A pointer to the first macro node (in definition order).
+ *  - tail_macro: A pointer to the last macro node, used to append a new node without walking the list.
+ *  - slots: An array of 'size_slots' pointers to macro nodes (open addressing with linear probing). An empty slot holds NULL.
+ *  - size_slots: The number of slots (a power of two, or zero before the first macro is added).
+ *  - count_macro: The number of macros stored in the table.
+ *  - count_probe: The number of slots visited by the lookups of the table (for the statistics).
+ *  - text_macros: The text buffer holding the bodies of all the macros. The characters after the last body belong to the
+ *                 macro that is currently being defined.
+ *  - lines_macros: An array of pointers to the records of the lines of all the bodies, split into words. The records are
+ *                  allocated from the arena, so they stay valid after the table is freed. The records after the last
+ *                  body belong to the macro that is currently being defined.
+ *  - count_lines: The number of records in 'lines_macros'.
+ *  - size_lines: The number of records 'lines_macros' has room for.
+ *  - arena: The arena from which the macro nodes and the line records are allocated (the arena of the file).
+ */
+typedef struct macro_table * ptr_macro_table;
+typedef struct macro_table {
+    ptr_macro head_macro;
+    ptr_macro tail_macro;
+    ptr_macro *slots;
+    int size_slots;
+    int count_macro;
+    long count_probe;
+    item_buffer text_macros;
+    ptr_line *lines_macros;
+    int count_lines;
+    int size_lines;
+    ptr_arena arena;
+} item_macro_table;
+
+/*
+ * Struct: item_line_index
+ * -----------------------
+ * Represents the index of the lines of the expanded code of a file: for every line read by the passes, the record of the
+ * line split into words, if the line comes from the body of a macro.
+ *
+ * Fields:
+ *  - lines: An array of 'count_lines' pointers to line records, one per line of the expanded code, in order. A line that
+ *           was copied from the source holds NULL (it is split by the pass that reads it). The array is allocated only
+ *           when the first macro is called, so a file without macro calls only counts its lines.
+ *  - count_lines: The number of lines in the index.
+ *  - size_lines: The number of lines 'lines' has room for.
+ */
+typedef struct line_index * ptr_line_index;
+typedef struct line_index {
+    ptr_line *lines;
+    int count_lines;
+    int size_lines;
+} item_line_index;
+
+/*
+ * Function: init_macro_table
+ * --------------------------
+ * Initializes an empty macro table.
+ *
+ * Parameters:
+ *   table (ptr_macro_table): A pointer to the macro table to be initialized.
+ *   arena (ptr_arena): The arena from which the macro nodes are allocated.
+ *
+ * Notes:
+ *   - No memory is allocated here; the slots and the text buffer are allocated when they are first needed.
+ */
+void init_macro_table(ptr_macro_table table, ptr_arena arena);
+
+/*
+ * Function: append_text_to_macro
+ * ------------------------------
+ * Appends a line of text to the body of the macro that is currently being defined.
+ *
+ * Parameters:
+ *   table (ptr_macro_table): A pointer to the macro table.
+ *   text (const char*): The text of the line to be appended to the body.
+ *   line (const item_line*): The line split into words ('split_line_to_words' of 'text').
+ *
+ * Notes:
+ *   - The text is appended to the end of the shared text buffer, right after the bodies of the macros already defined,
+ *     and a copy of the split line is added to the line records. They become the body of a macro when
+ *     'add_to_list_macro' is called.
+ *   - If dynamic memory allocation fails, the function prints an error message to stderr and exits the program.
+ */
+void append_text_to_macro(ptr_macro_table table, const char *text, const item_line *line);
+
+/*
+ * Function: discard_text_of_macro
+ * -------------------------------
+ * Discards the text (and the line records) appended to the body of the macro that is currently being defined.
+ *
+ * Parameters:
+ *   table (ptr_macro_table): A pointer to the macro table.
+ */
+void discard_text_of_macro(ptr_macro_table table);
+
 /*
  * Function: add_to_list_macro
  * ---------------------------
- * Adds a new macro node to the linked list of macros, given the 'head' pointer
- * to the start of the list, 'name', and 'text' of the macro.
+ * Adds a new macro node to the macro table, given the 'name' of the macro. The body of the new macro is the text that was
+ * appended with 'append_text_to_macro' since the previous macro was added or discarded.
  *
  * Parameters:
- *   head (ptr_macro*): A pointer to the head of the linked list of macros.
+ *   table (ptr_macro_table): A pointer to the macro table.
  *   name (const char*): The name of the new macro to be added.
- *   text (const char*): The text or content associated with the macro.
  *
  * Returns:
  *   error_code: An error code indicating the status of the operation. Possible values are:
- *               - NO_ERROR: The macro was successfully added to the list.
- *               - MACRO_ALREADY_EXISTS: A macro with the same name already exists in the list.
+ *               - NO_ERROR: The macro was successfully added to the table.
+ *               - MACRO_ALREADY_EXISTS: A macro with the same name already exists in the table.
  *
  * Notes:
- *   - The function first creates a new macro node using the provided 'name' and 'text' using
- *     the 'create_node_macro' function.
- *   - If the linked list is empty (head is NULL), the new node becomes the head of the list.
- *   - If a macro with the same name already exists in the list, the new node is not added, and
- *     the function returns an error code (MACRO_ALREADY_EXISTS).
- *   - If the list is not empty and the macro with the given 'name' doesn't exist, the new node
- *     is appended to the end of the list.
- *   - The function returns an error code to indicate the success or failure of the operation.
+ *   - The function probes the hash table for the 'name'. If a macro with the same name already exists, the new body is
+ *     discarded and the function returns an error code (MACRO_ALREADY_EXISTS).
+ *   - Otherwise, a new macro node is created with the slice of its body, stored in the hash table and appended to the end
+ *     of the list.
  */
-error_code add_to_list_macro(ptr_macro *head, const char* name, const char* text);
+error_code add_to_list_macro(ptr_macro_table table, const char* name);
 
 /*
  * Function: search_in_list_macro
  * -----------------------------
- * Searches for a macro node with the given 'name_macro' in the linked list starting from 'head_macro'.
+ * Searches for a macro node with the given 'name_macro' in the macro table.
  * If a macro node with the matching name is found, a pointer to that node is returned; otherwise, NULL is returned.
  *
  * Parameters:
- *   head_macro (ptr_macro): A pointer to the head of the linked list (the first macro node).
- *   name_macro (const char*): The name of the macro to search for in the linked list.
+ *   table (ptr_macro_table): A pointer to the macro table.
+ *   name_macro (const char*): The name of the macro to search for in the table.
  *
  * Returns:
  *   ptr_macro: A pointer to the found macro node if it exists, or NULL if the macro with the specified name is not found.
  *
  * Notes:
- *   - This function iterates through the linked list starting from 'head_macro' and compares the 'name_macro' of each node
- *     with the provided 'name_macro' using the 'strcmp' function.
- *   - If a macro node with the matching name is found, the function returns a pointer to that node.
- *   - If the macro with the given 'name_macro' is not found in the linked list, the function returns NULL.
+ *   - The function hashes 'name_macro' and probes the slots from its home slot until the macro or an empty slot is found.
  */
-ptr_macro search_in_list_macro(ptr_macro head_macro, const char *name_macro);
+ptr_macro search_in_list_macro(ptr_macro_table table, const char *name_macro);
 
 /*
- * Function: free_list_macro
+ * Function: get_text_of_macro
+ * ---------------------------
+ * Returns a pointer to the first character of the body of a macro in the text buffer of the macro table.
+ *
+ * Parameters:
+ *   table (ptr_macro_table): A pointer to the macro table.
+ *   macro (ptr_macro): A pointer to a macro node of the table.
+ *
+ * Returns:
+ *   const char*: A pointer to the body of the macro. The body is 'macro->length_text' characters long and is not null-terminated.
+ *
+ * Notes:
+ *   - The pointer is valid only until the next text is appended to the table (the buffer may be moved when it grows).
+ */
+const char * get_text_of_macro(ptr_macro_table table, ptr_macro macro);
+
+/*
+ * Function: get_lines_of_macro
+ * ----------------------------
+ * Returns the records of the lines of the body of a macro, split into words.
+ *
+ * Parameters:
+ *   table (ptr_macro_table): A pointer to the macro table.
+ *   macro (ptr_macro): A pointer to a macro node of the table.
+ *
+ * Returns:
+ *   ptr_line*: A pointer to the 'count_lines' records of the body, valid until a line is appended to the table.
+ */
+ptr_line * get_lines_of_macro(ptr_macro_table table, ptr_macro macro);
+
+/*
+ * Function: init_line_index
  * -------------------------
- * Frees the memory occupied by all nodes in the linked list starting from 'head'.
- * After calling this function, the linked list will be empty, and the 'head' pointer will be set to NULL.
+ * Initializes an empty line index (nothing is allocated).
+ *
+ * Parameters:
+ *   index (ptr_line_index): A pointer to the line index to be initialized.
+ */
+void init_line_index(ptr_line_index index);
+
+/*
+ * Function: add_to_line_index
+ * ---------------------------
+ * Adds the next line of the expanded code to the line index.
  *
  * Parameters:
- *   head (ptr_macro*): A pointer to a pointer to the head of the linked list (the first macro node).
- *                      This allows the function to update the 'head' pointer to NULL after freeing all nodes.
+ *   index (ptr_line_index): A pointer to the line index.
+ *   line (ptr_line): The record of the line split into words, or NULL for a line that the passes split themselves.
  *
  * Notes:
- *   - This function iteratively traverses the linked list starting from 'head', freeing the memory allocated
- *     for each macro node.
- *   - For each node, the function saves the next node's address, updates the 'head' pointer to point to the next node,
- *     and then frees the memory occupied by the current node using the 'free' function.
- *   - The function continues this process until the end of the linked list is reached (when 'head' becomes NULL).
- *   - After freeing all nodes, the 'head' pointer is set to NULL to indicate that the linked list is empty.
- *   - If 'head' is initially NULL (an empty list), this function does nothing, and there is no memory leak.
+ *   - While every line added is NULL, only the lines are counted. The array is allocated when the first record is
+ *     added, with NULL for every line before it, and doubled whenever it is full.
+ *   - If dynamic memory allocation fails, the function prints an error message to stderr and exits the program.
+ */
+void add_to_line_index(ptr_line_index index, ptr_line line);
+
+/*
+ * Function: get_from_line_index
+ * -----------------------------
+ * Returns the record of a line of the expanded code.
+ *
+ * Parameters:
+ *   index (ptr_line_index): A pointer to the line index.
+ *   number (int): The number of the line, counted from zero.
+ *
+ * Returns:
+ *   ptr_line: The record of the line split into words, or NULL if the line must be split by the caller.
+ */
+ptr_line get_from_line_index(ptr_line_index index, int number);
+
+/*
+ * Function: clear_line_index
+ * --------------------------
+ * Removes every line of the line index, keeping its array for the next file.
+ *
+ * Parameters:
+ *   index (ptr_line_index): A pointer to the line index.
+ */
+void clear_line_index(ptr_line_index index);
+
+/*
+ * Function: free_line_index
+ * -------------------------
+ * Frees the array of the line index and leaves it empty (as after 'init_line_index').
+ *
+ * Parameters:
+ *   index (ptr_line_index): A pointer to the line index.
+ */
+void free_line_index(ptr_line_index index);
+
+/*
+ * Function: clear_list_macro
+ * --------------------------
+ * Removes every macro of the macro table, keeping the slots, the text buffer and the array of line records for the next
+ * macros (the macro nodes and the records belong to the arena of the table, which must be reset or released with the table).
+ *
+ * Parameters:
+ *   table (ptr_macro_table): A pointer to the macro table to be cleared.
+ */
+void clear_list_macro(ptr_macro_table table);
+
+/*
+ * Function: free_list_macro
+ * -------------------------
+ * Frees the memory occupied by the macro table: the slots, the text buffer and the array of line records (the macro nodes
+ * and the records belong to the arena of the table and are released with it, so a line index still holds the records). After calling this function, the table will be empty (as after 'init_macro_table').
+ *
+ * Parameters:
+ *   table (ptr_macro_table): A pointer to the macro table to be freed.
  */
-void free_list_macro(ptr_macro *head);
+void free_list_macro(ptr_macro_table table);
 
 /*
  * Function: print_list_macro
  * --------------------------
- * (For Debugging) Prints the names and corresponding text of each macro node in the linked list starting from 'head'.
+ * (For Debugging) Prints the names and corresponding text of each macro node in the macro table.
  *
  * Parameters:
- *   head (ptr_macro): The head of the linked list (the first macro node).
+ *   table (ptr_macro_table): A pointer to the macro table.
  *
  * Returns:
  *   void
  *
  * Notes:
  *   - This function is intended for debugging purposes.
- *   - It iteratively traverses the linked list starting from 'head'.
+ *   - It iteratively traverses the linked list of the table, in definition order.
  *   - For each macro node, it prints the name and text of the macro using the 'printf' function.
- *   - If the linked list is empty (i.e., 'head' is NULL), nothing will be printed.
- *   - The '__attribute__((unused))' is a compiler directive that suppresses unused variable warnings
- *     for the 'print_list_macro' function, as the 'head' parameter might not be used in the function body.
- *     The attribute ensures that the function can still be compiled without warnings even if 'head' is not used.
+ *   - If the table is empty, nothing will be printed.
+ *   - The '__attribute__((unused))' is a compiler directive that suppresses unused function warnings
+ *     for the 'print_list_macro' function.
  */
-__attribute__((unused)) void print_list_macro(ptr_macro head);
+__attribute__((unused)) void print_list_macro(ptr_macro_table table);
 
-#endif /* MACRO_LIST_H */
\ No newline at end of file
+#endif /* MACRO_LIST_H */
@@ -16,6 +16,7 @@
  * Notes:
  *   - If no files are supplied to the program, it displays an error message and exits.
  *   - The assembly process will be carried out on each file provided in the command-line arguments.
+ *   - The option '-j N' assembles up to N files at the same time (see 'option_tool.h').
  */
 int main(int argc, char **argv) {
     /* Start of the project process */
@@ -23,12 +24,122 @@ int main(int argc, char **argv) {
     return 0;
 }
 
+/*
+ * Function: run_job
+ * -----------------
+ * Assembles the files of one job on the pool of worker threads and prints their console messages, followed by the
+ * closing separator and, with the '--stats' option, the sum of their statistics.
+ *
+ * Parameters:
+ *   options: A pointer to the options of the run.
+ *   name_files: An array of pointers to the names of the files of the job.
+ *   count_files: The number of names in 'name_files'.
+ *   file_out: The stream that receives the console messages of the job.
+ */
+static void run_job(ptr_options options, char **name_files, int count_files, FILE *file_out);
+
+/*
+ * Function: get_stream_of_run
+ * ---------------------------
+ * Returns the stream of the messages of the run that are not diagnostics (the link, the separator and the statistics).
+ *
+ * Parameters:
+ *   options: A pointer to the options of the run.
+ *   file_out: The stream of the console messages of the job.
+ *
+ * Returns:
+ *   FILE*: 'file_out' in the text formats, and the standard error in the JSON and SARIF formats, so the console
+ *          messages hold only the objects of the diagnostics.
+ */
+static FILE * get_stream_of_run(ptr_options options, FILE *file_out);
+
+/*
+ * Function: serve_jobs
+ * --------------------
+ * Reads jobs from a stream, one job per line (the names of its files, separated by white characters), and runs every
+ * job as soon as its line is read, until the end of the stream.
+ *
+ * Parameters:
+ *   options: A pointer to the options of the run, which apply to every job.
+ *   file_in: The stream the jobs are read from.
+ *   file_out: The stream that receives the console messages of the jobs.
+ *
+ * Notes:
+ *   - The messages of every job (an empty line too) are followed by the line 'SERVER_END_OF_JOB' and the stream is
+ *     flushed, so a client knows when the outputs of its job are ready.
+ *   - The released file structs are kept between the jobs ('release_file'), so the process stays warm.
+ */
+static void serve_jobs(ptr_options options, FILE *file_in, FILE *file_out);
+
+/*
+ * Function: serve_socket
+ * ----------------------
+ * Creates a Unix socket at the path of the '--socket' option and serves the jobs of its clients, one client at a time.
+ *
+ * Parameters:
+ *   options: A pointer to the options of the run.
+ *
+ * Notes:
+ *   - A file that already exists at the path is removed first.
+ *   - The function returns only if the socket cannot be created (an error message is printed to stderr).
+ */
+static void serve_socket(ptr_options options);
+
+/*
+ * Function: assemble_stream
+ * -------------------------
+ * Assembles one source read from the standard input and writes its output files to the standard output as one
+ * framed stream ('--stdio' option).
+ *
+ * Parameters:
+ *   options: A pointer to the options of the run. The first name of the command line, if any, names the source.
+ *
+ * Returns:
+ *   bool: TRUE if the source was assembled without errors, FALSE otherwise.
+ *
+ * Notes:
+ *   - The source is assembled in memory ('assemble'), so nothing is read from or written to the disk. The console
+ *     messages (and the statistics, with the '--stats' option) are written to the standard error.
+ */
+static bool assemble_stream(ptr_options options);
+
+/*
+ * Function: run_assembly_task
+ * ---------------------------
+ * Runs the task of one file of the pool: assembles the file and keeps the stream holding its console messages.
+ *
+ * Parameters:
+ *   index: The number of the file in the job.
+ *   jobs: A pointer to the context of the pool (item_jobs).
+ *
+ * Notes:
+ *   - With more than one job the console messages are written to a temporary file, so the messages of files
+ *     assembled at the same time are not mixed. With one job they are written directly to the output of the job.
+ */
+static void run_assembly_task(int index, void *jobs);
+
+/*
+ * Function: print_assembly_task
+ * -----------------------------
+ * Prints the console messages of the task of one file to the output of the job and closes their temporary file.
+ *
+ * Parameters:
+ *   index: The number of the file in the job.
+ *   jobs: A pointer to the context of the pool (item_jobs).
+ */
+static void print_assembly_task(int index, void *jobs);
+
 void start_assembly(int countFiles, char **arrayFiles) {
-    int i;
-    file_exists_status file_status;
+    item_options options;
+    bool result = TRUE;
+
+    /* Read the options and the names of the files */
+    if (parse_options(&options, countFiles, arrayFiles) == FALSE) {
+        exit(EXIT_FAILURE);
+    }
 
-    /* If no files are supplied as command-line arguments */
-    if (countFiles == 1) {
+    /* If no files are supplied as command-line arguments (a server reads them from its jobs, '--stdio' its source) */
+    if (options.count_files == 0 && options.server_flag == FALSE && options.stdio_flag == FALSE) {
         puts("");
         print_red();
         fprintf(stderr, "Error, assembly files should be provided.\n");
@@ -36,40 +147,322 @@ void start_assembly(int countFiles, char **arrayFiles) {
         exit(EXIT_FAILURE);
     }
 
-    /* Iterate through all the files provided as command-line arguments */
-    for (i = 1; i < countFiles; i++) {
+    /* Create the directory of the cache, if it is used */
+    if (options.cache_dir != NULL && create_cache_directory(options.cache_dir) == FALSE) {
+        fprintf(stderr, "Error, cannot create the cache directory '%s'.\n", options.cache_dir);
+        exit(EXIT_FAILURE);
+    }
 
-        puts("");
-        puts("--------------------------------------------------------------------------------");
-        printf("File Name: %s:\n\n", arrayFiles[i]);
-
-        file_status = file_exists(arrayFiles[i]);
-        switch (file_status) {
-            case EXISTS: /* If the file exists, start the assembly process for the current file */
-                start_assembly_process_on_file(arrayFiles[i]);
-                break;
-            case TOO_LONG: /* If the file name is too long, print an error message and skip processing this file */
-                print_red();
-                printf("ERROR- The file name is too long!\n");
-                print_reset();
-                break;
-            case NO_EXISTS: /* If the file does not exist, print an error message and skip processing this file */
-                print_red();
-                printf("ERROR- The file was not found!\n");
-                print_reset();
-                break;
-        }
+    if (options.stdio_flag == TRUE) {
+        result = assemble_stream(&options);
+    } else if (options.server_flag == FALSE) {
+        /* Assemble all the files provided as command-line arguments */
+        run_job(&options, options.name_files, options.count_files, stdout);
+    } else if (options.socket_path == NULL) {
+        serve_jobs(&options, stdin, stdout);
+    } else {
+        serve_socket(&options);
+    }
+
+    free_spare_files();
+    free_options(&options);
+    if (result == FALSE) {
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void run_job(ptr_options options, char **name_files, int count_files, FILE *file_out) {
+    item_jobs jobs;
+    item_stats total_stats;
+    double start = get_time_now();
+    int i;
+
+    jobs.options = options;
+    jobs.name_files = name_files;
+    jobs.file_out = file_out;
+    jobs.file_logs = (FILE **)malloc(sizeof(FILE *) * (size_t) (count_files + 1));
+    jobs.file_stats = (item_stats *)malloc(sizeof(item_stats) * (size_t) (count_files + 1));
+    jobs.file_modules = (item_link_module *)malloc(sizeof(item_link_module) * (size_t) (count_files + 1));
+    if (jobs.file_logs == NULL || jobs.file_stats == NULL || jobs.file_modules == NULL) {
+        fprintf(stderr, "Error in dynamic memory allocation");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Assemble all the files of the job */
+    run_tasks(count_files, options->count_jobs, run_assembly_task, print_assembly_task, &jobs);
+
+    /* Link the files of the job into one image, from the output files their assembly produced */
+    if (options->link_name != NULL) {
+        link_modules(jobs.file_modules, count_files, options->link_name, get_stream_of_run(options, file_out));
     }
+
     /* Print a separator line to signify the end of the assembly process */
-    puts("");
-    puts("--------------------------------------------------------------------------------");
+    if (is_structured_format(options->diagnostics_format) == FALSE) {
+        fputs("\n", file_out);
+        fputs("--------------------------------------------------------------------------------\n", file_out);
+    }
+
+    /* Print the sum of the statistics of the files of the job */
+    if (options->stats_flag == TRUE) {
+        init_stats(&total_stats);
+        for (i = 0; i < count_files; i++) {
+            add_stats(&total_stats, &jobs.file_stats[i]);
+        }
+        print_total_stats(get_stream_of_run(options, file_out), &total_stats, get_time_now() - start);
+    }
+
+    free(jobs.file_modules);
+    free(jobs.file_stats);
+    free(jobs.file_logs);
+}
+
+static FILE * get_stream_of_run(ptr_options options, FILE *file_out) {
+    if (is_structured_format(options->diagnostics_format) == TRUE) {
+        return stderr;
+    }
+    return file_out;
+}
+
+static void serve_jobs(ptr_options options, FILE *file_in, FILE *file_out) {
+    char *line = NULL;
+    size_t size_line = 0;
+    char **name_files = NULL;
+    int count_files;
+    int size_names = 0;
+    char *word;
+
+    while (getline(&line, &size_line, file_in) != -1) {
+        /* A line has at most half as many names as characters, the names are ended in place */
+        if ((int) (size_line / 2 + 1) > size_names) {
+            size_names = (int) (size_line / 2 + 1);
+            name_files = (char **)realloc(name_files, sizeof(char *) * (size_t) size_names);
+            if (name_files == NULL) {
+                fprintf(stderr, "Error in dynamic memory allocation");
+                exit(EXIT_FAILURE);
+            }
+        }
+        count_files = 0;
+        for (word = line + strspn(line, SERVER_SEPARATORS); *word != '\0'; word += strspn(word, SERVER_SEPARATORS)) {
+            name_files[count_files++] = word;
+            word += strcspn(word, SERVER_SEPARATORS);
+            if (*word != '\0') {
+                *word++ = '\0';
+            }
+        }
+
+        /* Run the job and mark the end of its messages */
+        if (count_files > 0) {
+            run_job(options, name_files, count_files, file_out);
+        }
+        fprintf(file_out, "%s\n", SERVER_END_OF_JOB);
+        fflush(file_out);
+    }
+
+    free(name_files);
+    free(line);
 }
 
-void start_assembly_process_on_file(char* name_file) {
+static void serve_socket(ptr_options options) {
+    struct sockaddr_un address;
+    int descriptor_server;
+    int descriptor_client;
+    FILE *file_in;
+    FILE *file_out;
+
+    if (strlen(options->socket_path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Error, the path of the socket is too long.\n");
+        return;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, options->socket_path);
+
+    /* A client that goes away before its messages are written must not end the server */
+    signal(SIGPIPE, SIG_IGN);
+
+    /* Create the socket, replacing an old socket left at the path */
+    unlink(options->socket_path);
+    descriptor_server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (descriptor_server == -1 || bind(descriptor_server, (struct sockaddr *) &address, sizeof(address)) == -1 ||
+        listen(descriptor_server, SERVER_BACKLOG) == -1) {
+        fprintf(stderr, "Error, cannot create the socket '%s'.\n", options->socket_path);
+        if (descriptor_server != -1) {
+            close(descriptor_server);
+        }
+        return;
+    }
+
+    /* Serve the clients one at a time, a client that cannot be served is dropped */
+    while ((descriptor_client = accept(descriptor_server, NULL, NULL)) != -1 || errno == EINTR) {
+        if (descriptor_client == -1) {
+            continue;
+        }
+        file_in = fdopen(descriptor_client, "r");
+        file_out = (file_in != NULL) ? fdopen(dup(descriptor_client), "w") : NULL;
+        if (file_out != NULL) {
+            serve_jobs(options, file_in, file_out);
+            fclose(file_out);
+        }
+        if (file_in != NULL) {
+            fclose(file_in);
+        } else {
+            close(descriptor_client);
+        }
+    }
+    fprintf(stderr, "Error, cannot accept a client on the socket '%s'.\n", options->socket_path);
+    close(descriptor_server);
+    unlink(options->socket_path);
+}
+
+static bool assemble_stream(ptr_options options) {
+    item_buffer source;
+    item_assembler assembler;
+    item_assembler_output output;
+    bool result;
+
+    /* Read the whole source from the standard input */
+    init_buffer(&source);
+    read_file_to_buffer(&source, stdin);
+
+    /* Assemble it in memory, with the console messages on the standard error */
+    init_assembler(&assembler, (options->count_files > 0) ? options->name_files[0] : STREAM_DEFAULT_NAME, stderr);
+    assembler.single_pass_flag = options->single_pass_flag;
+    assembler.binary_flag = options->binary_flag;
+    assembler.diagnostics_format = options->diagnostics_format;
+    assembler.max_errors = options->max_errors;
+    result = assemble(&assembler, (source.text != NULL) ? source.text : "", source.length, &output);
+    if (options->stats_flag == TRUE) {
+        print_stats(stderr, &output.stats);
+    }
+
+    /* Write the output files to the standard output */
+    write_output_stream(stdout, assembler.name_file, &output, options->am_flag);
+    fflush(stdout);
+
+    free_assembler_output(&output);
+    free_buffer(&source);
+    return result;
+}
+
+static void run_assembly_task(int index, void *jobs) {
+    ptr_jobs temp_jobs = (ptr_jobs) jobs;
+    FILE *file_log = temp_jobs->file_out;
+
+    if (temp_jobs->options->count_jobs > 1) {
+        file_log = tmpfile();
+        if (file_log == NULL) {
+            fprintf(stderr, "Error in creating a temporary file");
+            exit(EXIT_FAILURE);
+        }
+    }
+    temp_jobs->file_logs[index] = file_log;
+    init_stats(&temp_jobs->file_stats[index]);
+    init_link_module(&temp_jobs->file_modules[index], temp_jobs->name_files[index]);
+    assemble_file(temp_jobs->name_files[index], file_log, temp_jobs->options, &temp_jobs->file_stats[index],
+                  &temp_jobs->file_modules[index]);
+}
+
+static void print_assembly_task(int index, void *jobs) {
+    ptr_jobs temp_jobs = (ptr_jobs) jobs;
+    FILE *file_log = temp_jobs->file_logs[index];
+    char buffer[BUFSIZ];
+    size_t length;
+
+    if (file_log == temp_jobs->file_out) {
+        return;
+    }
+
+    /* Copy the console messages of the file to the output of the job */
+    rewind(file_log);
+    while ((length = fread(buffer, 1, sizeof(buffer), file_log)) > 0) {
+        fwrite(buffer, 1, length, temp_jobs->file_out);
+    }
+    fclose(file_log);
+}
+
+void assemble_file(char *name_file, FILE *file_log, ptr_options options, ptr_stats stats, ptr_link_module module) {
+    FILE *file_as;
+
+    /* In the JSON and SARIF formats the object of the diagnostics names the file, so there is no header */
+    if (is_structured_format(options->diagnostics_format) == FALSE) {
+        fputs("\n", file_log);
+        fputs("--------------------------------------------------------------------------------\n", file_log);
+        fprintf(file_log, "File Name: %s:\n\n", name_file);
+    }
+
+    switch (open_source_file(name_file, &file_as)) {
+        case EXISTS: /* If the file exists, start the assembly process for the current file on its opened stream */
+            start_assembly_process_on_file(name_file, file_as, file_log, options, stats, module);
+            break;
+        case TOO_LONG: /* If the file name is too long, print an error message and skip processing this file */
+            print_red();
+            if (is_structured_format(options->diagnostics_format) == TRUE) {
+                fprintf(stderr, "ERROR- The name of the file %s is too long!\n", name_file);
+            } else {
+                fprintf(file_log, "ERROR- The file name is too long!\n");
+            }
+            print_reset();
+            break;
+        case NO_EXISTS: /* If the file does not exist, print an error message and skip processing this file */
+            print_red();
+            if (is_structured_format(options->diagnostics_format) == TRUE) {
+                fprintf(stderr, "ERROR- The file %s was not found!\n", name_file);
+            } else {
+                fprintf(file_log, "ERROR- The file was not found!\n");
+            }
+            print_reset();
+            break;
+    }
+}
+
+void start_assembly_process_on_file(char* name_file, FILE *file_as, FILE *file_log, ptr_options options,
+                                    ptr_stats stats, ptr_link_module module) {
     ptr_file file_struct;
+    item_cache_key key;
+    bool restored[COUNT_FILE_EXT];
+    FILE *file_messages = file_log;
+    char *text_log = NULL;
+    size_t length_log = 0;
+
+    /* A file whose source is in the cache is not assembled again, its outputs and messages are restored */
+    if (options->cache_dir != NULL) {
+        init_cache_key(&key, options->cache_dir, name_file, file_as, options->am_flag, options->binary_flag,
+                       options->diagnostics_format, options->max_errors);
+        init_stats(stats);
+        if (restore_from_cache(&key, name_file, file_log, stats, restored) == TRUE) {
+            module->object_flag = restored[EXT_OBJECT];
+            module->entry_flag = restored[EXT_ENTRY];
+            module->extern_flag = restored[EXT_EXTERN];
+            if (options->stats_flag == TRUE && is_structured_format(options->diagnostics_format) == FALSE) {
+                print_stats(file_log, stats);
+            }
+            fclose(file_as);
+            free_cache_key(&key);
+            return;
+        }
+
+        /* Otherwise the source read for the key is assembled (the file is not read again), and the messages of the
+         * file are also kept in memory, to be stored in the cache */
+        fclose(file_as);
+        file_as = NULL;
+        file_messages = open_memstream(&text_log, &length_log);
+        if (file_messages == NULL) {
+            fprintf(stderr, "Error in dynamic memory allocation");
+            exit(EXIT_FAILURE);
+        }
+    }
 
     /* Create a new file structure to manage the assembly process for the current file */
-    file_struct = create_new_file_struct(name_file);
+    file_struct = create_new_file_struct(name_file, file_as, file_messages);
+    if (options->cache_dir != NULL) {
+        file_struct->source = &key.source;
+    }
+    file_struct->am_flag = options->am_flag;
+    file_struct->binary_flag = options->binary_flag;
+    file_struct->single_pass_flag = options->single_pass_flag;
+    file_struct->count_chunks = options->count_chunks;
+    file_struct->diagnostics_format = options->diagnostics_format;
+    file_struct->diagnostic_list.max_diagnostics = options->max_errors;
 
     /* Perform pre-assembly operations to handle comments, white spaces, and macros */
     start_pre_assembly(file_struct);
@@ -83,19 +476,28 @@ void start_assembly_process_on_file(char* name_file) {
     /* Print the result of the assembly process for the current file */
     print_end_of_file(file_struct);
 
-    /* Free the memory allocated for the file structure to release resources */
-    free_file(file_struct);
-}
+    /* Copy the messages of the file to its console stream and store the result of the file in the cache */
+    if (options->cache_dir != NULL) {
+        fclose(file_messages);
+        fwrite(text_log, 1, length_log, file_log);
+        store_in_cache(&key, file_struct, text_log, length_log);
+        free(text_log);
+        free_cache_key(&key);
+    }
 
-void print_end_of_file(ptr_file file_struct){
-    /* Print success message if no errors were encountered */
-    if (file_struct->error_flag == FALSE){
-        printf("\nCompilation completed successfully.\n");
-        printf("Lines parsed into file: %d.\n", file_struct->IC + file_struct->DC - FIRST_CELL_IN_MEMORY);
+    /* Keep the statistics of the file, and print them if they were requested */
+    *stats = file_struct->stats;
+    if (options->stats_flag == TRUE && is_structured_format(options->diagnostics_format) == FALSE) {
+        print_stats(file_log, stats);
+    }
 
-    /* Print error message if there were errors during the assembly process */
-    } else {
-        printf("\nNumber of errors: %d.\n", file_struct->count_error);
-        printf("Compilation not completed.\n");
+    /* Keep the output files produced by the assembly, for the link */
+    if (file_struct->error_flag == FALSE) {
+        module->object_flag = TRUE;
+        module->entry_flag = file_struct->entry_flag;
+        module->extern_flag = file_struct->extern_flag;
     }
-}
\ No newline at end of file
+
+    /* Release the file structure, its memory is kept for the next file */
+    release_file(file_struct);
+}
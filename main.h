@@ -10,35 +10,96 @@
  *   - pre_assembly.h: Contains functions and declarations for the pre-assembly process, which handles macros and expansions.
  *   - first_pass.h: Contains functions and declarations for the first pass of the assembly process, which collects labels and calculates memory addresses.
  *   - second_pass.h: Contains functions and declarations for the second pass of the assembly process, which generates the final machine code.
+ *   - assembler.h: Contains the interface of the assembler as a library, and the report printed at the end of every file.
+ *   - option_tool.h: Contains the options of the assembler and the function that reads them from the command line.
+ *   - errno.h, signal.h, sys/socket.h, sys/un.h: The Unix socket of the server ('--socket' option).
+ *   - pool_tool.h: Contains the pool of worker threads used to assemble several files at the same time.
+ *   - cache_tool.h: Contains the cache of assembled files ('--cache' option).
  *   - setting.h: Contains constant definitions and configurations used throughout the assembly process.
  */
 
 #ifndef MAIN_H
 #define MAIN_H
 
+#include <errno.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 #include "file_tool.h"
 #include "pre_assembly.h"
 #include "first_pass.h"
 #include "second_pass.h"
+#include "assembler.h"
+#include "option_tool.h"
+#include "pool_tool.h"
+#include "cache_tool.h"
+#include "link_tool.h"
 #include "setting.h"
 
+/*
+ * Struct: item_jobs
+ * -----------------
+ * The context shared by the tasks of the pool when several files are assembled in one run.
+ *
+ * Fields:
+ *   - options: A pointer to the options of the run.
+ *   - name_files: An array of pointers to the names of the files of the job (one task per file).
+ *   - file_out: The stream that receives the console messages of the job (the standard output, or the client of
+ *               the server).
+ *   - file_logs: An array holding, for every file, the stream its console messages are written to.
+ *   - file_stats: An array holding, for every file, the statistics of its assembly (summed up at the end of the run).
+ *   - file_modules: An array holding, for every file, the output files its assembly produced (the modules of the
+ *                   link, see 'link_tool.h').
+ */
+typedef struct jobs_struct * ptr_jobs;
+typedef struct jobs_struct {
+    ptr_options options;
+    char **name_files;
+    FILE *file_out;
+    FILE **file_logs;
+    item_stats *file_stats;
+    item_link_module *file_modules;
+} item_jobs;
+
 /*
  * Function: start_assembly
  * ------------------------
  * The 'start_assembly' function serves as the main driver for the assembly process. It is responsible for
- * initiating the assembly process for each assembly file provided as command-line arguments. The function loops
- * through all the files, checks their existence, and begins the assembly process for each valid file.
+ * initiating the assembly process for each assembly file provided as command-line arguments. The function reads
+ * the options, then runs 'assemble_file' for all the files, on a pool of 'count_jobs' worker threads.
  *
  * Parameters:
  *   countFiles: An integer representing the number of command-line arguments (number of files to process).
- *   arrayFiles: An array of pointers to strings, where each element represents a file name.
+ *   arrayFiles: An array of pointers to strings, where each element represents a file name or an option.
  *
  * Notes:
  *   - This function is called from the 'main' function, which is the entry point of the program.
  *   - If no files are supplied as command-line arguments, the function displays an error message and exits the program.
+ *   - With more than one job, the console messages of every file are written to a temporary file and printed
+ *     to the standard output in the order of the command line, so the output is the same as with one job.
+ *   - With the '--stdio' option, one source is read from the standard input and its output files are written to
+ *     the standard output (the exit status is 1 if the source has errors).
+ *   - With the '--link' option, the files of every job are then linked into one image ('link_modules').
+ *   - With the '--server' or '--socket' option, the files are read from the jobs of the server instead, and the
+ *     process runs until the end of its standard input (or until its socket fails).
  */
 void start_assembly(int countFiles, char **arrayFiles);
 
+/*
+ * Function: assemble_file
+ * -----------------------
+ * Prints the header of a file (not in the JSON and SARIF formats), opens its source and, if it exists, assembles it.
+ *
+ * Parameters:
+ *   name_file: A pointer to a string representing the name of the assembly file (without the '.as' extension).
+ *   file_log: The stream that receives the console messages of the file.
+ *   options: A pointer to the options of the run.
+ *   stats: A pointer to the statistics that receive those of the file (left empty if the file is not assembled).
+ *   module: A pointer to the module of the file, which receives the output files produced (none if the file is not
+ *           assembled).
+ */
+void assemble_file(char *name_file, FILE *file_log, ptr_options options, ptr_stats stats, ptr_link_module module);
+
 /*
  * Function: start_assembly_process_on_file
  * ---------------------------------------
@@ -49,31 +110,23 @@ void start_assembly(int countFiles, char **arrayFiles);
  *
  * Parameters:
  *   name_file: A pointer to a string representing the name of the assembly file to be processed.
+ *   file_as: The stream of the source file, opened by 'assemble_file' ('open_source_file'). It is closed once the
+ *            source is read.
+ *   file_log: The stream that receives the console messages of the file.
+ *   options: A pointer to the options of the run (for example, whether the '.am' file is written).
+ *   stats: A pointer to the statistics that receive those of the file.
+ *   module: A pointer to the module of the file, which receives the output files produced by the assembly (or
+ *           restored from the cache), for the '--link' option.
  *
  * Notes:
- *   - This function is called by the 'start_assembly' function for each valid assembly file provided as a command-line
+ *   - This function is called by the 'assemble_file' function for each valid assembly file provided as a command-line
  *     argument.
+ *   - With the '--stats' option, the statistics of the file are printed after its result (not in the JSON and SARIF
+ *     formats, whose messages hold only the diagnostics).
+ *   - With the '--cache' option, a file whose source is found in the cache is restored from its entry instead of
+ *     being assembled; otherwise its messages are also kept in memory, and its result is stored in the cache.
  */
-void start_assembly_process_on_file(char* name_file);
-
-/*
- * Function: print_end_of_file
- * ---------------------------
- * The 'print_end_of_file' function prints the final result of the assembly process for a specific assembly file.
- * It displays whether the compilation was successful or encountered errors, along with additional information
- * related to the number of lines parsed and any error messages.
- *
- * Parameters:
- *   file_struct: A pointer to the file structure (ptr_file) representing the processed assembly file.
- *
- * Notes:
- *   - This function is called at the end of the assembly process for each assembly file to display the final result.
- *   - The function takes the 'file_struct' as a parameter to access the file-specific data, such as the number of errors,
- *     whether the compilation was successful (indicated by 'error_flag'), and the values of the instruction counter (IC)
- *     and data counter (DC).
- *   - If no errors were encountered during the assembly process (error_flag == FALSE), the function prints a success message
- *     indicating that the compilation was completed successfully.
- */
-void print_end_of_file(ptr_file file_struct);
+void start_assembly_process_on_file(char* name_file, FILE *file_as, FILE *file_log, ptr_options options,
+                                    ptr_stats stats, ptr_link_module module);
 
 #endif /* MAIN_H */
\ No newline at end of file
@@ -0,0 +1,296 @@
+#include "option_tool.h"
+
+/* Function: parse_count_jobs
+ * --------------------------
+ * Reads the number of jobs given to the '-j' option (or the number of chunks given to the '--chunks' option).
+ *
+ * Parameters:
+ *   - text: A pointer to the text of the number.
+ *
+ * Returns:
+ *   - int: The number of jobs, or 0 if the text is not a number between 1 and 'MAX_COUNT_JOBS'.
+ */
+static int parse_count_jobs(const char *text);
+
+/* Function: parse_diagnostics_format
+ * ----------------------------------
+ * Reads the format given to the '--diagnostics' option.
+ *
+ * Parameters:
+ *   - text: A pointer to the name of the format ("text", "color", "json" or "sarif").
+ *   - format: A pointer that receives the format.
+ *
+ * Returns:
+ *   - bool: TRUE if the name is the name of a format, FALSE otherwise.
+ */
+static bool parse_diagnostics_format(const char *text, diagnostics_format *format);
+
+/* Function: parse_max_errors
+ * --------------------------
+ * Reads the number given to the '--max-errors' option.
+ *
+ * Parameters:
+ *   - text: A pointer to the text of the number.
+ *
+ * Returns:
+ *   - int: The number (0 keeps all the errors), or -1 if the text is not a number of at most 'MAX_DIGITS_FOR_NUMBER' - 1
+ *          digits (that fits in an int).
+ */
+static int parse_max_errors(const char *text);
+
+/* Function: add_name_file
+ * -----------------------
+ * Appends the name of a file to the names of the files of the options, growing their array if needed.
+ *
+ * Parameters:
+ *   - options: A pointer to the options.
+ *   - name_file: A pointer to the name of the file (it is not copied).
+ *
+ * Notes:
+ *   - If dynamic memory allocation fails, the function prints an error message to stderr and exits the program.
+ */
+static void add_name_file(ptr_options options, char *name_file);
+
+/* Function: read_list_of_files
+ * ----------------------------
+ * Reads the names of the files listed in a file ('@PATH' argument) and appends them to the names of the options.
+ *
+ * The whole list is read at once, and the names are separated by white characters (as the names of a job of the
+ * server). Every name is copied to the arena of the names of the options, so the list is released right away.
+ *
+ * Parameters:
+ *   - options: A pointer to the options.
+ *   - path: The path of the list, or "-" to read it from the standard input.
+ *
+ * Returns:
+ *   - bool: TRUE if the list was read, FALSE if it cannot be opened.
+ */
+static bool read_list_of_files(ptr_options options, const char *path);
+
+bool parse_options(ptr_options options, int argc, char **argv){
+    int i;
+    const char *count_jobs_text;
+    bool list_from_stdin = FALSE;
+
+    options->count_jobs = 1;
+    options->count_chunks = 1;
+    options->am_flag = FALSE;
+    options->binary_flag = FALSE;
+    options->single_pass_flag = FALSE;
+    options->stats_flag = FALSE;
+    options->diagnostics_format = FORMAT_TEXT;
+    options->max_errors = 0;
+    options->cache_dir = NULL;
+    options->stdio_flag = FALSE;
+    options->server_flag = FALSE;
+    options->socket_path = NULL;
+    options->link_name = NULL;
+    options->count_files = 0;
+    init_arena(&options->arena_names);
+
+    /* Every argument may be a file name, so this is the most that will be needed without a list of files. */
+    options->size_names = argc;
+    options->name_files = (char **)malloc(sizeof(char *) * (size_t) argc);
+    if (options->name_files == NULL){
+        fprintf(stderr, "Error in dynamic memory allocation");
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 1; i < argc; i++){
+        if (strncmp(argv[i], "-j", 2) == 0){
+            /* The number of jobs is either attached to the option or is the next argument. */
+            if (argv[i][2] != '\0'){
+                count_jobs_text = argv[i] + 2;
+            } else if (i + 1 < argc){
+                count_jobs_text = argv[++i];
+            } else {
+                count_jobs_text = "";
+            }
+            options->count_jobs = parse_count_jobs(count_jobs_text);
+            if (options->count_jobs == 0){
+                fprintf(stderr, "Error, the '-j' option expects a number of jobs between 1 and %d.\n", MAX_COUNT_JOBS);
+                return FALSE;
+            }
+        } else if (strcmp(argv[i], "--chunks") == 0){
+            /* The number of chunks is the next argument. */
+            options->count_chunks = (i + 1 < argc) ? parse_count_jobs(argv[++i]) : 0;
+            if (options->count_chunks == 0){
+                fprintf(stderr, "Error, the '--chunks' option expects a number of chunks between 1 and %d.\n", MAX_COUNT_JOBS);
+                return FALSE;
+            }
+        } else if (strcmp(argv[i], "--am") == 0){
+            options->am_flag = TRUE;
+        } else if (strcmp(argv[i], "--binary") == 0){
+            options->binary_flag = TRUE;
+        } else if (strcmp(argv[i], "--single-pass") == 0){
+            options->single_pass_flag = TRUE;
+        } else if (strcmp(argv[i], "--stats") == 0){
+            options->stats_flag = TRUE;
+        } else if (strcmp(argv[i], "--diagnostics") == 0){
+            /* The format of the errors is the next argument. */
+            if (i + 1 >= argc || parse_diagnostics_format(argv[i + 1], &options->diagnostics_format) == FALSE){
+                fprintf(stderr, "Error, the '--diagnostics' option expects one of the formats text, color, json or sarif.\n");
+                return FALSE;
+            }
+            i++;
+        } else if (strcmp(argv[i], "--max-errors") == 0){
+            /* The number of errors is the next argument. */
+            options->max_errors = (i + 1 < argc) ? parse_max_errors(argv[++i]) : -1;
+            if (options->max_errors == -1){
+                fprintf(stderr, "Error, the '--max-errors' option expects a number of errors (0 for no limit).\n");
+                return FALSE;
+            }
+        } else if (strcmp(argv[i], "--cache") == 0){
+            /* The directory of the cache is the next argument. */
+            if (i + 1 >= argc){
+                fprintf(stderr, "Error, the '--cache' option expects the path of a directory.\n");
+                return FALSE;
+            }
+            options->cache_dir = argv[++i];
+        } else if (strcmp(argv[i], "--link") == 0){
+            /* The name of the linked image is the next argument. */
+            if (i + 1 >= argc){
+                fprintf(stderr, "Error, the '--link' option expects the name of the linked image.\n");
+                return FALSE;
+            }
+            options->link_name = argv[++i];
+        } else if (strcmp(argv[i], "--stdio") == 0){
+            options->stdio_flag = TRUE;
+        } else if (strcmp(argv[i], "--server") == 0){
+            options->server_flag = TRUE;
+        } else if (strcmp(argv[i], "--socket") == 0){
+            /* The path of the socket is the next argument. */
+            if (i + 1 >= argc){
+                fprintf(stderr, "Error, the '--socket' option expects the path of a socket.\n");
+                return FALSE;
+            }
+            options->server_flag = TRUE;
+            options->socket_path = argv[++i];
+        } else if (argv[i][0] == '@' && argv[i][1] != '\0'){
+            /* The names of the files are read from a list, in the place of the argument. */
+            if (read_list_of_files(options, argv[i] + 1) == FALSE){
+                fprintf(stderr, "Error, cannot read the list of files '%s'.\n", argv[i] + 1);
+                return FALSE;
+            }
+            if (strcmp(argv[i], "@-") == 0){
+                list_from_stdin = TRUE;
+            }
+        } else {
+            add_name_file(options, argv[i]);
+        }
+    }
+
+    /* The standard input carries either the list of files or the source (or the jobs), not both. */
+    if (list_from_stdin == TRUE && (options->stdio_flag == TRUE ||
+                                    (options->server_flag == TRUE && options->socket_path == NULL))){
+        fprintf(stderr, "Error, the list of files '@-' cannot be used with '--stdio' or '--server'.\n");
+        return FALSE;
+    }
+
+    /* The standard streams carry either one source or the jobs of the server, not both. */
+    if (options->stdio_flag == TRUE && options->server_flag == TRUE){
+        fprintf(stderr, "Error, the '--stdio' option cannot be used with '--server' or '--socket'.\n");
+        return FALSE;
+    }
+
+    /* A single source read from the standard input has nothing to be linked with. */
+    if (options->stdio_flag == TRUE && options->link_name != NULL){
+        fprintf(stderr, "Error, the '--link' option cannot be used with '--stdio'.\n");
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static int parse_count_jobs(const char *text){
+    int count = 0;
+
+    if (*text == '\0'){
+        return 0;
+    }
+    for (; *text != '\0'; text++){
+        if (*text < '0' || *text > '9'){
+            return 0;
+        }
+        count = count * 10 + (*text - '0');
+        if (count > MAX_COUNT_JOBS){
+            return 0;
+        }
+    }
+    return count;
+}
+
+static bool parse_diagnostics_format(const char *text, diagnostics_format *format){
+    if (strcmp(text, "text") == 0){
+        *format = FORMAT_TEXT;
+    } else if (strcmp(text, "color") == 0){
+        *format = FORMAT_COLOR;
+    } else if (strcmp(text, "json") == 0){
+        *format = FORMAT_JSON;
+    } else if (strcmp(text, "sarif") == 0){
+        *format = FORMAT_SARIF;
+    } else {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static int parse_max_errors(const char *text){
+    size_t length = strlen(text);
+
+    if (length == 0 || length >= MAX_DIGITS_FOR_NUMBER - 2 || strspn(text, "0123456789") != length){
+        return -1;
+    }
+    return atoi(text);
+}
+
+static void add_name_file(ptr_options options, char *name_file){
+    if (options->count_files == options->size_names){
+        options->size_names *= 2;
+        options->name_files = (char **)realloc(options->name_files, sizeof(char *) * (size_t) options->size_names);
+        if (options->name_files == NULL){
+            fprintf(stderr, "Error in dynamic memory allocation");
+            exit(EXIT_FAILURE);
+        }
+    }
+    options->name_files[(options->count_files)++] = name_file;
+}
+
+static bool read_list_of_files(ptr_options options, const char *path){
+    item_buffer text_list;
+    FILE *file_list = (strcmp(path, "-") == 0) ? stdin : fopen(path, "r");
+    char *word;
+    char *name_file;
+    size_t length;
+
+    if (file_list == NULL){
+        return FALSE;
+    }
+
+    /* Read the whole list with one read loop */
+    init_buffer(&text_list);
+    read_file_to_buffer(&text_list, file_list);
+    if (file_list != stdin){
+        fclose(file_list);
+    }
+
+    /* Copy every name of the list to the arena of the names */
+    for (word = text_list.text + strspn(text_list.text, SERVER_SEPARATORS); *word != '\0';
+         word += strspn(word, SERVER_SEPARATORS)) {
+        length = strcspn(word, SERVER_SEPARATORS);
+        name_file = (char *) alloc_from_arena(&options->arena_names, length + 1);
+        memcpy(name_file, word, length);
+        name_file[length] = '\0';
+        add_name_file(options, name_file);
+        word += length;
+    }
+    free_buffer(&text_list);
+    return TRUE;
+}
+
+void free_options(ptr_options options){
+    free(options->name_files);
+    free_arena(&options->arena_names);
+    options->name_files = NULL;
+    options->count_files = 0;
+    options->size_names = 0;
+}
@@ -0,0 +1,150 @@
+/*
+ * Header: option_tool.h
+ * ---------------------
+ * This header file defines the options of the assembler and the function that reads them from the command line.
+ * The command line holds the names of the assembly files (without the '.as' extension) mixed with options:
+ *
+ *   @PATH   Read the names of the files from the list PATH (the names separated by white characters), or from the
+ *           standard input for '@-'. The names of the list take the place of the argument, so a list may be mixed
+ *           with other names and lists, and it is not bound by the length limit of the command line.
+ *   -j N    Assemble up to N files at the same time (default 1, at most 'MAX_COUNT_JOBS'). The console
+ *           messages of every file are still printed as one group, in the order of the command line.
+ *   --am    Also write the source after the pre-assembly to the '.am' file (for debugging). Without it the
+ *           expanded source is only kept in memory. The file is not written if the macros have errors.
+ *   --binary
+ *           Also write the binary object file ('.obj', see 'binary_tool.h'): the words, the entries and the
+ *           external references in one file, in a fixed layout that a loader reads without parsing text.
+ *   --single-pass
+ *           Resolve the labels from the fixups recorded by the first pass instead of walking the source a second
+ *           time. The output files and the messages are the same as those of the two passes.
+ *   --chunks N
+ *           Split the first pass of a long file into up to N chunks of at least 'MIN_CHUNK_LINES' lines, read at
+ *           the same time and merged in their order (at most 'MAX_COUNT_JOBS'). A file with errors is read again by
+ *           one thread, so its messages are the same.
+ *   --stats Print the wall time of every phase and the counters of every file after its messages, and their sum
+ *           for the whole run (with its wall time and the peak RSS of the process) at the end.
+ *   --diagnostics FORMAT
+ *           Print the errors of every file in FORMAT: 'text' (the default), 'color' (the prefix of every error in red),
+ *           'json' or 'sarif' (one line per file, see 'print_list_diagnostic').
+ *   --max-errors N
+ *           Print at most N errors of every file (0, the default, prints them all). The number of errors left out is
+ *           still reported.
+ *   --cache DIR
+ *           Keep the outputs and the messages of every file in the directory DIR (created if needed), keyed on a
+ *           hash of its source. A file whose source did not change since it was cached is not assembled again.
+ *   --link NAME
+ *           Link the files of every job into one image: their code one after the other, then their data, with the
+ *           references to external labels completed from the entries of the other files ('link_modules'). The image
+ *           is written to 'NAME.ob' and its entry labels to 'NAME.ent'.
+ *   --stdio Read one source from the standard input and write its output files to the standard output, as one
+ *           framed stream ('write_output_stream'). The console messages are written to the standard error, and the
+ *           exit status is 1 if the source has errors. A name given on the command line names the source in the
+ *           messages and the stream.
+ *   --server
+ *           Stay running and read jobs from the standard input, one job per line: the names of the files of the job,
+ *           separated by white characters. The messages of every job are written to the standard output, followed
+ *           by the line 'SERVER_END_OF_JOB'. The other options apply to every job.
+ *   --socket PATH
+ *           As '--server', but the jobs are read from the clients of a Unix socket created at PATH (one client at a
+ *           time), and the messages of every job are written back to its client.
+ *
+ * Included Files:
+ *   - stdio.h: Standard Input/Output library. It provides functions for input and output operations, such as file handling.
+ *   - stdlib.h: Standard Library. It provides functions for memory allocation, conversion, and other utility functions.
+ *   - string.h: C String Library. It provides functions for manipulating strings, such as string copying and comparison.
+ *   - arena_tool.h: Contains the arena allocator that holds the names read from the lists of files.
+ *   - buffer_tool.h: Contains the growable text buffer a list of files is read into.
+ *   - diagnostic_list.h: Contains the formats in which the errors of a file are printed.
+ *   - setting.h: Contains constant definitions and configurations used throughout the assembly process.
+ */
+
+#ifndef OPTION_TOOL_H
+#define OPTION_TOOL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "arena_tool.h"
+#include "buffer_tool.h"
+#include "diagnostic_list.h"
+#include "setting.h"
+
+/*
+ * Struct: item_options
+ * --------------------
+ * A structure representing the options of one run of the assembler.
+ *
+ * Fields:
+ *   - count_jobs: The number of files assembled at the same time.
+ *   - count_chunks: The largest number of chunks the first pass of a file is split into, read at the same time.
+ *   - am_flag: A boolean flag indicating if the '.am' files are written.
+ *   - binary_flag: A boolean flag indicating if the '.obj' files are written.
+ *   - single_pass_flag: A boolean flag indicating if the files are assembled in the single-pass mode.
+ *   - stats_flag: A boolean flag indicating if the statistics are printed.
+ *   - diagnostics_format: The format in which the errors of every file are printed ('--diagnostics').
+ *   - max_errors: The largest number of errors printed for a file, or 0 to print them all ('--max-errors').
+ *   - cache_dir: The path of the cache directory (points into 'argv'), or NULL if the cache is not used.
+ *   - stdio_flag: A boolean flag indicating if the source is read from the standard input ('--stdio').
+ *   - server_flag: A boolean flag indicating if the assembler runs as a server ('--server' or '--socket').
+ *   - socket_path: The path of the Unix socket of the server (points into 'argv'), or NULL to read the jobs from the
+ *                  standard input.
+ *   - link_name: The name of the image the files of every job are linked into (points into 'argv'), or NULL if the
+ *                files are not linked ('--link', see 'link_tool.h').
+ *   - name_files: An array of pointers to the names of the files to be assembled, in the order of the command line
+ *                 (the names of a list of files take the place of its '@PATH' argument).
+ *   - count_files: The number of names in 'name_files'.
+ *   - size_names: The number of names 'name_files' has room for.
+ *   - arena_names: The arena holding the names read from the lists of files.
+ */
+typedef struct options_struct * ptr_options;
+typedef struct options_struct {
+    int count_jobs;
+    int count_chunks;
+    bool am_flag;
+    bool binary_flag;
+    bool single_pass_flag;
+    bool stats_flag;
+    diagnostics_format diagnostics_format;
+    int max_errors;
+    const char *cache_dir;
+    bool stdio_flag;
+    bool server_flag;
+    const char *socket_path;
+    char *link_name;
+    char **name_files;
+    int count_files;
+    int size_names;
+    item_arena arena_names;
+} item_options;
+
+/*
+ * Function: parse_options
+ * -----------------------
+ * Reads the options and the names of the files from the command line.
+ *
+ * Parameters:
+ *   - options: A pointer to the options to be filled.
+ *   - argc: The number of command-line arguments, including the program name itself.
+ *   - argv: An array of pointers to strings, where each element represents a command-line argument.
+ *
+ * Returns:
+ *   - bool: TRUE if the command line is valid, FALSE otherwise (an error message is printed to stderr).
+ *
+ * Notes:
+ *   - The names of the files point into 'argv', or into the arena of the names for the names read from a list of
+ *     files; the array holding them and the arena are released by 'free_options'.
+ *   - The number of jobs may be given as a separate argument ("-j 4") or attached to the option ("-j4").
+ */
+bool parse_options(ptr_options options, int argc, char **argv);
+
+/*
+ * Function: free_options
+ * ----------------------
+ * Frees the memory allocated by 'parse_options'.
+ *
+ * Parameters:
+ *   - options: A pointer to the options to be freed.
+ */
+void free_options(ptr_options options);
+
+#endif /* OPTION_TOOL_H */
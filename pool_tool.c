@@ -0,0 +1,102 @@
+#include "pool_tool.h"
+
+/*
+ * Function: worker_of_pool
+ * ------------------------
+ * The main function of a worker thread: takes the next task of the pool and runs it, until no task is left.
+ *
+ * Parameters:
+ *   - pool: A pointer to the pool (item_pool).
+ *
+ * Returns:
+ *   - void*: Always NULL.
+ */
+static void * worker_of_pool(void *pool);
+
+void run_tasks(int count_tasks, int count_jobs, task_function run_task, task_function end_task, void *context){
+    item_pool pool;
+    pthread_t *workers;
+    int i;
+
+    /* Without parallelism run every task and consume its result right away. */
+    if (count_jobs <= 1 || count_tasks <= 1){
+        for (i = 0; i < count_tasks; i++){
+            run_task(i, context);
+            if (end_task != NULL){
+                end_task(i, context);
+            }
+        }
+        return;
+    }
+    if (count_jobs > count_tasks){
+        count_jobs = count_tasks;
+    }
+
+    pool.count_tasks = count_tasks;
+    pool.next_task = 0;
+    pool.run_task = run_task;
+    pool.context = context;
+    pool.done_tasks = (bool *)malloc(sizeof(bool) * (size_t) count_tasks);
+    workers = (pthread_t *)malloc(sizeof(pthread_t) * (size_t) count_jobs);
+    if (pool.done_tasks == NULL || workers == NULL){
+        fprintf(stderr, "Error in dynamic memory allocation");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < count_tasks; i++){
+        pool.done_tasks[i] = FALSE;
+    }
+    pthread_mutex_init(&pool.lock, NULL);
+    pthread_cond_init(&pool.task_done, NULL);
+
+    /* Start the workers. */
+    for (i = 0; i < count_jobs; i++){
+        if (pthread_create(&workers[i], NULL, worker_of_pool, &pool) != 0){
+            fprintf(stderr, "Error in creating a worker thread");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    /* Consume the results in the order of the tasks, waiting for every task to be done. */
+    for (i = 0; i < count_tasks; i++){
+        pthread_mutex_lock(&pool.lock);
+        while (pool.done_tasks[i] == FALSE){
+            pthread_cond_wait(&pool.task_done, &pool.lock);
+        }
+        pthread_mutex_unlock(&pool.lock);
+        if (end_task != NULL){
+            end_task(i, context);
+        }
+    }
+
+    /* Wait for the workers to finish and release the pool. */
+    for (i = 0; i < count_jobs; i++){
+        pthread_join(workers[i], NULL);
+    }
+    pthread_cond_destroy(&pool.task_done);
+    pthread_mutex_destroy(&pool.lock);
+    free(workers);
+    free(pool.done_tasks);
+}
+
+static void * worker_of_pool(void *pool){
+    ptr_pool temp_pool = (ptr_pool) pool;
+    int task;
+
+    while (1){
+        /* Take the next task of the pool. */
+        pthread_mutex_lock(&temp_pool->lock);
+        task = (temp_pool->next_task)++;
+        pthread_mutex_unlock(&temp_pool->lock);
+        if (task >= temp_pool->count_tasks){
+            return NULL;
+        }
+
+        temp_pool->run_task(task, temp_pool->context);
+
+        /* Mark the task as done and wake up the thread consuming the results. */
+        pthread_mutex_lock(&temp_pool->lock);
+        temp_pool->done_tasks[task] = TRUE;
+        pthread_cond_broadcast(&temp_pool->task_done);
+        pthread_mutex_unlock(&temp_pool->lock);
+    }
+}
@@ -0,0 +1,75 @@
+/*
+ * Header: pool_tool.h
+ * -------------------
+ * This header file declares a small pool of worker threads used to run independent tasks (the assembly of one file)
+ * at the same time, while the results of the tasks are still consumed one by one in the order of the tasks.
+ *
+ * Included Files:
+ *   - stdio.h: Standard Input/Output library. It provides functions for input and output operations, such as file handling.
+ *   - stdlib.h: Standard Library. It provides functions for memory allocation, conversion, and other utility functions.
+ *   - pthread.h: POSIX Threads library. It provides the threads, mutexes and condition variables of the pool.
+ *   - setting.h: Contains constant definitions and configurations used throughout the assembly process.
+ */
+
+#ifndef POOL_TOOL_H
+#define POOL_TOOL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "setting.h"
+
+/*
+ * Type: task_function
+ * -------------------
+ * A function that handles the task number 'index' of a pool. The 'context' is the pointer given to 'run_tasks'.
+ */
+typedef void (*task_function)(int index, void *context);
+
+/*
+ * Struct: item_pool
+ * -----------------
+ * The state shared by the worker threads of a pool.
+ *
+ * Fields:
+ *   - count_tasks: The number of tasks of the pool.
+ *   - next_task: The number of the next task to be handed to a worker.
+ *   - done_tasks: An array of 'count_tasks' flags set to TRUE when the task is done.
+ *   - run_task: The function that runs a task.
+ *   - context: The pointer passed to the task functions.
+ *   - lock: The mutex guarding 'next_task' and 'done_tasks'.
+ *   - task_done: The condition signaled every time a task is done.
+ */
+typedef struct pool_struct * ptr_pool;
+typedef struct pool_struct {
+    int count_tasks;
+    int next_task;
+    bool *done_tasks;
+    task_function run_task;
+    void *context;
+    pthread_mutex_t lock;
+    pthread_cond_t task_done;
+} item_pool;
+
+/*
+ * Function: run_tasks
+ * -------------------
+ * Runs 'count_tasks' tasks on a pool of 'count_jobs' worker threads.
+ *
+ * Parameters:
+ *   - count_tasks: The number of tasks, numbered from 0 to 'count_tasks' - 1.
+ *   - count_jobs: The number of worker threads. With one job (or less) the tasks are run on the calling thread.
+ *   - run_task: The function that runs a task. It is called on a worker thread, so it must not touch state
+ *               shared with other tasks.
+ *   - end_task: The function that consumes the result of a task, or NULL. It is called on the calling thread,
+ *               in the order of the tasks, as soon as the task and all the tasks before it are done.
+ *   - context: A pointer passed to 'run_task' and 'end_task'.
+ *
+ * Notes:
+ *   - The tasks are handed to the workers in their order, so the first tasks are done first.
+ *   - The function returns after all the tasks are done and consumed and all the workers have finished.
+ *   - If a thread cannot be created, the function prints an error message to stderr and exits the program.
+ */
+void run_tasks(int count_tasks, int count_jobs, task_function run_task, task_function end_task, void *context);
+
+#endif /* POOL_TOOL_H */
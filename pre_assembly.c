@@ -1,53 +1,5 @@
 #include "pre_assembly.h"
 
-/*
- * Static variable: curr_macro_text
- * -------------------------------
- * An array of characters used to store the current text or content associated with a macro.
- * The 'curr_macro_text' array has a maximum size of 'MAX_CHARACTERS_ASSEMBLY_FILE'.
- * During the pre-assembly process, this variable is used to accumulate the lines of text that
- * make up the body of a macro being defined.
- */
-static char curr_macro_text[MAX_CHARACTERS_ASSEMBLY_FILE];
-
-/*
- * Static variable: curr_macro_name
- * -------------------------------
- * An array of characters used to store the name of the current macro being defined.
- * The 'curr_macro_name' array has a maximum size of 'MAX_ASSEMBLY_LINE_LENGTH'.
- * During the pre-assembly process, this variable is updated with the name of a macro when the
- * 'START_MACRO' directive is encountered in the assembly code.
- */
-static char curr_macro_name[MAX_ASSEMBLY_LINE_LENGTH];
-
-/*
- * Static variable: macro_flag
- * ---------------------------
- * A boolean variable that acts as a flag during the pre-assembly process to indicate whether the
- * current code is inside a macro definition.
- * When 'macro_flag' is set to TRUE, it means that the pre-assembly is currently processing the
- * lines of a macro. When it is FALSE, the pre-assembly is processing regular assembly code lines.
- */
-static bool macro_flag;
-
-/*
- * Global variable: temp_head_macro_list
- * ------------------------------------
- * A pointer to the head of the linked list of macros used during the pre-assembly process.
- * The 'temp_head_macro_list' points to the first node in the linked list of 'item_macro' representing
- * the macros defined in the assembly code.
- * This variable is used to traverse the list of macros and perform operations related to macro processing.
- */
-ptr_macro temp_head_macro_list;
-
-/*
- * Static variable: sfile
- * ----------------------
- * A pointer to the 'file' struct representing the current assembly source file being processed in
- * the pre-assembly stage.
- */
-static ptr_file sfile;
-
 /*
  * Function: pre_assembly_on_curr_file
  * ----------------------------------
@@ -58,31 +10,38 @@ static ptr_file sfile;
  * in each line. The pre-assembly process includes identifying macro definitions, expanding macros, and generating
  * the intermediate file with macro-expanded code and macro definitions.
  */
-static void pre_assembly_on_curr_file();
+static void pre_assembly_on_curr_file(ptr_file sfile);
 
 /*
  * Function: update_files
  * ----------------------
  * Update files for pre-assembly processing.
  *
- * This function updates the files required for the pre-assembly process. It opens the intermediate file with the '.am' extension
- * for writing the pre-assembled code. The intermediate file will store the expanded code with macros replaced.
+ * This function updates the files required for the pre-assembly process. The expanded code (with macros replaced) is kept
+ * in the 'text_am' buffer of the file, which both passes read directly. No file is opened for it: if the '.am' file was
+ * requested ('am_flag'), the whole buffer is written at once at the end of the pre-assembly ('write_file_of_struct'),
+ * and only if the pre-assembly found no error.
+ *
+ * The whole source file is read into the 'text_as' buffer at once ('read_file_to_buffer') and the file is closed, so the
+ * lines are then taken from memory instead of one stdio call for each line. A source the caller already read (the
+ * cache reads it for its key) is set in 'source' and is not read again.
  */
-static void update_files();
+static void update_files(ptr_file sfile);
 
 /*
  * Function: update_next_line
  * --------------------------
  * Update the next line of code from the source assembly file.
  *
- * This function reads the next line of code from the source assembly file and stores it in the 'line_text' array of the
- * 'sfile' structure. The 'line_text' array will hold the text of the current line being processed during pre-assembly.
+ * This function reads the next line of code from the source kept in memory ('source') and stores it in the 'line_text'
+ * array of the 'sfile' structure. The 'line_text' array will hold the text of the current line being processed during
+ * pre-assembly. The line is found with 'memchr' and split exactly as 'fgets' would split it ('read_line_of_buffer').
  *
  * Returns:
  *   char*: A pointer to the 'line_text' array, which holds the text of the next line of code read from the source file.
- *          If the end of the file is reached or an error occurs during reading, the function returns NULL.
+ *          If the end of the source is reached, the function returns NULL.
  */
-static char * update_next_line();
+static char * update_next_line(ptr_file sfile);
 
 /*
  * Function: update_line_to_array
@@ -90,11 +49,11 @@ static char * update_next_line();
  * Update the current line of code from 'line_text' to a structured line representation.
  *
  * This function creates a new structured line representation for the current line of code stored in the 'line_text' array
- * of the 'sfile' structure. The structured line representation is created using the 'create_new_line_struct' function,
+ * of the 'sfile' structure. The structured line representation is filled using the 'split_line_to_words' function,
  * which extracts individual words (tokens) from the line and organizes them into a structured format. The structured line
  * representation is stored in the 'line_struct' field of the 'sfile' structure.
  */
-static void update_line_to_array();
+static void update_line_to_array(ptr_file sfile);
 
 /*
  * Function: get_first_word_status
@@ -102,9 +61,9 @@ static void update_line_to_array();
  * Get the status of the first word in the current line of code.
  *
  * This function examines the first word (token) in the structured representation of the current line of code,
- * which is stored in the 'sfile->line_struct->word1' field. It determines the status of the first word based
+ * which is stored in the 'WORD_OF_LINE(&sfile->line_struct, 1)' field. It determines the status of the first word based
  * on the following conditions:
- *   - If the first word matches the name of an existing macro in the macro list ('head_macro_list'), the function
+ *   - If the first word matches the name of an existing macro in the macro table ('macro_table'), the function
  *     returns 'STATUS_MACRO_NAME' to indicate that the line contains the name of an existing macro.
  *   - If the first word matches the predefined 'START_MACRO' string, the function checks if there is an ongoing
  *     macro definition (indicated by the 'macro_flag' being TRUE). If a macro definition is already in progress,
@@ -120,7 +79,7 @@ static void update_line_to_array();
  * Returns:
  *   first_word_status: An enumerated value representing the status of the first word in the current line of code.
  */
-static first_word_status get_first_word_status();
+static first_word_status get_first_word_status(ptr_file sfile);
 
 /*
  * Function: action_by_status
@@ -136,7 +95,7 @@ static first_word_status get_first_word_status();
  *   status (first_word_status): The status of the first word in the current line of code, which indicates the type
  *                               of code in the line.
  */
-static void action_by_status(first_word_status status);
+static void action_by_status(ptr_file sfile, first_word_status status);
 
 /*
  * Function: add_error
@@ -144,13 +103,15 @@ static void action_by_status(first_word_status status);
  * Add an error to the pre-assembly process and update the error status of the current file.
  *
  * This function is responsible for adding an error with the specified 'error_code' to the pre-assembly process.
- * It calls the 'print_error' function to display the error message associated with the 'error_code' and the current line number.
+ * It records the error with the current line number in the list of diagnostics of the file ('add_to_list_diagnostic'), which is
+ * printed once with the result of the file.
  * Additionally, it sets the 'error_flag' of the current file ('sfile') to TRUE to indicate that an error has occurred in the assembly process.
  *
  * Parameters:
  *   error_code (error_code): The error code indicating the type of error encountered during the pre-assembly process.
+ *   column (int): The column of the error in the line, from 1 (0 if the error refers to the whole line).
  */
-static void add_error(error_code error_code);
+static void add_error(ptr_file sfile, error_code error_code, int column);
 
 /*
  * Function: update_error_status
@@ -163,30 +124,41 @@ static void add_error(error_code error_code);
  *
  * Parameters:
  *   error_code (error_code): The error code indicating the type of error encountered during the pre-assembly process.
+ *   column (int): The column of the error in the line, from 1 (0 if the error refers to the whole line).
  *
  * Notes:
  *   - This function is used to manage error status during the pre-assembly process.
  *   - It is typically called when an operation returns an error code.
  *   - If the 'error_code' is not equal to 'NO_ERROR', the 'add_error' function is called to handle the error.
  */
-static void update_error_status(error_code error_code);
+static void update_error_status(ptr_file sfile, error_code error_code, int column);
+
+/*
+ * Function: paste_text
+ * --------------------
+ * Paste text at the end of the expanded code.
+ *
+ * This function appends 'length' characters of 'text' to the 'text_am' buffer of the file, which is also the text of the
+ * '.am' file.
+ */
+static void paste_text(ptr_file sfile, const char *text, size_t length);
 
 /*
  * Function: paste_macro_text
  * --------------------------
- * Paste the text of the current macro at the end of the macro file.
+ * Paste the text of the current macro at the end of the expanded code.
  *
- * This function is responsible for appending the text of the current macro ('temp_head_macro_list->text_macro')
- * to the end of the macro file ('sfile->file_am'). It seeks to the end of the file using 'fseek' with 'SEEK_END'
- * as the origin, and then writes the macro text to the file using 'fputs'.
+ * This function is responsible for appending the body of the current macro ('curr_macro') to the end of
+ * the expanded code, by calling 'paste_text' with the slice of the body, straight from the text buffer of the macro table.
  *
  * Notes:
  *   - This function is called when the pre-assembly process encounters a line of code that is part of a defined macro.
- *   - It appends the text of the macro to the macro file so that it can be used during the assembly process.
- *   - The 'temp_head_macro_list' points to the current macro being processed during the pre-assembly.
- *   - The 'file_am' is the file where the macro text is stored during the pre-assembly process.
+ *   - It appends the text of the macro to the expanded code so that it can be used during the assembly process.
+ *   - The 'curr_macro' points to the current macro being processed during the pre-assembly.
+ *   - The records of the lines of the body, split when the macro was defined, are added to the line index of the file
+ *     ('line_index'), so the passes do not split the lines of the body again for every call.
  */
-static void paste_macro_text();
+static void paste_macro_text(ptr_file sfile);
 
 /*
  * Function: update_name_of_macro
@@ -195,23 +167,23 @@ static void paste_macro_text();
  *
  * This function is called when the pre-assembly process encounters the "START_MACRO" directive,
  * indicating the start of a new macro definition. It updates the name of the current macro ('curr_macro_name')
- * based on the second word of the current line in the assembly file ('sfile->line_struct->word2').
+ * based on the second word of the current line in the assembly file ('WORD_OF_LINE(&sfile->line_struct, 2)').
  * Additionally, it sets the 'macro_flag' to TRUE, indicating that the pre-assembly process is currently
  * inside a macro definition.
  */
-static void update_name_of_macro();
+static void update_name_of_macro(ptr_file sfile);
 
 /*
  * Function: add_new_macro_to_list
  * ------------------------------
- * Add the current macro to the linked list of macros.
+ * Add the current macro to the macro table.
  *
  * This function is called when the pre-assembly process encounters the "END_MACRO" directive,
  * indicating the end of a macro definition. It adds the current macro, represented by 'curr_macro_name'
- * (the name) and 'curr_macro_text' (the text or content), to the linked list of macros associated with
- * the current file ('sfile->head_macro_list').
+ * (the name) and the text appended since the start of the definition, to the macro table of the current file
+ * ('sfile->macro_table'). If the name is a reserved word, the appended text is discarded.
  */
-static void add_new_macro_to_list();
+static void add_new_macro_to_list(ptr_file sfile);
 
 /*
  * Function: add_text_to_macro
@@ -220,21 +192,21 @@ static void add_new_macro_to_list();
  *
  * This function is called when the pre-assembly process is inside a macro definition (indicated by 'macro_flag'
  * being TRUE), and it encounters lines of text that are part of the macro content. The function appends the text
- * of the current line ('sfile->line_text') to the text of the current macro being defined ('curr_macro_text').
+ * of the current line ('sfile->line_text') to the pending body in the text buffer of the macro table ('sfile->macro_table').
  */
-static void add_text_to_macro();
+static void add_text_to_macro(ptr_file sfile);
 
 /*
  * Function: paste_code_text
  * -------------------------
- * Pastes the current line of code text to the output assembly file (file_am).
+ * Pastes the current line of code text to the expanded code (text_am).
  *
  * This function is called when the pre-assembly process is outside of a macro definition (indicated by 'macro_flag'
  * being FALSE) and encounters lines of code text that are not part of any macro definition. The function pastes
- * the current line of code ('sfile->line_text') directly to the output assembly file ('file_am'), which represents
- * the pre-assembled assembly file without macros.
+ * the current line of code ('sfile->line_text') directly to the expanded code ('text_am', using 'paste_text'),
+ * which represents the pre-assembled assembly file without macros.
  */
-static void paste_code_text();
+static void paste_code_text(ptr_file sfile);
 
 /*
  * Function: print_end_of_pre_assembly
@@ -244,7 +216,8 @@ static void paste_code_text();
  * This function is called after the pre-assembly process has finished processing all lines in the input assembly file.
  * If no errors were encountered during the pre-assembly process (indicated by 'sfile->error_flag' being FALSE),
  * the function prints a completion message along with the total number of macros found during the process.
- * If errors were encountered during pre-assembly, the function does not print anything.
+ * If errors were encountered during pre-assembly, or the diagnostics are printed in JSON or SARIF, the function does
+ * not print anything.
  *
  * Parameters:
  *   None
@@ -260,91 +233,116 @@ static void paste_code_text();
  *     using 'printf' to indicate that the pre-assembly process has been successfully completed and displays the total number of
  *     macros found ('count_macro').
  *   - If errors were encountered during pre-assembly (i.e., 'error_flag' is TRUE), the function does not print anything.
- *   - The completion message is printed to the console, assuming that the standard output is connected to the console.
+ *   - The completion message is printed to the console messages of the file ('file_log').
  *   - This function is specific to providing a user-friendly completion message for the pre-assembly process and does not affect
  *     the pre-assembly output files.
  */
-static void print_end_of_pre_assembly();
+static void print_end_of_pre_assembly(ptr_file sfile);
 
 void start_pre_assembly(ptr_file file_struct){
-    sfile = file_struct;
-    pre_assembly_on_curr_file();
+    double start = get_time_now();
+
+    pre_assembly_on_curr_file(file_struct);
+    add_time_of_phase(&file_struct->stats, PHASE_PRE_ASSEMBLY, start);
 }
 
-static void pre_assembly_on_curr_file() {
+static void pre_assembly_on_curr_file(ptr_file sfile) {
+    char full_name[MAX_FULL_FILE_NAME_LENGTH];
     first_word_status status;
 
     /* Set the macro_flag to FALSE initially, indicating not inside a macro definition. */
-    macro_flag = FALSE;
+    sfile->macro_flag = FALSE;
 
-    /* Open the intermediate file with '.am' extension for writing pre-assembled code. */
-    update_files();
+    /* Read the source file into memory. */
+    update_files(sfile);
 
     /* Process each line of the source file until the end of the file is reached. */
-    while(update_next_line() != NULL){
+    while(update_next_line(sfile) != NULL){
         /* Increment the count of processed lines. */
         (sfile->count_line)++;
 
         /* Convert the current line to a line structure for easy access to individual words and information. */
-        update_line_to_array();
+        update_line_to_array(sfile);
 
         /* Determine the status of the first word in the line (e.g., macro name, macro start, macro end, or code text). */
-        status = get_first_word_status();
+        status = get_first_word_status(sfile);
 
         /* Based on the status, perform the appropriate action for the line. */
-        action_by_status(status);
-
-        /* Free the 'line_struct' representing the current line to release allocated memory (prevent memory leaks). */
-        free_line(sfile->line_struct);
+        action_by_status(sfile, status);
+    }
+    /* Keep the counters of the source and of the macro table for the statistics. */
+    sfile->stats.count_lines = sfile->count_line;
+    sfile->stats.count_probes += sfile->macro_table.count_probe;
+
+    /* Free the macro table ('macro_table') and the source, which are not used by the passes. */
+    free_list_macro(&sfile->macro_table);
+    free_buffer(&sfile->text_as);
+    sfile->source = NULL;
+
+    /* The '.am' file (if requested) is written at once, and only if the expansion succeeded; the '.am' file of an earlier
+     * run is removed otherwise, so no '.am' file is left for a source whose macros have errors. */
+    if (sfile->am_flag == TRUE){
+        if (sfile->error_flag == FALSE){
+            if (write_file_of_struct(sfile, EXT_MACRO, sfile->text_am.text, sfile->text_am.length) == TRUE){
+                sfile->stats.bytes_written += (long) sfile->text_am.length;
+            }
+        } else if (sfile->memory_flag == FALSE){
+            remove(get_file_with_extension(sfile->name_file, EXT_MACRO, full_name));
+        }
     }
-    /* Free the linked list of macros ('head_macro_list') to release allocated memory used for storing macro information. */
-    free_list_macro(&sfile->head_macro_list);
 
     /* Print a message indicating the successful completion of the pre-assembly process and the number of macros found and expanded. */
-    print_end_of_pre_assembly();
+    print_end_of_pre_assembly(sfile);
 }
 
-static void update_files(){
-    /* Open the intermediate file with '.am' extension for writing pre-assembled code. */
-    sfile->file_am = open_file(sfile->name_file, EXT_MACRO,"w");
+static void update_files(ptr_file sfile){
+    /* Read the whole source file at once and close it, unless the caller already read it. */
+    if (sfile->source == NULL){
+        read_file_to_buffer(&sfile->text_as, sfile->file_as);
+        fclose(sfile->file_as);
+        sfile->file_as = NULL;
+        sfile->source = &sfile->text_as;
+    }
+    sfile->pos_in_as = 0;
+    sfile->stats.bytes_read = (long) sfile->source->length;
 }
 
-static char * update_next_line(){
-    /* Read the next line of code from the source assembly file and store it in 'line_text' array. */
-    return fgets(sfile->line_text,sizeof (sfile->line_text),sfile->file_as);
+static char * update_next_line(ptr_file sfile){
+    /* Read the next line of code from the source kept in memory and store it in 'line_text' array. */
+    return read_line_of_buffer(sfile->source, &sfile->pos_in_as, sfile->line_text, sizeof (sfile->line_text));
 }
 
-static void update_line_to_array(){
+static void update_line_to_array(ptr_file sfile){
     /* Create a structured line representation for the current line of code from 'line_text'. */
-    sfile->line_struct = create_new_line_struct(sfile->line_text);
+    split_line_to_words(&sfile->line_struct, sfile->line_text);
 }
 
-static first_word_status get_first_word_status(){
+static first_word_status get_first_word_status(ptr_file sfile){
 
-    /* Check if the first word matches the name of an existing macro in the macro list. */
-    temp_head_macro_list = search_in_list_macro(sfile->head_macro_list,sfile->line_struct->word1);
-    if (temp_head_macro_list){
+    /* Check if the first word matches the name of an existing macro in the macro table. */
+    sfile->curr_macro = search_in_list_macro(&sfile->macro_table,WORD_OF_LINE(&sfile->line_struct, 1));
+    if (sfile->curr_macro){
         return STATUS_MACRO_NAME;
     }
 
     /* Check if the first word is the predefined 'START_MACRO'. */
-    if (strcmp(sfile->line_struct->word1, START_MACRO) == 0){
+    if (strcmp(WORD_OF_LINE(&sfile->line_struct, 1), START_MACRO) == 0){
         /* If there is an ongoing macro definition, report an error (NESTED_MACRO_DEFINITION). */
-        if (macro_flag == TRUE){
-            add_error(NESTED_MACRO_DEFINITION);
+        if (sfile->macro_flag == TRUE){
+            add_error(sfile, NESTED_MACRO_DEFINITION, COLUMN_OF_LINE(&sfile->line_struct, 1));
         }
         /* Return 'STATUS_MCRO' to indicate the start of a new macro definition. */
         return STATUS_MCRO;
     }
 
     /* Check if the first word is the predefined 'END_MACRO'. */
-    if (strcmp(sfile->line_struct->word1, END_MACRO) == 0){
+    if (strcmp(WORD_OF_LINE(&sfile->line_struct, 1), END_MACRO) == 0){
         /* Return 'STATUS_ENDMCRO' to indicate the end of a macro definition. */
         return STATUS_ENDMCRO;
     }
 
     /* If 'macro_flag' is TRUE, the current line is part of a macro definition. */
-    if(macro_flag == TRUE){
+    if(sfile->macro_flag == TRUE){
         /* Return 'STATUS_TEXT_OF_MACRO' to indicate that the line contains text belonging to the macro being defined. */
         return STATUS_TEXT_OF_MACRO;
     }
@@ -353,34 +351,34 @@ static first_word_status get_first_word_status(){
     return STATUS_TEXT_OF_CODE;
 }
 
-static void action_by_status(first_word_status status){
+static void action_by_status(ptr_file sfile, first_word_status status){
     switch (status) {
         case STATUS_MACRO_NAME:
             /* Call 'paste_macro_text' to paste the content of an existing macro into the assembly file. */
-            paste_macro_text();
+            paste_macro_text(sfile);
             break;
         case STATUS_MCRO:
             /* Call 'update_name_of_macro' to update the name of the macro currently being defined. */
-            update_name_of_macro();
+            update_name_of_macro(sfile);
             break;
         case STATUS_ENDMCRO:
-            /* Call 'add_new_macro_to_list' to add a new macro (including its name and text) to the macro list. */
-            add_new_macro_to_list();
+            /* Call 'add_new_macro_to_list' to add a new macro (including its name and text) to the macro table. */
+            add_new_macro_to_list(sfile);
             break;
         case STATUS_TEXT_OF_MACRO:
             /* Call 'add_text_to_macro' to add the current line's text to the text of the macro being defined. */
-            add_text_to_macro();
+            add_text_to_macro(sfile);
             break;
         case STATUS_TEXT_OF_CODE:
             /* Call 'paste_code_text' to paste the current line's text into the assembly file as regular code text. */
-            paste_code_text();
+            paste_code_text(sfile);
             break;
     }
 }
 
-static void add_error(error_code error_code){
-    /* Call 'print_error' to display the error message associated with the 'error_code' and the current line number. */
-    print_error(error_code,sfile->count_line);
+static void add_error(ptr_file sfile, error_code error_code, int column){
+    /* Record the error with the current line number and its column; it is printed with the result of the file. */
+    add_to_list_diagnostic(&sfile->diagnostic_list, error_code, sfile->count_line, column);
 
     /* Set the 'error_flag' of the current file ('sfile') to TRUE to indicate that an error has occurred. */
     sfile->error_flag = TRUE;
@@ -389,65 +387,81 @@ static void add_error(error_code error_code){
     (sfile->count_error)++;
 }
 
-static void update_error_status(error_code error_code){
+static void update_error_status(ptr_file sfile, error_code error_code, int column){
     /* Check if the 'error_code' is not equal to 'NO_ERROR'. If it is not 'NO_ERROR', handle the error using 'add_error'. */
     if (error_code != NO_ERROR){
         /* Call 'add_error' to handle the error and update the error status of the current file ('sfile'). */
-        add_error(error_code);
+        add_error(sfile, error_code, column);
     }
 }
 
-static void paste_macro_text(){
-    /* Seek to the end of the macro file ('sfile->file_am') using 'fseek'. */
-    fseek(sfile->file_am, 0, SEEK_END);
+static void paste_text(ptr_file sfile, const char *text, size_t length){
+    /* Append the text to the expanded code read by the passes. */
+    append_to_buffer(&sfile->text_am, text, length);
+}
+
+static void paste_macro_text(ptr_file sfile){
+    ptr_line *lines = get_lines_of_macro(&sfile->macro_table, sfile->curr_macro);
+    int i;
 
-    /* Write the text of the current macro ('temp_head_macro_list->text_macro') to the end of the macro file using 'fputs'. */
-    fputs(temp_head_macro_list->text_macro, sfile->file_am);
+    (sfile->stats.count_macro_calls)++;
+
+    /* Paste the body of the current macro ('curr_macro') at the end of the expanded code. */
+    paste_text(sfile, get_text_of_macro(&sfile->macro_table, sfile->curr_macro), sfile->curr_macro->length_text);
+
+    /* The lines of the body were split when the macro was defined, so the passes take their records. */
+    for (i = 0; i < sfile->curr_macro->count_lines; i++){
+        add_to_line_index(&sfile->line_index, lines[i]);
+    }
 }
 
-static void update_name_of_macro() {
+static void update_name_of_macro(ptr_file sfile) {
     /* Set 'macro_flag' to TRUE to indicate that the pre-assembly process is currently inside a macro definition. */
-    macro_flag = TRUE;
+    sfile->macro_flag = TRUE;
 
     /* Update the name of the current macro ('curr_macro_name') with the second word of the current line in the assembly file. */
-    strcpy(curr_macro_name, sfile->line_struct->word2);
+    strcpy(sfile->curr_macro_name, WORD_OF_LINE(&sfile->line_struct, 2));
 }
 
-static void add_new_macro_to_list(){
+static void add_new_macro_to_list(ptr_file sfile){
     /* Set 'macro_flag' to FALSE to indicate that the pre-assembly process is not inside a macro definition. */
-    macro_flag = FALSE;
+    sfile->macro_flag = FALSE;
 
     /* Increment the macro count to track the number of macros found in the file. */
     (sfile->count_macro)++;
 
     /* Check if the current macro name is a reserved word or not. */
-    if (is_name_a_reserved_word(curr_macro_name) == FALSE){
-        /* The current macro name is not a reserved word, so add the macro to the linked list. */
-        update_error_status(add_to_list_macro(&sfile->head_macro_list, curr_macro_name, curr_macro_text));
+    if (is_name_a_reserved_word(sfile->curr_macro_name) == FALSE){
+        /* The current macro name is not a reserved word, so add the macro to the macro table. */
+        update_error_status(sfile, add_to_list_macro(&sfile->macro_table, sfile->curr_macro_name),
+                            COLUMN_OF_LINE(&sfile->line_struct, 1));
     } else {
-        /* The current macro name is a reserved word, so add an error to the error list. */
-        add_error(MACRO_NAME_IS_INSTRUCTION_OR_DIRECTIVE);
+        /* The current macro name is a reserved word, so discard its text and add an error to the error list. */
+        discard_text_of_macro(&sfile->macro_table);
+        add_error(sfile, MACRO_NAME_IS_INSTRUCTION_OR_DIRECTIVE, COLUMN_OF_LINE(&sfile->line_struct, 1));
     }
 
-    /* Clear the 'curr_macro_text' and 'curr_macro_name' arrays for the next macro definition. */
-    memset(curr_macro_text, 0, sizeof(curr_macro_text));
-    memset(curr_macro_name, 0, sizeof(curr_macro_name));
+    /* Clear the 'curr_macro_name' string for the next macro definition (ending it at its first character is enough). */
+    sfile->curr_macro_name[0] = '\0';
 }
 
-static void add_text_to_macro(){
-    /* Concatenate the text of the current line to the text of the current macro being defined. */
-    strcat(curr_macro_text, sfile->line_text);
+static void add_text_to_macro(ptr_file sfile){
+    /* Append the text of the current line to the body of the current macro being defined. */
+    append_text_to_macro(&sfile->macro_table, sfile->line_text, &sfile->line_struct);
 }
 
-static void paste_code_text(){
-    /* Pastes the current line of code text to the output assembly file (file_am). */
-    fseek(sfile->file_am, 0, SEEK_END);
-    fputs(sfile->line_text, sfile->file_am);
+static void paste_code_text(ptr_file sfile){
+    /* Pastes the current line of code text to the expanded code (text_am). */
+    paste_text(sfile, sfile->line_text, strlen(sfile->line_text));
+
+    /* The line has no record in the line index, the passes split it themselves. */
+    add_to_line_index(&sfile->line_index, NULL);
 }
 
-static void print_end_of_pre_assembly(){
-    /* Print the completion message for the pre-assembly process if no errors were encountered. */
-    if (sfile->error_flag == FALSE){
-        printf("The pre-assembly process has been successfully completed. %d macro found.\n",sfile->count_macro);
+static void print_end_of_pre_assembly(ptr_file sfile){
+    /* Print the completion message for the pre-assembly process if no errors were encountered (not in the JSON and
+     * SARIF formats, whose messages hold only the diagnostics). */
+    if (sfile->error_flag == FALSE && is_structured_format(sfile->diagnostics_format) == FALSE){
+        fprintf(sfile->file_log, "The pre-assembly process has been successfully completed. %d macro found.\n",sfile->count_macro);
     }
 }
\ No newline at end of file
@@ -83,11 +83,11 @@ typedef enum {
  * Parameters:
  *   file_struct (ptr_file): A pointer to the 'file' struct representing the current assembly source file.
  *                           The 'file_struct' contains information about the source file, such as the file streams,
- *                           line structures, and the linked list of macros defined in the file.
+ *                           line structures, and the table of macros defined in the file.
  *
  * Notes:
- *   - The function updates the static global variable 'sfile' with the 'file_struct' pointer, allowing other functions
- *     within the 'pre_assembly.c' file to access and modify information related to the source file being processed.
+ *   - The 'file_struct' is passed down to every function within the 'pre_assembly.c' file (as 'sfile'), so files
+ *     processed concurrently do not share any state.
  */
 void start_pre_assembly(ptr_file file_struct);
 
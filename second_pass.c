@@ -1,20 +1,5 @@
 #include "second_pass.h"
 
-/*
- * Static variable: sfile
- * ----------------------
- * A pointer to the 'file' struct representing the current assembly source file being processed in
- * the second pass stage.
- */
-static ptr_file sfile;
-
-/*
- * Static variable: extern_list
- * -------------------------------
- * A character array to store a list of external labels that need to be resolved by the linker in the second pass of the assembly process.
- */
-static char extern_list[MAX_CHARACTERS_ASSEMBLY_FILE];
-
 /*
  * Function: second_pass_on_curr_file
  * ----------------------------------
@@ -22,8 +7,8 @@ static char extern_list[MAX_CHARACTERS_ASSEMBLY_FILE];
  *
  * This function is responsible for executing the second pass of the assembly process on the provided assembly source file.
  * It reads the file line by line, skipping empty lines and processing valid lines containing assembly instructions and data.
- * The second pass handles instructions and data sections, generates the final machine code, and creates the output file with
- * the assembled machine code and the list of external labels encountered during the pass.
+ * The second pass handles instructions and data sections, completes the machine code and builds the list of external
+ * labels encountered during the pass ('start_second_pass' then creates the output files).
  *
  * Parameters:
  *   - original_file_struct (ptr_file): A pointer to the 'file' struct representing the current assembly source file from the first pass.
@@ -31,58 +16,73 @@ static char extern_list[MAX_CHARACTERS_ASSEMBLY_FILE];
  *                                      line structures, and the linked list of labels defined in the first pass.
  *
  * Notes:
- *   - The function initializes the 'extern_list' array as an empty string, which will be used to store the list of external labels
+ *   - The function empties the 'extern_list' buffer, which will be used to store the list of external labels
  *     encountered during the pass, if any.
  *   - The function sets the 'IC' (Instruction Counter) to the value of 'FIRST_CELL_IN_MEMORY', indicating the starting memory
  *     address for the assembled instructions.
  */
-static void second_pass_on_curr_file();
+static void second_pass_on_curr_file(ptr_file sfile);
+
+/*
+ * Function: resolve_fixups
+ * ------------------------
+ * Resolve the fixups recorded by the first pass, instead of walking the source again (the single-pass mode).
+ *
+ * This function walks the fixup list of the file in the order in which the fixups were recorded, which is the order of
+ * the lines. The word of every operand fixup is completed with the address of its label ('complete_direct_operand'), and
+ * the line of every entry fixup is split again and its labels are marked as entry points ('mark_entry_labels'). The line
+ * number of the fixup is used for the messages, so the messages and the external references are those of the second pass.
+ *
+ * Notes:
+ *   - The function empties the 'extern_list' buffer before the fixups are resolved.
+ *   - The 'IC' (Instruction Counter) is not changed; it already holds the end of the code image from the first pass.
+ */
+static void resolve_fixups(ptr_file sfile);
 
 /*
  * Function: update_files
  * ----------------------
  * Update file streams for the second pass.
  *
- * This function updates the file streams used in the second pass. It is responsible for resetting the position indicator
- * of the assembly source file back to the beginning of the file using the 'rewind' function. By doing so, it allows the
- * second pass to read the assembly source file from the beginning and perform assembly operations on it without having
- * to open and close the file again.
+ * This function updates the read position used in the second pass. It is responsible for resetting the read position
+ * of the expanded code ('pos_in_am') back to its beginning. By doing so, it allows the second pass to read the expanded
+ * code kept in memory ('text_am') from the beginning and perform assembly operations on it without any file I/O.
  *
  * Notes:
- *   - The function operates on the 'sfile' global variable, which represents the current file being processed in the second pass.
+ *   - The function operates on the 'sfile' struct, which represents the current file being processed in the second pass.
  */
-static void update_files();
+static void update_files(ptr_file sfile);
 
 /*
  * Function: update_next_line
  * --------------------------
  * Read the next line from the assembly source file and store it in the 'line_text' buffer.
  *
- * This function is responsible for reading the next line from the assembly source file represented by the file stream
- * 'sfile->file_am'. It uses the 'fgets' function to read a line of text from the file and stores it in the 'line_text'
- * buffer of the 'sfile' global variable. The 'memset' function is used to clear the buffer before reading the new line
- * to ensure that any previous content is removed.
+ * This function is responsible for reading the next line from the expanded code kept in memory ('sfile->text_am').
+ * It uses the 'read_line_of_buffer' function to read a line of text (split exactly like 'fgets') and stores it in the 'line_text'
+ * buffer of the 'sfile' struct. The line is null-terminated, so the buffer is not cleared before the read.
  *
  * Returns:
  *   char *: A pointer to the 'line_text' buffer, which contains the text of the next line read from the file.
  *           The caller can use this pointer to process the line further.
  */
-static char * update_next_line();
+static char * update_next_line(ptr_file sfile);
 
 /*
  * Function: update_line_to_array
  * ------------------------------
- * Create a new line structure and update 'sfile->line_struct' with it.
+ * Split the current line into the words of 'sfile->line_struct'.
  *
- * This function is responsible for creating a new line structure from the contents of the current assembly source line
- * stored in 'sfile->line_text'. The line structure is created using the 'create_new_line_struct' function, which allocates
- * memory and stores the line information in a structured format.
+ * This function is responsible for filling the line structure from the contents of the current assembly source line
+ * stored in 'sfile->line_text'. The line structure is filled using the 'split_line_to_words' function, which stores
+ * the line information in a structured format without allocating memory. A line copied from the body of a macro
+ * has a record in 'sfile->line_index', split when the macro was defined, and the record is copied instead.
  *
- * After creating the line structure, this function updates the 'sfile->line_struct' pointer to point to the newly created
- * structure, effectively storing the line information for the current line of the assembly source file. The 'sfile' global
- * variable represents the current file being processed in the second pass.
+ * The 'sfile->line_struct' is reused for every line, effectively storing the line information for the current line
+ * of the assembly source file. The 'sfile' struct
+ * represents the current file being processed in the second pass.
  */
-static void update_line_to_array();
+static void update_line_to_array(ptr_file sfile);
 
 /*
  * Function: skip_on_label
@@ -93,35 +93,15 @@ static void update_line_to_array();
  * If the current assembly source line has a label, this function skips the label by updating the 'sfile->pos_in_line' to point
  * to the next word after the label. It then deletes the label from the line structure, removing it from further processing.
  *
- * The 'sfile' global variable represents the current file being processed in the second pass. The 'sfile->line_text' global
- * variable holds the contents of the current line of the assembly source file, and 'sfile->line_struct' points to the line's
+ * The 'sfile' struct represents the current file being processed in the second pass. The 'sfile->line_text' buffer
+ * holds the contents of the current line of the assembly source file, and 'sfile->line_struct' holds the line's
  * structured representation, which includes the label information.
  *
  * Note:
  *   - is_label: Function to check if the current line contains a label.
  *   - delete_label_from_line_struct: Function to delete the label information from the line structure.
  */
-static void skip_on_label();
-
-/*
- * Function: get_word_status
- * -------------------------
- * Determine the status of the given word in the assembly source code.
- *
- * This function is used during the second pass of the assembly process to determine the status of a word in the assembly
- * source code. The word's status helps identify whether the word corresponds to a specific directive (e.g., .data, .string)
- * or operation code (e.g., MOV, ADD, SUB) in the assembly language.
- *
- * Parameters:
- *   word_text (char*): The word to be analyzed for its status.
- *
- * Returns:
- *   line_status: The status of the word, which represents a specific directive or operation code.
- *
- * Note:
- *   - line_status: Enum defining the possible values for the status of a word in the assembly source code.
- */
-static line_status get_word_status(char *word_text);
+static void skip_on_label(ptr_file sfile);
 
 /*
  * Function: action_by_status
@@ -129,7 +109,7 @@ static line_status get_word_status(char *word_text);
  * Perform actions based on the status of the assembly source code line.
  *
  * This function is called during the second pass of the assembly process to perform specific actions based on the status
- * of the assembly source code line. The status is determined by the 'get_word_status' function, which categorizes the line
+ * of the assembly source code line. The status is determined by the 'get_directive_status' function, which categorizes the line
  * into different types, such as directives (e.g., .data, .string, .extern) or operation codes (e.g., MOV, ADD, SUB).
  *
  * Parameters:
@@ -146,7 +126,7 @@ static line_status get_word_status(char *word_text);
  *   - For the STATUS_CODE status, the function calls 'complete_missing_instructions' to handle instruction processing,
  *     completing any missing instructions and resolving their addressing methods.
  */
-static void action_by_status(line_status status);
+static void action_by_status(ptr_file sfile, line_status status);
 
 /*
  * Function: add_error
@@ -159,15 +139,17 @@ static void action_by_status(line_status status);
  *
  * Parameters:
  *   error_code (error_code): The error code representing the type of error encountered during the assembly process.
+ *   column (int): The column of the error in the line, from 1 (0 if the error refers to the whole line).
  *
  * Note:
  *   - The 'add_error' function is called whenever an error is detected during the second pass of the assembly process.
- *   - It prints the error message along with the line number where the error occurred using the 'print_error' function.
+ *   - It records the error with the line number where it occurred in the list of diagnostics of the file, which is printed
+ *     once with the result of the file ('print_end_of_file').
  *   - After adding the error to the list, it sets the 'error_flag' to TRUE to indicate the presence of errors.
  *   - The 'count_line' and 'count_error' members of 'sfile' (file_struct pointer) are updated accordingly to keep track of
  *     the line number and the total number of errors encountered.
  */
-static void add_error(error_code error_code);
+static void add_error(ptr_file sfile, error_code error_code, int column);
 
 /*
  * Function: update_error_status
@@ -180,6 +162,7 @@ static void add_error(error_code error_code);
  *
  * Parameters:
  *   error_code (error_code): The error code representing the type of error encountered during the assembly process.
+ *   column (int): The column of the error in the line, from 1 (0 if the error refers to the whole line).
  *
  * Note:
  *   - The 'update_error_status' function is called after processing a line during the second pass of the assembly process.
@@ -187,7 +170,7 @@ static void add_error(error_code error_code);
  *   - If the error code is not 'NO_ERROR', the function adds the error to the list and sets the 'error_flag' to TRUE.
  *   - The 'error_flag' indicates the presence of errors during the assembly process.
  */
-static void update_error_status(error_code error_code);
+static void update_error_status(ptr_file sfile, error_code error_code, int column);
 
 /*
  * Function: mark_entry_labels
@@ -208,7 +191,7 @@ static void update_error_status(error_code error_code);
  *   - If the entry directive contains an invalid label name or other errors are encountered, the function adds the
  *     errors to the error list and sets the error flag.
  */
-static void mark_entry_labels();
+static void mark_entry_labels(ptr_file sfile);
 
 /*
  * Function: complete_missing_instructions
@@ -230,26 +213,7 @@ static void mark_entry_labels();
  *   - If there are any errors related to invalid addressing methods or missing operands, they are handled in the
  *     'update_the_rest_of_the_instruction_to_array' function.
  */
-static void complete_missing_instructions();
-
-/*
- * Function: update_addressing_method_type
- * ---------------------------------------
- * Update addressing method types for the source and destination operands based on the instruction type.
- *
- * This function is responsible for determining and updating the addressing method types for the source and destination
- * operands of an instruction based on the given instruction type.
- *
- * Parameters:
- *   type (instruction_type): The type of instruction to be processed.
- *
- * Note:
- *   - The 'update_addressing_method_type' function is called during the second pass of the assembly process.
- *   - The function takes the 'instruction_type' as a parameter, which is determined by the first word of the instruction.
- *   - Depending on the instruction type, the function updates the 'source' and 'destination' fields in the 'line_struct'
- *     with appropriate addressing method types.
- */
-static void update_addressing_method_type(instruction_type type);
+static void complete_missing_instructions(ptr_file sfile);
 
 /*
  * Function: update_the_rest_of_the_instruction_to_array
@@ -263,20 +227,38 @@ static void update_addressing_method_type(instruction_type type);
  * Note:
  *   - The 'update_the_rest_of_the_instruction_to_array' function is called after processing the first word of the
  *     instruction and updating the addressing method types for the source and destination operands using the
- *     'update_addressing_method_type' function.
+ *     'update_operands_of_line' function.
  *   - The function processes the source and destination addressing methods separately.
  *   - For source addressing methods REGISTER and IMMEDIATE, the function increments the instruction counter ('IC') by one
  *     to accommodate the next instruction word.
- *   - For source addressing method DIRECT, the function searches for the corresponding label node in the symbol table
- *     and generates the appropriate instruction word for RELOCATABLE or EXTERNAL addressing methods.
- *   - The 'EXTERNS_LIST' array is updated with external labels encountered during the second pass for later use in the
- *     output files.
+ *   - For source addressing method DIRECT, the function completes the word with 'complete_direct_operand'.
  *   - For destination addressing methods REGISTER and IMMEDIATE, the function increments the instruction counter ('IC')
  *     by one if the source addressing method is not REGISTER, as the destination word can be the last instruction word.
- *   - For destination addressing method DIRECT, the function searches for the corresponding label node in the symbol
- *     table and generates the appropriate instruction word for RELOCATABLE or EXTERNAL addressing methods.
+ *   - For destination addressing method DIRECT, the function completes the word with 'complete_direct_operand'.
  */
-static void update_the_rest_of_the_instruction_to_array();
+static void update_the_rest_of_the_instruction_to_array(ptr_file sfile);
+
+/*
+ * Function: complete_direct_operand
+ * ---------------------------------
+ * Completes the word of an operand with the direct addressing method.
+ *
+ * This function searches for the label of the operand in the symbol table and writes the address of the label, with the
+ * RELOCATABLE or EXTERNAL encoding type, to the word at 'address' in the instruction array. A reference to an external
+ * label is also added to the 'extern_list' buffer.
+ *
+ * Parameters:
+ *   name_label: The name of the label of the operand.
+ *   column: The column of the operand in its line, for the 'LABEL_NOT_FOUND' error.
+ *   address: The address (IC) of the word of the operand.
+ *
+ * Returns:
+ *   bool: 'TRUE' if the label was found and the word was completed, 'FALSE' otherwise (the 'LABEL_NOT_FOUND' error is added).
+ *
+ * Notes:
+ *   - It is used both by the walk of the second pass and by the resolution of the fixups in the single-pass mode.
+ */
+static bool complete_direct_operand(ptr_file sfile, const char *name_label, int column, int address);
 
 /*
  * Function: get_next_word_without_comma
@@ -285,17 +267,20 @@ static void update_the_rest_of_the_instruction_to_array();
  *
  * This function extracts the next word from the current line text, starting from the current position
  * indicated by 'pos_in_line'. It reads characters until it encounters a space, tab, newline, comma, or
- * the end of the line. The function stores the extracted word in the 'temp_word' buffer and increments
- * the 'pos_in_line' index accordingly.
+ * the end of the line. The function stores the extracted word in the 'word_text' buffer supplied by the
+ * caller and increments the 'pos_in_line' index accordingly.
+ *
+ * Parameters:
+ *   word_text (char*): A buffer of at least 'MAX_ASSEMBLY_LINE_LENGTH' characters that receives the extracted word.
  *
  * Returns:
- *   char*: A pointer to the 'temp_word' buffer containing the extracted word.
+ *   char*: A pointer to the 'word_text' buffer containing the extracted word.
  *
  * Notes:
  *   - After extracting the word, the function skips any white characters to move to the next word or
  *     the end of the line.
  */
-static char * get_next_word_without_comma();
+static char * get_next_word_without_comma(ptr_file sfile, char *word_text);
 
 /*
  * Function: check_for_comma
@@ -310,27 +295,28 @@ static char * get_next_word_without_comma();
  * Returns:
  *   bool: TRUE if a comma is found at the current position; FALSE otherwise.
  */
-static bool check_for_comma();
+static bool check_for_comma(ptr_file sfile);
 
 /*
  * Function: add_extern_label_to_array
  * ----------------------------------
- * This function adds the name and address of an external label to the 'extern_list' array. The 'extern_list' array
+ * This function adds the name and address of an external label to the 'extern_list' buffer. The 'extern_list' buffer
  * contains information about all external labels encountered during the second pass, and it will be used later to
  * generate the external file.
  *
  * Parameters:
  *   temp_node: A pointer to the label node representing the external label in the symbol table.
+ *   address: The address of the word that refers to the external label.
  *
  * Notes:
- *   - The 'extern_list' array is a global variable that stores the information of all external labels.
- *   - The function appends the name and address of the external label to the 'extern_list' array in a specific format,
+ *   - The 'extern_list' buffer of the 'sfile' struct stores the information of all external labels.
+ *   - The function appends the name and address of the external label to the 'extern_list' buffer in a specific format,
  *     separated by a tab '\t' character and followed by a newline '\n' character to separate each label entry.
- *   - The address of the external label ('IC') is obtained from the 'sfile' global variable, which represents the
- *     current assembly file being processed.
- *   - The 'extern_list' array is later used to generate the external file in the second pass.
+ *     The line is written at the end of the buffer in one step ('append_address_line_to_buffer'), so the time spent
+ *     does not depend on the number of references already in the buffer.
+ *   - The 'extern_list' buffer is later used to generate the external file in the second pass.
  */
-static void add_extern_label_to_array(ptr_label temp_node);
+static void add_extern_label_to_array(ptr_file sfile, ptr_label temp_node, int address);
 
 /*
  * Function: create_all_files
@@ -341,16 +327,17 @@ static void add_extern_label_to_array(ptr_label temp_node);
  * Notes:
  *   - The function first checks if the 'entry_flag' is set to TRUE, indicating the presence of entry labels in the assembly code.
  *   - If entry labels are found, the function creates the entry file and writes the entry labels and their addresses to the file.
- *   - The entry labels and their addresses are obtained from the 'sfile' global variable, which represents the current assembly file being processed.
- *   - The 'get_entry_list' function is called to generate a formatted string containing the entry labels and addresses for writing to the entry file.
- *   - After writing the entry file, the temporary entry list string is freed to release memory resources.
+ *   - The entry labels and their addresses are obtained from the 'sfile' struct, which represents the current assembly file being processed.
+ *   - The 'add_entry_list_to_buffer' function is called to build the text of the entry file in a temporary buffer, which is
+ *     written at once with 'write_file_of_struct' and then freed.
+ *   - Every file is written whole to a temporary file that is renamed over the output, so a reader never sees a
+ *     half-written file, and a file that already holds the same text is not written again (see 'write_file').
  *   - Next, the function checks if the 'extern_flag' is set to TRUE, indicating the presence of external labels in the assembly code.
  *   - If external labels are found, the function creates the external file and writes the external labels and their addresses to the file.
- *   - The 'extern_list' array is used to store the information of all external labels encountered during the second pass.
- *   - The 'extern_list' array is a global variable defined outside the scope of this function.
+ *   - The 'extern_list' buffer of the 'sfile' struct stores the information of all external labels encountered during the second pass.
  *   - After writing the external file, the function proceeds to create the object file by calling the 'create_object_file' function.
  */
-static void create_all_files();
+static void create_all_files(ptr_file sfile);
 
 /*
  * Function: create_object_file
@@ -359,33 +346,77 @@ static void create_all_files();
  * It generates the object file by writing the instructions and data memory contents to the file in a specific format.
  *
  * Notes:
- *   - The function first opens the object file in write mode using the 'open_file' function.
- *   - It then writes the header of the object file, which consists of the value of (IC - FIRST_CELL_IN_MEMORY) and the value of DC.
+ *   - The object file starts with a header of the object file, which consists of the value of (IC - FIRST_CELL_IN_MEMORY) and the value of DC.
  *   - The 'IC' (Instruction Counter) holds the number of instruction words (machine code) generated during the second pass.
  *   - The 'DC' (Data Counter) holds the number of data words generated during the second pass.
  *   - The instructions and data memory contents are stored in the 'instruction_array' and 'data_array', respectively.
- *   - The 'convert_binary_to_64base' function is used to convert each instruction or data word to a 64-base representation.
- *   - The converted 64-base strings are then written to the object file using the 'fputs' function.
- *   - After writing the content, the temporary word string is freed to release memory resources.
- *   - Finally, the object file is closed using the 'fclose' function.
+ *   - The whole file is built in one buffer: the header is printed with 'sprintf', and the 'encode_words_to_64base'
+ *     function encodes the instruction words and then the data words right after it.
+ *   - The buffer is written to the object file at once with 'write_file_of_struct'.
  */
-static void create_object_file();
+static void create_object_file(ptr_file sfile);
 
 void start_second_pass(ptr_file original_file_struct){
-    sfile = original_file_struct;
-    second_pass_on_curr_file();
+    ptr_file sfile = original_file_struct;
+    double start = get_time_now();
+
+    /* Complete the code image: from the fixups of the first pass, or by walking the source again. */
+    if (sfile->single_pass_flag == TRUE){
+        resolve_fixups(sfile);
+    } else {
+        second_pass_on_curr_file(sfile);
+    }
+    start = add_time_of_phase(&sfile->stats, PHASE_SECOND_PASS, start);
+
+    /* If no errors, create output files with assembled machine code and list of extern labels */
+    if (sfile->error_flag == FALSE){
+        create_all_files(sfile);
+    }
+    add_time_of_phase(&sfile->stats, PHASE_EMISSION, start);
+
+    /* Keep the counters of the symbol table for the statistics, then free the memory allocated for the list of labels */
+    sfile->stats.count_labels = sfile->label_table.count_label;
+    sfile->stats.count_probes += sfile->label_table.count_probe;
+    free_list_label(&sfile->label_table);
+}
+
+static void resolve_fixups(ptr_file sfile){
+    ptr_fixup fixup;
+    int i;
+
+    truncate_buffer(&sfile->extern_list, 0);
+
+    for (i = 0; i < sfile->fixup_list.count_fixup; i++){
+        fixup = &sfile->fixup_list.fixups[i];
+
+        /* The messages of the fixup refer to the line in which it was recorded. */
+        sfile->count_line = fixup->line;
+        switch (fixup->type) {
+            case FIXUP_OPERAND:
+                complete_direct_operand(sfile, get_text_of_fixup(&sfile->fixup_list, fixup), fixup->column, fixup->address);
+                break;
+            case FIXUP_ENTRY:
+                /* Split the '.entry' line again, now that every label of the file is known. */
+                strcpy(sfile->line_text, get_text_of_fixup(&sfile->fixup_list, fixup));
+                sfile->pos_in_line = 0;
+                update_line_to_array(sfile);
+                skip_on_label(sfile);
+                mark_entry_labels(sfile);
+                break;
+        }
+    }
 }
 
-static void second_pass_on_curr_file(){
+static void second_pass_on_curr_file(ptr_file sfile){
     /* Open the intermediate files for writing. */
-    update_files();
+    update_files(sfile);
 
     sfile->count_line = 0;
-    extern_list[0] = '\0';
+    truncate_buffer(&sfile->extern_list, 0);
     sfile->IC = FIRST_CELL_IN_MEMORY;
 
     /* Process each line in the current file. */
-    while(update_next_line() != NULL) {
+    while(update_next_line(sfile) != NULL) {
         /* Increment the count of processed lines. */
         (sfile->count_line)++;
 
@@ -398,78 +429,52 @@ static void second_pass_on_curr_file(){
         sfile->pos_in_line = 0;
 
         /* Update the line data structure to store information about the current line. */
-        update_line_to_array();
+        update_line_to_array(sfile);
 
         /* Skip on label definitions, already processed in the first pass */
-        skip_on_label();
-        if (sfile->line_struct->count == 0){
+        skip_on_label(sfile);
+        if (sfile->line_struct.count == 0){
             continue;
         }
 
         /* Determine the type of line being processed and take appropriate action */
-        action_by_status(get_word_status(sfile->line_struct->word1));
-
-        /* Free the memory occupied by the line data structure. */
-        free_line(sfile->line_struct);
-    }
-
-    /* If no errors, create output files with assembled machine code and list of extern labels */
-    if (sfile->error_flag == FALSE){
-        create_all_files();
+        action_by_status(sfile, get_directive_status(WORD_OF_LINE(&sfile->line_struct, 1)));
     }
-
-    /* Free memory allocated for the list of labels to avoid memory leaks */
-    free_list_label(&sfile->head_label_list);
 }
 
-static void update_files(){
-    /* Rewind the assembly source file 'sfile->file_am' back to the beginning. */
-    rewind(sfile->file_am);
+static void update_files(ptr_file sfile){
+    /* Read the expanded code 'sfile->text_am' from its beginning. */
+    sfile->pos_in_am = 0;
 }
 
-static char * update_next_line(){
-    /* Clear the 'line_text' buffer to ensure it's empty before reading the new line. */
-    memset(sfile->line_text, 0, MAX_ASSEMBLY_LINE_LENGTH);
-
-    /* Read the next line from the assembly source file into the 'line_text' buffer. */
-    return fgets(sfile->line_text,sizeof (sfile->line_text),sfile->file_am);
+static char * update_next_line(ptr_file sfile){
+    /* Read the next line from the expanded code into the 'line_text' buffer (null-terminated, no clearing needed). */
+    return read_line_of_buffer(&sfile->text_am, &sfile->pos_in_am, sfile->line_text, sizeof (sfile->line_text));
 }
 
-static void update_line_to_array(){
-    /* Create a new line structure from the current assembly source line 'sfile->line_text'. */
-    sfile->line_struct = create_new_line_struct(sfile->line_text);
+static void update_line_to_array(ptr_file sfile){
+    ptr_line record = get_from_line_index(&sfile->line_index, sfile->count_line - 1);
+
+    /* A line of a macro body was split when the macro was defined, so its record is copied. Otherwise, create a new line structure from the current assembly source line 'sfile->line_text'. */
+    if (record != NULL){
+        copy_line_struct(&sfile->line_struct, record);
+    } else {
+        split_line_to_words(&sfile->line_struct, sfile->line_text);
+    }
 }
 
-static void skip_on_label() {
+static void skip_on_label(ptr_file sfile) {
     /* Check if the current line contains a label. */
-    if (is_label(sfile->line_struct) == TRUE) {
+    if (is_label(&sfile->line_struct) == TRUE) {
         /* If a label is present, skip it by updating 'sfile->pos_in_line'. */
         sfile->pos_in_line = skip_one_word_in_line(sfile->pos_in_line, sfile->line_text);
 
         /* Delete the label from the line structure to avoid interference with further processing. */
-        delete_label_from_line_struct(sfile->line_struct);
-    }
-}
-
-static line_status get_word_status(char *word_text){
-    /* Check if the word matches any known directives or operation codes. */
-    if (strcmp(word_text, DOT_DATA) == 0){
-        return STATUS_DATA;
-    }
-    if (strcmp(word_text, DOT_STRING) == 0){
-        return STATUS_STRING;
-    }
-    if (strcmp(word_text, DOT_EXTERN) == 0){
-        return STATUS_EXTERN;
+        delete_label_from_line_struct(&sfile->line_struct);
     }
-    if (strcmp(word_text, DOT_ENTRY) == 0){
-        return STATUS_ENTRY;
-    }
-    /* If the word does not match any known directive or operation code, return STATUS_CODE. */
-    return STATUS_CODE;
 }
 
-static void action_by_status(line_status status){
+static void action_by_status(ptr_file sfile, line_status status){
     /* Perform actions based on the status of the assembly source code line. */
     switch (status) {
     case STATUS_DATA: case STATUS_STRING: case STATUS_EXTERN:
@@ -477,18 +482,18 @@ static void action_by_status(line_status status){
             return;
         case STATUS_ENTRY:
             /* Handle entry label processing by calling the 'mark_entry_labels' function. */
-            mark_entry_labels();
+            mark_entry_labels(sfile);
             break;
         case STATUS_CODE:
             /* Handle instruction processing by calling the 'complete_missing_instructions' function. */
-            complete_missing_instructions();
+            complete_missing_instructions(sfile);
             break;
     }
 }
 
-static void add_error(error_code error_code){
-    /* Print the error message along with the line number where the error occurred. */
-    print_error(error_code,sfile->count_line);
+static void add_error(ptr_file sfile, error_code error_code, int column){
+    /* Record the error with the line number and the column where it occurred; it is printed with the result of the file. */
+    add_to_list_diagnostic(&sfile->diagnostic_list, error_code, sfile->count_line, column);
 
     /* Set the error flag to indicate the presence of errors during the assembly process. */
     sfile->error_flag = TRUE;
@@ -497,16 +502,17 @@ static void add_error(error_code error_code){
     (sfile->count_error)++;
 }
 
-static void update_error_status(error_code error_code){
+static void update_error_status(ptr_file sfile, error_code error_code, int column){
     /* Check if the error code represents 'NO_ERROR' (i.e., no error). */
     if (error_code != NO_ERROR){
         /* Add the error to the error list and set the error flag. */
-        add_error(error_code);
+        add_error(sfile, error_code, column);
     }
 }
 
-static void mark_entry_labels(){
+static void mark_entry_labels(ptr_file sfile){
     char temp_word[MAX_ASSEMBLY_LINE_LENGTH] = "";
+    int column;
 
     /* Set the 'entry_flag' to TRUE to indicate that the entry directive has been encountered in the current line. */
     sfile->entry_flag = TRUE;
@@ -517,7 +523,7 @@ static void mark_entry_labels(){
     /* Check if the entry directive provides any label names. */
     if (is_end_line(sfile->pos_in_line, sfile->line_text) == TRUE){
         /* If there are no label names, add an error indicating that label names must be provided. */
-        add_error(MUST_PROVIDE_LABELS_TO_ENTRY);
+        add_error(sfile, MUST_PROVIDE_LABELS_TO_ENTRY, COLUMN_OF_LINE(&sfile->line_struct, 1));
         return;
     } else {
         /* Process each label name provided in the entry directive. */
@@ -527,111 +533,62 @@ static void mark_entry_labels(){
 
             /* Check for an invalid comma position. */
             if (sfile->line_text[sfile->pos_in_line] == ','){
-                add_error(INVALID_COMMA_POSITION);
+                add_error(sfile, INVALID_COMMA_POSITION, sfile->pos_in_line + 1);
                 return;
             }
 
             /* Extract the label name without a comma. */
-            strcpy(temp_word, get_next_word_without_comma()); /* */
+            column = sfile->pos_in_line + 1;
+            get_next_word_without_comma(sfile, temp_word);
 
             /* Check if the label name is valid and update the error status accordingly. */
             if (is_label_name_valid(temp_word) == TRUE){
-                update_error_status(mark_label_as_entry(sfile->head_label_list, temp_word));
+                update_error_status(sfile, mark_label_as_entry(&sfile->label_table, temp_word), column);
             } else {
-                add_error(INVALID_LABEL_NAME);
+                add_error(sfile, INVALID_LABEL_NAME, column);
             }
-        } while (check_for_comma() == TRUE); /* Continue processing if there are more label names separated by commas. */
+        } while (check_for_comma(sfile) == TRUE); /* Continue processing if there are more label names separated by commas. */
     }
 }
 
-static void complete_missing_instructions(){
+static void complete_missing_instructions(ptr_file sfile){
     instruction_type type;
 
     /* Determine the instruction type by extracting the first word from the line and looking it up in the instruction set. */
-    type = get_instruction_type(sfile->line_struct->word1);
+    type = get_instruction_type(WORD_OF_LINE(&sfile->line_struct, 1));
 
     /* Update the addressing method types for the source and destination operands based on the instruction type. */
-    update_addressing_method_type(type);
+    update_operands_of_line(&sfile->line_struct, type);
 
     /* Increment the 'IC' (Instruction Counter) to allocate memory for the instruction's first word in the instruction array. */
     (sfile->IC)++;
 
     /* Generate the rest of the instruction and add it to the instruction array. */
-    update_the_rest_of_the_instruction_to_array();
-}
-
-static void update_addressing_method_type(instruction_type type){
-    /* Check the type of instruction and update addressing method types accordingly */
-    switch (type) {
-        case MOV: case CMP: case ADD: case SUB: case LEA:
-            /* For instructions with two operands, update the addressing method type for both source and destination. */
-            sfile->line_struct->source = get_addressing_method_type(sfile->line_struct->word2);
-            sfile->line_struct->destination = get_addressing_method_type(sfile->line_struct->word4);
-            break;
-        case NOT: case CLR: case INC: case DEC: case JMP: case BNE: case RED: case PRN: case JSR:
-            /* For instructions with a single operand, update the destination field, and set the source field to NOT_EXIST. */
-            sfile->line_struct->source = NOT_EXIST;
-            sfile->line_struct->destination = get_addressing_method_type(sfile->line_struct->word2);
-
-            /* Copy the operand to word4 since there's only one operand for these instructions. */
-            strcpy(sfile->line_struct->word4, sfile->line_struct->word2);
-            break;
-        default:
-            /* For instructions with no operands, set both source and destination fields to NOT_EXIST. */
-            sfile->line_struct->source = NOT_EXIST;
-            sfile->line_struct->destination = NOT_EXIST;
-            break;
-    }
+    update_the_rest_of_the_instruction_to_array(sfile);
 }
 
-static void update_the_rest_of_the_instruction_to_array(){
-    ptr_label label_node;
-
+static void update_the_rest_of_the_instruction_to_array(ptr_file sfile){
     /* Process the source addressing method. */
-    switch (sfile->line_struct->source) {
+    switch (sfile->line_struct.source) {
         case REGISTER: case IMMEDIATE:
             /* Increment the instruction counter ('IC') by one to accommodate the next instruction word. */
             (sfile->IC)++;
             break;
         case DIRECT:
-        {
-            /* For DIRECT addressing method, search for the corresponding label node in the symbol table. */
-            label_node = search_in_list_label(sfile->head_label_list, sfile->line_struct->word2);
-            if (label_node != NULL){
-                /* Bit-field structure for source operand with direct addressing */
-                struct {
-                    unsigned int encoding_type:2; /* Encoding type field (2 bits) */
-                    unsigned int label_address:10; /* Value field for the address of the operand */
-                } word_of_instruction;
-
-                /* For external labels, set the encoding type to EXTERNAL and add the label to the extern_list array. */
-                if (label_node->type == EXTERN){
-                    word_of_instruction.encoding_type = EXTERNAL;
-                    add_extern_label_to_array(label_node);
-                } else {
-                    /* For relocatable labels, set the encoding type to RELOCATABLE. */
-                    word_of_instruction.encoding_type = RELOCATABLE;
-                }
-                /* Update the label's address in the instruction word. */
-                word_of_instruction.label_address = label_node->address_label;
-
-                /* Copy the instruction word to the instruction array and increment the instruction counter ('IC'). */
-                memcpy(&sfile->instruction_array[sfile->IC], &word_of_instruction, sizeof(unsigned int));
+            /* For DIRECT addressing method, complete the word with the address of the label and move to the next word. */
+            if (complete_direct_operand(sfile, WORD_OF_LINE(&sfile->line_struct, 2), COLUMN_OF_LINE(&sfile->line_struct, 2), sfile->IC) == TRUE){
                 (sfile->IC)++;
-            } else {
-                /* If the label node is not found in the symbol table, add an error for LABEL_NOT_FOUND. */
-                add_error(LABEL_NOT_FOUND);
             }
-        }
             break;
         case NOT_EXIST:
             break;
     }
+
     /* Process the destination addressing method. */
-    switch (sfile->line_struct->destination) {
+    switch (sfile->line_struct.destination) {
         /* Increment the instruction counter ('IC') by one to accommodate the next instruction word (if it is not done on the first pass). */
         case REGISTER:
-            if (sfile->line_struct->source != REGISTER){
+            if (sfile->line_struct.source != REGISTER){
                 (sfile->IC)++;
             }
             break;
@@ -640,44 +597,44 @@ static void update_the_rest_of_the_instruction_to_array(){
             (sfile->IC)++;
             break;
         case DIRECT:
-        {
-            /* For DIRECT addressing method, search for the corresponding label node in the symbol table. */
-            label_node = search_in_list_label(sfile->head_label_list, sfile->line_struct->word4);
-            if (label_node != NULL){
-                /* Bit-field structure for destination operand with direct addressing */
-                struct {
-                    unsigned int encoding_type:2; /* Encoding type field (2 bits) */
-                    unsigned int label_address:10; /* Value field for the address of the operand */
-                } word_of_instruction;
-
-                /* For external labels, set the encoding type to EXTERNAL and add the label to the extern_list array. */
-                if (label_node->type == EXTERN){
-                    word_of_instruction.encoding_type = EXTERNAL;
-                    add_extern_label_to_array(label_node);
-                } else {
-                    /* For relocatable labels, set the encoding type to RELOCATABLE. */
-                    word_of_instruction.encoding_type = RELOCATABLE;
-                }
-                /* Update the label's address in the instruction word. */
-                word_of_instruction.label_address = label_node->address_label;
-
-                /* Copy the instruction word to the instruction array and increment the instruction counter ('IC'). */
-                memcpy(&sfile->instruction_array[sfile->IC], &word_of_instruction, sizeof(unsigned int));
+            /* For DIRECT addressing method, complete the word with the address of the label and move to the next word. */
+            if (complete_direct_operand(sfile, WORD_OF_LINE(&sfile->line_struct, 4), COLUMN_OF_LINE(&sfile->line_struct, 4), sfile->IC) == TRUE){
                 (sfile->IC)++;
-            } else {
-                /* If the label node is not found in the symbol table, add an error for LABEL_NOT_FOUND. */
-                add_error(LABEL_NOT_FOUND);
             }
-        }
             break;
         case NOT_EXIST:
             break;
     }
 }
 
-static char * get_next_word_without_comma(){
-    /* Static buffer to store the extracted word */
-    static char temp_word[MAX_ASSEMBLY_LINE_LENGTH] = "";
+static bool complete_direct_operand(ptr_file sfile, const char *name_label, int column, int address){
+    ptr_label label_node;
+    encoding_type encoding;
+
+    /* Search for the label of the operand in the symbol table. */
+    label_node = search_in_list_label(&sfile->label_table, name_label);
+    if (label_node == NULL){
+        /* If the label node is not found in the symbol table, add an error for LABEL_NOT_FOUND. */
+        add_error(sfile, LABEL_NOT_FOUND, column);
+        return FALSE;
+    }
+
+    /* For external labels, set the encoding type to EXTERNAL and add the reference to the extern_list buffer. */
+    if (label_node->type == EXTERN){
+        encoding = EXTERNAL;
+        add_extern_label_to_array(sfile, label_node, address);
+    } else {
+        /* For relocatable labels, set the encoding type to RELOCATABLE. */
+        encoding = RELOCATABLE;
+    }
+
+    /* Put the label's address and the encoding type in the instruction word. */
+    *get_word_of_array(&sfile->instruction_array, address - FIRST_CELL_IN_MEMORY) =
+            ENCODE_VALUE_WORD(label_node->address_label, encoding);
+    return TRUE;
+}
+
+static char * get_next_word_without_comma(ptr_file sfile, char *word_text){
     int j = 0;
 
     /* Read characters until a space, tab, newline, comma, or the end of the line is encountered */
@@ -686,20 +643,20 @@ static char * get_next_word_without_comma(){
            sfile->line_text[sfile->pos_in_line] != '\n' &&
            sfile->line_text[sfile->pos_in_line] != ',' &&
            sfile->line_text[sfile->pos_in_line] != '\0') {
-        temp_word[j] = sfile->line_text[sfile->pos_in_line];
+        word_text[j] = sfile->line_text[sfile->pos_in_line];
         (sfile->pos_in_line)++;
         j++;
     }
 
     /* Null-terminate the extracted word */
-    temp_word[j] = '\0';
+    word_text[j] = '\0';
 
     /* Skip any white characters to move to the next word or the end of the line */
     sfile->pos_in_line = skip_white_character(sfile->pos_in_line, sfile->line_text);
-    return temp_word;
+    return word_text;
 }
 
-static bool check_for_comma(){
+static bool check_for_comma(ptr_file sfile){
     if (sfile->line_text[sfile->pos_in_line] == ','){
         /* A comma is found, increment the position and return TRUE. */
         (sfile->pos_in_line)++;
@@ -707,97 +664,72 @@ static bool check_for_comma(){
     } else {
         /* If the current character is not a comma and not the end of the line, add an error message. */
         if (sfile->line_text[sfile->pos_in_line] != '\n' && sfile->line_text[sfile->pos_in_line] != '\0'){
-            add_error(COMMA_REQUIRED_BETWEEN_VALUES);
+            add_error(sfile, COMMA_REQUIRED_BETWEEN_VALUES, sfile->pos_in_line + 1);
         }
         /* Return FALSE as a comma is not found at the current position. */
         return FALSE;
     }
 }
 
-static void add_extern_label_to_array(ptr_label temp_node){
-    char int_ic[MAX_DIGITS_FOR_ADDRESS];
-
-    /* Append the name of the external label to the 'extern_list' array. */
-    strcat(extern_list,temp_node->name_label);
-
-    /* Append a tab '\t' character as a separator between the label name and its address. */
-    strcat(extern_list,"\t");
-
-    /* Convert the address of the external label ('IC') to a string and append it to the 'extern_list' array. */
-    sprintf(int_ic, "%d", sfile->IC);
-    strcat(extern_list, int_ic);
-
-    /* Append a newline '\n' character to separate each label entry in the 'extern_list' array. */
-    strcat(extern_list, "\n");
+static void add_extern_label_to_array(ptr_file sfile, ptr_label temp_node, int address){
+    /* Append the name of the external label and the address of the reference to the 'extern_list' buffer. */
+    append_address_line_to_buffer(&sfile->extern_list, temp_node->name_label, address);
 }
 
-static void create_all_files(){
-    char *temp_entry_list;
+static void create_all_files(ptr_file sfile){
+    item_buffer entry_list;
     /* Check if entry labels are present in the assembly code. */
     if (sfile->entry_flag == TRUE){
-        /* Create the entry file and open it in write mode. */
-        sfile->file_ent = open_file(sfile->name_file, EXT_ENTRY, "w");
-
-        /* Get the formatted string containing the entry labels and addresses. */
-        temp_entry_list = get_entry_list(sfile->head_label_list);
+        /* Build the text of the entry file: the entry labels and their addresses. */
+        init_buffer(&entry_list);
+        add_entry_list_to_buffer(&sfile->label_table, &entry_list);
 
-        /* Write the entry labels and their addresses to the entry file. */
-        fputs(temp_entry_list, sfile->file_ent);
-
-        /* Free the temporary entry list string to release memory resources. */
-        free(temp_entry_list);
-
-        /* Close the entry file. */
-        fclose(sfile->file_ent);
+        /* Write the entry labels and their addresses to the entry file at once. */
+        if (write_file_of_struct(sfile, EXT_ENTRY, entry_list.text, entry_list.length) == TRUE){
+            sfile->stats.bytes_written += (long) entry_list.length;
+        }
 
+        /* Free the temporary entry list buffer to release memory resources. */
+        free_buffer(&entry_list);
     }
     /* Check if external labels are present in the assembly code. */
     if (sfile->extern_flag == TRUE){
-        /* Create the external file and open it in write mode. */
-        sfile->file_ext = open_file(sfile->name_file, EXT_EXTERN, "w");
-
-        /* Write the external labels and their addresses from the 'extern_list' array to the external file. */
-        fputs(extern_list, sfile->file_ext);
-
-        /* Close the external file. */
-        fclose(sfile->file_ext);
+        /* Write the external labels and their addresses from the 'extern_list' buffer to the external file at once. */
+        if (write_file_of_struct(sfile, EXT_EXTERN, sfile->extern_list.text, sfile->extern_list.length) == TRUE){
+            sfile->stats.bytes_written += (long) sfile->extern_list.length;
+        }
     }
     /* Create the object file by calling the 'create_object_file' function. */
-    create_object_file();
-}
+    create_object_file(sfile);
 
-static void create_object_file(){
-    int i;
-    char *temp_word;
-
-    /* Open the object file in write mode. */
-    sfile->file_ob = open_file(sfile->name_file, EXT_OBJECT, "w");
-
-    /* Write the header of the object file: (IC - FIRST_CELL_IN_MEMORY) and DC. */
-    fprintf(sfile->file_ob, "%d\t%d\n", sfile->IC - FIRST_CELL_IN_MEMORY, sfile->DC);
-
-    /* Write the instruction memory contents to the object file. */
-    for (i = FIRST_CELL_IN_MEMORY; i < sfile->IC; i++){
-        /* Convert the instruction word to a 64-base representation. */
-        temp_word = convert_binary_to_64base(sfile->instruction_array[i]);
+    /* Create the binary object file too, if it was requested. */
+    if (sfile->binary_flag == TRUE){
+        create_binary_object_file(sfile);
+    }
+}
 
-        /* Write the converted 64-base string to the object file. */
-        fputs(temp_word, sfile->file_ob);
+static void create_object_file(ptr_file sfile){
+    int count_instructions = sfile->IC - FIRST_CELL_IN_MEMORY;
+    size_t length;
+    char *text_ob;
 
-        /* Free the temporary word string to release memory resources. */
-        free(temp_word);
+    /* Allocate one buffer for the whole object file: the header and three characters for every word. */
+    text_ob = (char *) malloc(OBJECT_HEADER_LENGTH + (size_t) (count_instructions + sfile->DC) * BASE64_WORD_LENGTH);
+    if (text_ob == NULL){
+        fprintf(stderr, "Error in dynamic memory allocation");
+        exit(EXIT_FAILURE);
     }
-    /* Write the data memory contents to the object file. */
-    for (i = 0; i < sfile->DC; i++) {
-        /* Convert the data word to a 64-base representation. */
-        temp_word = convert_binary_to_64base(sfile->data_array[i]);
 
-        /* Write the converted 64-base string to the object file. */
-        fputs(temp_word, sfile->file_ob);
+    /* The header of the object file: (IC - FIRST_CELL_IN_MEMORY) and DC. */
+    length = (size_t) sprintf(text_ob, "%d\t%d\n", count_instructions, sfile->DC);
+
+    /* Encode the instruction memory contents and then the data memory contents. */
+    length += encode_words_to_64base(sfile->instruction_array.words, count_instructions, text_ob + length);
+    length += encode_words_to_64base(sfile->data_array.words, sfile->DC, text_ob + length);
 
-        /* Free the temporary word string to release memory resources. */
-        free(temp_word);
+    /* Write the whole object file at once. */
+    if (write_file_of_struct(sfile, EXT_OBJECT, text_ob, length) == TRUE){
+        sfile->stats.bytes_written += (long) length;
     }
-    /* Close the object file. */
-    fclose(sfile->file_ob);
+    free(text_ob);
 }
\ No newline at end of file
@@ -8,6 +8,8 @@
  * Included Files:
  *   - file_tool.h: Contains utility functions for file handling operations and line processing in the second pass of the assembly process.
  *   - text_tool.h: Contains utility functions for string manipulation and parsing in the second pass.
+ *   - binary_tool.h: Contains the binary object file, written with the '--binary' option.
+ *   - word_tool.h: Contains the layouts of the machine words and the table of the instructions.
  *   - setting.h: Contains constant definitions and configurations used in the second pass of the assembly process.
  */
 
@@ -16,6 +18,8 @@
 
 #include "file_tool.h"
 #include "text_tool.h"
+#include "binary_tool.h"
+#include "word_tool.h"
 #include "setting.h"
 
 /*
@@ -28,6 +32,10 @@
  * instructions and data sections, generates the final machine code, and creates the output file with the assembled
  * machine code and the list of external labels encountered during the pass.
  *
+ * In the single-pass mode ('single_pass_flag') the source is not read again: the words of the operands that refer to
+ * labels and the '.entry' lines are completed from the fixups recorded by the first pass, in the order of the lines, so
+ * the output files and the messages are the same.
+ *
  * Parameters:
  *   original_file_struct (ptr_file): A pointer to the 'file' struct representing the current assembly source file.
  *                                    The 'file_struct' contains information about the source file, such as the file streams,
@@ -24,8 +24,11 @@
 /* Maximum length for a file extension */
 #define MAX_FILE_EXTENSION_LENGTH 4
 
-/* Maximum size of an array(instruction or directive) */
-#define MAX_ARRAY_SIZE 924
+/* Maximum length for a file name with its extension, including the null terminator */
+#define MAX_FULL_FILE_NAME_LENGTH (MAX_FILE_NAME_LENGTH + MAX_FILE_EXTENSION_LENGTH + 1)
+
+/* Number of memory cells of the machine (an address has 10 bits), shared by the code and the data images */
+#define MEMORY_SIZE 1024
 
 /* Maximum length of an assembly line */
 #define MAX_ASSEMBLY_LINE_LENGTH 82
@@ -33,17 +36,105 @@
 /* Maximum length of a label name */
 #define MAX_NAME_LABEL_LENGTH 32
 
-/* Maximum number of characters in an assembly file */
-#define MAX_CHARACTERS_ASSEMBLY_FILE 8000
+/* Maximum number of characters of an int written in decimal (including the sign and the null terminator) */
+#define MAX_DIGITS_FOR_NUMBER 12
+
+/* Number of characters of a word in the object file (two base-64 characters and a newline) */
+#define BASE64_WORD_LENGTH 3
+
+/* Number of entries of the base-64 table, one for every 12-bit word */
+#define BASE64_TABLE_SIZE 4096
+
+/* Maximum length of the header of the object file (two numbers, a tab, a newline and a null terminator) */
+#define OBJECT_HEADER_LENGTH 32
+
+/* Number of bits of a machine word, and the mask of those bits */
+#define WORD_BITS 12
+#define WORD_MASK 0xFFF
+
+/* Number of bits of the encoding type (A,R,E) at the bottom of an operand word, and the mask of those bits */
+#define ENCODING_TYPE_BITS 2
+#define ENCODING_TYPE_MASK 0x3
+
+/* Magic number and version of the binary object file ('--binary' option, see 'binary_tool.h') */
+#define BINARY_MAGIC "AOBJ"
+#define BINARY_VERSION 1
+
+/* Number of bytes of an entry or extern record of the binary object file */
+#define BINARY_RECORD_LENGTH 8
+
+/* Initial number of diagnostics allocated for the list of diagnostics of a file */
+#define INITIAL_DIAGNOSTIC_LIST_SIZE 64
+
+/* ANSI escape sequences of the colored diagnostics ('--diagnostics color') */
+#define COLOR_RED "\033[1;31m"
+#define COLOR_RESET "\033[0m"
+
+/* Schema of the SARIF logs of the diagnostics ('--diagnostics sarif') */
+#define SARIF_SCHEMA "https://json.schemastore.org/sarif-2.1.0.json"
+
+/* Smallest number of lines of a chunk of the first pass ('--chunks' option), so a small file is not split */
+#define MIN_CHUNK_LINES 128
+
+/* Initial number of slots in a hash table (must be a power of two) */
+#define INITIAL_HASH_TABLE_SIZE 64
+
+/* Initial number of line records of the macro bodies, and of lines in the line index of a file */
+#define INITIAL_LINE_RECORDS_SIZE 256
+
+/* Initial number of characters allocated for a growable text buffer */
+#define INITIAL_BUFFER_SIZE 256
+
+/* Initial number of words allocated for a growable word array (code or data image) */
+#define INITIAL_WORD_ARRAY_SIZE 64
+
+/* Version of the assembler, part of the key of the cache ('--cache' option). It must be changed whenever a change
+ * of the assembler changes its output files or its messages (in every format of the diagnostics, the JSON and SARIF
+ * objects too), since the cache replays them: the entries of older versions are then not used */
+#define ASSEMBLER_VERSION "1.23"
+
+/* First word of the framed output stream of the '--stdio' option, followed by the version and the name of the source */
+#define STREAM_HEADER "assembler-stream"
+
+/* Name of the source read from the standard input ('--stdio' option), when no name is given */
+#define STREAM_DEFAULT_NAME "stdin"
+
+/* First line of every entry of the cache, followed by the version */
+#define CACHE_HEADER "assembler-cache "
+
+/* Smallest number of characters read at once when a whole file is read into a buffer */
+#define READ_BLOCK_SIZE 65536
+
+/* Initial number of fixups allocated for the fixup list of the single-pass mode */
+#define INITIAL_FIXUP_LIST_SIZE 64
+
+/* Number of bytes in a block of the arena of a file */
+#define ARENA_BLOCK_SIZE 16384
+
+/* Maximum number of files assembled at the same time ('-j' option) */
+#define MAX_COUNT_JOBS 64
+
+/* Line written by the server ('--server' option) after the messages of every job */
+#define SERVER_END_OF_JOB "--- end of job ---"
+
+/* The characters that separate the names of the files in the line of a job of the server */
+#define SERVER_SEPARATORS " \t\r\n"
+
+/* Number of connections waiting to be accepted by the server on its Unix socket ('--socket' option) */
+#define SERVER_BACKLOG 16
+
+/* Maximum number of released file structs kept to be reused by the next files */
+#define MAX_SPARE_FILE_STRUCTS MAX_COUNT_JOBS
 
-/* Maximum number of digits in an address */
-#define MAX_DIGITS_FOR_ADDRESS 4
+/* The tokenizer scans the lines a chunk of 'sizeof(unsigned long)' characters at a time; define SCAN_SCALAR when
+ * building (-DSCAN_SCALAR) to scan them one character at a time instead */
 
-/* Maximum line length in base-64 */
-#define BASE64_CHAR_LENGTH 4
+/* Size of the buffer in which an existing output file is read, to compare it with the new text of the file */
+#define COMPARE_BUFFER_SIZE 4096
 
-/* Base for mathematical operations */
-#define BASE_POW 2
+/* Number of names tried for the temporary file of an output file, and the characters they add to the name */
+#define MAX_TEMP_FILE_TRIES 100
+#define TEMP_FILE_SUFFIX_LENGTH 32
 
 /*
  * Enum: bool
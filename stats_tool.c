@@ -0,0 +1,93 @@
+#include "stats_tool.h"
+
+/*
+ * Function: print_counters_of_stats
+ * ---------------------------------
+ * Prints the times of the phases and the counters of statistics, the part shared by a file and the whole run.
+ *
+ * Parameters:
+ *   - file_log: The stream that receives the statistics.
+ *   - stats: A pointer to the statistics.
+ */
+static void print_counters_of_stats(FILE *file_log, ptr_stats stats);
+
+void init_stats(ptr_stats stats){
+    int i;
+
+    stats->count_files = 0;
+    for (i = 0; i < COUNT_PHASES; i++){
+        stats->time_phases[i] = 0;
+    }
+    stats->count_lines = 0;
+    stats->count_macro_calls = 0;
+    stats->count_labels = 0;
+    stats->count_probes = 0;
+    stats->bytes_read = 0;
+    stats->bytes_written = 0;
+    stats->count_cache_hits = 0;
+}
+
+double get_time_now(void){
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec + (double) now.tv_nsec / 1e9;
+}
+
+double add_time_of_phase(ptr_stats stats, phase_of_stats phase, double start){
+    double now = get_time_now();
+
+    stats->time_phases[phase] += now - start;
+    return now;
+}
+
+void add_stats(ptr_stats total, ptr_stats stats){
+    int i;
+
+    /* Statistics that were never summed belong to one file. */
+    total->count_files += (stats->count_files == 0) ? 1 : stats->count_files;
+    for (i = 0; i < COUNT_PHASES; i++){
+        total->time_phases[i] += stats->time_phases[i];
+    }
+    total->count_lines += stats->count_lines;
+    total->count_macro_calls += stats->count_macro_calls;
+    total->count_labels += stats->count_labels;
+    total->count_probes += stats->count_probes;
+    total->bytes_read += stats->bytes_read;
+    total->bytes_written += stats->bytes_written;
+    total->count_cache_hits += stats->count_cache_hits;
+}
+
+void print_stats(FILE *file_log, ptr_stats stats){
+    fprintf(file_log, "\nStatistics:\n");
+    print_counters_of_stats(file_log, stats);
+}
+
+void print_total_stats(FILE *file_log, ptr_stats total, double time_run){
+    struct rusage usage;
+
+    fprintf(file_log, "\nStatistics of %d files:\n", total->count_files);
+    print_counters_of_stats(file_log, total);
+    fprintf(file_log, "  Wall time of the run (ms): %.3f\n", time_run * 1000);
+
+    /* The peak resident set size of the whole process (not only its heap), in kilobytes on Linux. */
+    if (getrusage(RUSAGE_SELF, &usage) == 0){
+        fprintf(file_log, "  Peak RSS of the process (kB): %ld\n", (long) usage.ru_maxrss);
+    }
+}
+
+static void print_counters_of_stats(FILE *file_log, ptr_stats stats){
+    double time_total = 0;
+    int i;
+
+    for (i = 0; i < COUNT_PHASES; i++){
+        time_total += stats->time_phases[i];
+    }
+    fprintf(file_log, "  Time (ms): pre-assembly %.3f, first pass %.3f, second pass %.3f, emission %.3f, total %.3f\n",
+            stats->time_phases[PHASE_PRE_ASSEMBLY] * 1000, stats->time_phases[PHASE_FIRST_PASS] * 1000,
+            stats->time_phases[PHASE_SECOND_PASS] * 1000, stats->time_phases[PHASE_EMISSION] * 1000, time_total * 1000);
+    fprintf(file_log, "  Lines: %ld, macro calls: %ld, labels: %ld, hash probes: %ld\n",
+            stats->count_lines, stats->count_macro_calls, stats->count_labels, stats->count_probes);
+    fprintf(file_log, "  Bytes read: %ld, bytes written: %ld, cache hits: %ld\n", stats->bytes_read, stats->bytes_written,
+            stats->count_cache_hits);
+}
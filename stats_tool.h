@@ -0,0 +1,144 @@
+/*
+ * Header: stats_tool.h
+ * --------------------
+ * This header file defines the statistics of the assembly of a file and the functions used to collect and print them.
+ * The statistics are printed with the '--stats' option: the wall time of every phase and a few counters that show
+ * where the time of a file goes, for every file and for the whole run.
+ *
+ * Included Files:
+ *   - stdio.h: Standard Input/Output library. It provides functions for input and output operations, such as file handling.
+ *   - stdlib.h: Standard Library. It provides functions for memory allocation, conversion, and other utility functions.
+ *   - time.h: Time library. It provides 'clock_gettime', used to measure the wall time of the phases.
+ *   - sys/resource.h: POSIX resource library. It provides 'getrusage', used to read the peak RSS of the process.
+ *   - setting.h: Contains constant definitions and configurations used throughout the assembly process.
+ */
+
+#ifndef STATS_TOOL_H
+#define STATS_TOOL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/resource.h>
+#include "setting.h"
+
+/*
+ * Enum: phase_of_stats
+ * --------------------
+ * An enumeration representing the phases of the assembly of a file that are timed.
+ *
+ * Enum Values:
+ *   - PHASE_PRE_ASSEMBLY: The expansion of the macros.
+ *   - PHASE_FIRST_PASS: The first pass.
+ *   - PHASE_SECOND_PASS: The second pass (or the resolution of the fixups in the single-pass mode).
+ *   - PHASE_EMISSION: The creation of the output files.
+ */
+typedef enum {PHASE_PRE_ASSEMBLY, PHASE_FIRST_PASS, PHASE_SECOND_PASS, PHASE_EMISSION} phase_of_stats;
+
+/* Number of values of 'phase_of_stats' */
+#define COUNT_PHASES 4
+
+/*
+ * Struct: item_stats
+ * ------------------
+ * A structure representing the statistics of the assembly of one file, or the sum of the statistics of several files.
+ *
+ * Fields:
+ *   - count_files: The number of files summed into the statistics.
+ *   - time_phases: The wall time of every phase, in seconds.
+ *   - count_lines: The number of lines of the source.
+ *   - count_macro_calls: The number of macro calls expanded by the pre-assembly.
+ *   - count_labels: The number of labels in the symbol table.
+ *   - count_probes: The number of slots visited by the lookups of the label and macro hash tables.
+ *   - bytes_read: The number of characters read from the source.
+ *   - bytes_written: The number of characters written to the output files (and the '.am' file, if written).
+ *   - count_cache_hits: The number of files restored from the cache ('--cache' option) instead of being assembled.
+ */
+typedef struct stats_struct * ptr_stats;
+typedef struct stats_struct {
+    int count_files;
+    double time_phases[COUNT_PHASES];
+    long count_lines;
+    long count_macro_calls;
+    long count_labels;
+    long count_probes;
+    long bytes_read;
+    long bytes_written;
+    long count_cache_hits;
+} item_stats;
+
+/*
+ * Function: init_stats
+ * --------------------
+ * Initializes empty statistics (every time and counter is zero).
+ *
+ * Parameters:
+ *   - stats: A pointer to the statistics to be initialized.
+ */
+void init_stats(ptr_stats stats);
+
+/*
+ * Function: get_time_now
+ * ----------------------
+ * Returns the current time of a monotonic clock.
+ *
+ * Returns:
+ *   - double: The time, in seconds, from an arbitrary starting point. Only the difference of two times is meaningful.
+ */
+double get_time_now(void);
+
+/*
+ * Function: add_time_of_phase
+ * ---------------------------
+ * Adds the time that passed since 'start' to the time of a phase.
+ *
+ * Parameters:
+ *   - stats: A pointer to the statistics.
+ *   - phase: The phase that ran since 'start'.
+ *   - start: The time at which the phase started ('get_time_now').
+ *
+ * Returns:
+ *   - double: The current time, so it can be used as the start of the next phase.
+ */
+double add_time_of_phase(ptr_stats stats, phase_of_stats phase, double start);
+
+/*
+ * Function: add_stats
+ * -------------------
+ * Adds the statistics of a file (or of several files) to a sum of statistics.
+ *
+ * Parameters:
+ *   - total: A pointer to the sum of statistics.
+ *   - stats: A pointer to the statistics to be added.
+ */
+void add_stats(ptr_stats total, ptr_stats stats);
+
+/*
+ * Function: print_stats
+ * ---------------------
+ * Prints the statistics of a file.
+ *
+ * Parameters:
+ *   - file_log: The stream that receives the statistics (the console messages of the file).
+ *   - stats: A pointer to the statistics.
+ */
+void print_stats(FILE *file_log, ptr_stats stats);
+
+/*
+ * Function: print_total_stats
+ * ---------------------------
+ * Prints the sum of the statistics of all the files of the run, with the wall time and the peak RSS of the process.
+ *
+ * Parameters:
+ *   - file_log: The stream that receives the statistics.
+ *   - total: A pointer to the sum of the statistics of the files.
+ *   - time_run: The wall time of the whole run, in seconds. With more than one job it is less than the sum of the
+ *               times of the phases, which are summed over the files.
+ *
+ * Notes:
+ *   - The peak RSS is the maximum resident set size of the process ('getrusage'). It is not the peak of the heap: it
+ *     also counts the program, its stack and the stacks of the threads, and it covers every file of the run so far.
+ */
+void print_total_stats(FILE *file_log, ptr_stats total, double time_run);
+
+#endif /* STATS_TOOL_H */
@@ -1,61 +1,84 @@
 #include "text_tool.h"
 
-/* Function: initialize_variables (Static Function)
- * -----------------------------------------------
- * Initializes the fields of a line struct to zero.
+/* The words of a line that are not kept in the copy of the line (never written through the pointers) */
+static char empty_word[] = "";
+static char comma_word[] = ",";
+
+/* Function: is_word_delimiter
+ * ---------------------------
+ * Checks if a character ends a word of a line of assembly code.
+ *
+ * Parameters:
+ *   - c: The character to be checked.
  *
- * This function takes a pointer to a line struct 'line_struct' and resets all fields of the struct
- * to zero or empty strings. This function is intended for internal use within the 'create_new_line_struct'
- * function to initialize the newly created line struct.
+ * Returns:
+ *   - bool: 'TRUE' if 'c' is a whitespace, a comma, a newline or the null terminator, 'FALSE' otherwise.
+ */
+static bool is_word_delimiter(char c);
+
+/* Macros: SWAR_ONES, SWAR_HIGHS, SWAR_NONZERO_BYTES, SWAR_BYTES_EQUAL
+ * -------------------------------------------------------------------
+ * Word-at-a-time ("SIMD within a register") tests on the bytes of an 'unsigned long' chunk of a line:
+ *   - SWAR_ONES: A chunk with every byte equal to 1.
+ *   - SWAR_HIGHS: A chunk with the high bit of every byte set.
+ *   - SWAR_NONZERO_BYTES(x): The high bit of every byte of 'x' that is not zero (exact for every byte, no carries
+ *     between the bytes).
+ *   - SWAR_BYTES_EQUAL(x, c): The high bit of every byte of 'x' that is equal to the character 'c'.
+ */
+#define SWAR_ONES ((unsigned long) -1 / 255)
+#define SWAR_HIGHS (SWAR_ONES * 128)
+#define SWAR_NONZERO_BYTES(x) (((((x) & ~SWAR_HIGHS) + ~SWAR_HIGHS) | (x)) & SWAR_HIGHS)
+#define SWAR_BYTES_EQUAL(x, c) (~SWAR_NONZERO_BYTES((x) ^ (SWAR_ONES * (unsigned char) (c))) & SWAR_HIGHS)
+
+/* Function: skip_blanks_of_line
+ * -----------------------------
+ * Skips the spaces and tabs of the copy of a line in a line struct, from 'position'.
  *
  * Parameters:
- *   - line_struct: A pointer to the line struct to be initialized.
+ *   - text: The text of a line struct (an array of 'MAX_ASSEMBLY_LINE_LENGTH' characters).
+ *   - position: The position to start from.
+ *
+ * Returns:
+ *   - int: The position of the first character that is not a space or a tab.
  *
- * Remarks:
- *   - The 'initialize_variables' function is called to ensure that all fields of the newly created line struct
- *     have a known and consistent initial state. This helps avoid issues with uninitialized memory.
- *   - The function uses the 'memset' function to set all fields of the line struct to zero or empty strings.
- *   - The 'initialize_variables' function is declared as a static function, which means it is only accessible
- *     within the scope of this source file and cannot be used directly from other source files.
+ * Notes:
+ *   - The chunks of 'sizeof(unsigned long)' characters that are all blanks are skipped at once (SWAR), the last
+ *     chunk is scanned one character at a time. A chunk is only read if it is inside the array, so the function
+ *     never reads past the text of the line struct.
+ *   - If 'SCAN_SCALAR' is defined when building, every character is checked by itself.
  */
-static void initialize_variables(ptr_line line_struct);
+static int skip_blanks_of_line(const char *text, int position);
 
-/* Function: fix_comma_in_line
- * ---------------------------
- * Modifies a line of assembly code to add spaces around commas.
+/* Function: find_end_of_word
+ * --------------------------
+ * Finds the end of the word that starts at 'position' in the copy of a line in a line struct.
  *
  * Parameters:
- *   - line: A pointer to a string containing the original line of assembly code.
+ *   - text: The text of a line struct (an array of 'MAX_ASSEMBLY_LINE_LENGTH' characters).
+ *   - position: The position of the first character of the word.
  *
  * Returns:
- *   - char*: A pointer to a string containing the modified line with spaces around commas. This string is
- *            stored in a static buffer, and the caller should not attempt to modify or free the memory.
- *            The buffer is reused for each call to this function, so the contents are not persistent.
+ *   - int: The position of the first delimiter after the word ('is_word_delimiter').
  *
  * Notes:
- *   - The function scans through the input 'line' character by character and replaces any commas encountered
- *     with a comma surrounded by spaces. For example, "ADD R1,R2" becomes "ADD R1 , R2" after modification.
- *   - The function ensures that the modified line ends with a newline character '\n' and a null terminator '\0'
- *     to ensure compatibility with standard C strings.
- *   - The function is designed to handle assembly code lines of up to 'MAX_ASSEMBLY_LINE_LENGTH' characters in length.
- *     If the input line exceeds this length, the behavior is undefined.
- *   - The function does not modify the original input 'line'.
+ *   - The chunks of 'sizeof(unsigned long)' characters without a delimiter are skipped at once (SWAR), with the same
+ *     bounds and the same 'SCAN_SCALAR' fallback as 'skip_blanks_of_line'.
  */
-static char * fix_comma_in_line(const char *line);
+static int find_end_of_word(const char *text, int position);
 
 /* Function: is_register
  * ---------------------
  * Checks if the given text represents a valid register in assembly code.
  *
  * This function takes a pointer to a character array 'text', representing a string of text in assembly code.
- * It checks whether the 'text' matches any of the predefined register names ('@r1', '@r2', ..., '@r7').
+ * It checks whether the 'text' matches any of the predefined register names ('@r0', '@r1', ..., '@r7') with a lookup in the table of keywords.
  * If 'text' matches any of the register names, the function returns 'TRUE'; otherwise, it returns 'FALSE'.
  *
  * Parameters:
  *   - text: A pointer to a character array (string) representing the text to be checked for a register match.
  *
  * Returns:
- *   - bool: 'TRUE' if 'text' represents a valid register ('@r1', '@r2', ..., '@r7'), 'FALSE' otherwise.
+ *   - bool: 'TRUE' if 'text' represents a valid register ('@r0', '@r1', ..., '@r7'), 'FALSE' otherwise.
  *
  * Notes:
  *   - The function is case-sensitive; register names must be in lowercase (e.g., "@r1") to be recognized as valid.
@@ -65,168 +88,235 @@ static char * fix_comma_in_line(const char *line);
  */
 static bool is_register(char * text);
 
-/* Function: get_specific_bits
+/* The two base64 characters of every 12-bit word, built once by 'init_base64_pairs' */
+static char base64_pairs[BASE64_TABLE_SIZE][2];
+static pthread_once_t base64_pairs_once = PTHREAD_ONCE_INIT;
+
+/* Function: init_base64_pairs
  * ---------------------------
- * Extracts a specific sequence of bits from an unsigned integer word.
- *
- * This function is used to extract a specific sequence of bits from the input 'word', an unsigned integer. The 'start'
- * and 'end' parameters define the range of bits to be extracted, both inclusive. The extracted sequence is then
- * returned as an unsigned integer.
- *
- * Parameters:
- *   - word: The unsigned integer containing the bit sequence from which bits are to be extracted.
- *   - start: The starting position (index) of the bit sequence to be extracted (0-based index).
- *   - end: The ending position (index) of the bit sequence to be extracted (0-based index).
- *
- * Returns:
- *   - unsigned int: An unsigned integer containing the extracted bit sequence.
+ * Builds the 'base64_pairs' table: for every 12-bit word, the base64 character of its high 6 bits followed by the
+ * base64 character of its low 6 bits.
  *
  * Notes:
- *   - The function uses bit manipulation to extract the specific bit sequence efficiently.
- *   - It calculates the length of the bit sequence to be extracted and creates a corresponding mask with '1's in the
- *     relevant positions to retain the bits of interest while setting other bits to 0.
- *   - The function then applies the mask to the original 'word' using bitwise AND and shifts the extracted sequence
- *     to the least significant bits (LSB) position to obtain the final result.
- *   - The function is primarily used as a helper function within other functions that require specific bits from a word.
+ *   - The function is called only through 'pthread_once', so the table is built once even when several files are
+ *     assembled at the same time.
  */
-static unsigned int get_specific_bits(unsigned int word, int start, int end);
+static void init_base64_pairs(void);
 
-/* Function: pow_math
- * ------------------
- * Calculates the result of an exponentiation operation with integer inputs.
- *
- * This function calculates the result of 'BASE_POW' raised to the power of 'exp', where 'BASE_POW' is a constant integer
- * value representing the base of the exponentiation. The exponent 'exp' is a non-negative integer that determines how
- * many times 'BASE_POW' should be multiplied by itself.
- *
- * Parameters:
- *   - exp: The exponent to which 'BASE_POW' is raised. It must be a non-negative integer.
- *
- * Returns:
- *   - int: The result of 'BASE_POW' raised to the power of 'exp'.
- *
- * Example:
- *   - Suppose 'BASE_POW' is 2, and 'exp' is 3. The function call would be: 'pow_math(3)'. The result of 2^3 is 8, so the
- *     function will return 8.
+/* Macro: KEYWORD_HASH
+ * -------------------
+ * The hash of a word of 'length' characters (at least one) in the table of keywords. It mixes the first, the second and
+ * the last characters of the word with its length.
  *
  * Notes:
- *   - The function uses bitwise operations to efficiently calculate the exponentiation result.
- *   - If the input 'exp' is negative, the function will return -1 to indicate an invalid input.
- *   - The function is primarily used as a helper function within other functions that require exponentiation.
+ *   - The multipliers were chosen so that no two keywords have the same hash (a perfect hash), so a word is compared
+ *     with one keyword at most. If a keyword is added, they must be chosen again so the table stays collision free.
  */
-static int pow_math(int exp);
-
-ptr_line create_new_line_struct(const char *text_line){
+#define KEYWORD_HASH(word, length)                                                                          \
+    ((5 * (unsigned char) (word)[0] + 6 * (unsigned char) (word)[1] + 7 * (unsigned char) (word)[(length) - 1] \
+      + 2 * (length)) & (KEYWORD_TABLE_SIZE - 1))
+
+/* The table of keywords (instructions, directives and registers), every keyword in the slot of its 'KEYWORD_HASH'.
+ * This is the only list of the keywords of the language; an empty slot has no name. Every keyword is used by
+ * 'Tests/good_test4.as', so a keyword that is not in its slot fails the tests. */
+static const item_keyword keyword_table[KEYWORD_TABLE_SIZE] = {
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 0 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 1 */
+        {"@r0", KEYWORD_REGISTER, 0}, /* 2 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 3 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 4 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 5 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 6 */
+        {"bne", KEYWORD_INSTRUCTION, BNE}, /* 7 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 8 */
+        {"@r1", KEYWORD_REGISTER, 1}, /* 9 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 10 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 11 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 12 */
+        {"dec", KEYWORD_INSTRUCTION, DEC}, /* 13 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 14 */
+        {"stop", KEYWORD_INSTRUCTION, STOP}, /* 15 */
+        {"@r2", KEYWORD_REGISTER, 2}, /* 16 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 17 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 18 */
+        {"cmp", KEYWORD_INSTRUCTION, CMP}, /* 19 */
+        {".extern", KEYWORD_DIRECTIVE, STATUS_EXTERN}, /* 20 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 21 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 22 */
+        {"@r3", KEYWORD_REGISTER, 3}, /* 23 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 24 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 25 */
+        {"red", KEYWORD_INSTRUCTION, RED}, /* 26 */
+        {"clr", KEYWORD_INSTRUCTION, CLR}, /* 27 */
+        {"inc", KEYWORD_INSTRUCTION, INC}, /* 28 */
+        {"rts", KEYWORD_INSTRUCTION, RTS}, /* 29 */
+        {"@r4", KEYWORD_REGISTER, 4}, /* 30 */
+        {".entry", KEYWORD_DIRECTIVE, STATUS_ENTRY}, /* 31 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 32 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 33 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 34 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 35 */
+        {"prn", KEYWORD_INSTRUCTION, PRN}, /* 36 */
+        {"@r5", KEYWORD_REGISTER, 5}, /* 37 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 38 */
+        {"lea", KEYWORD_INSTRUCTION, LEA}, /* 39 */
+        {"jsr", KEYWORD_INSTRUCTION, JSR}, /* 40 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 41 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 42 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 43 */
+        {"@r6", KEYWORD_REGISTER, 6}, /* 44 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 45 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 46 */
+        {".data", KEYWORD_DIRECTIVE, STATUS_DATA}, /* 47 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 48 */
+        {"sub", KEYWORD_INSTRUCTION, SUB}, /* 49 */
+        {"not", KEYWORD_INSTRUCTION, NOT}, /* 50 */
+        {"@r7", KEYWORD_REGISTER, 7}, /* 51 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 52 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 53 */
+        {"jmp", KEYWORD_INSTRUCTION, JMP}, /* 54 */
+        {".string", KEYWORD_DIRECTIVE, STATUS_STRING}, /* 55 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 56 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 57 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 58 */
+        {"mov", KEYWORD_INSTRUCTION, MOV}, /* 59 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 60 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 61 */
+        {NULL, KEYWORD_INSTRUCTION, 0}, /* 62 */
+        {"add", KEYWORD_INSTRUCTION, ADD}  /* 63 */
+};
+
+void split_line_to_words(ptr_line line_struct, const char *text_line){
     int i = 0; /* Line index */
-    int j; /* Word index */
-    static char temp_word[MAX_ASSEMBLY_LINE_LENGTH] = "";
-    static char temp_line[MAX_ASSEMBLY_LINE_LENGTH] = "";
-    ptr_line new_line;
-
-    /* Fix comma-related issues in the input line */
-    strcpy(temp_line, fix_comma_in_line(text_line));
+    int number; /* Index of the next word in 'words' */
+    char delimiter;
+    size_t length = strlen(text_line);
 
-    /* Dynamic memory allocation for the new line struct */
-    new_line = (ptr_line)malloc(sizeof(item_line)); /* Dynamic memory allocation */
-    if (new_line == NULL){ /* Checking whether the memory allocation was successful */
-        fprintf(stderr, "Error in dynamic memory allocation");
-        exit(EXIT_FAILURE);
+    /* Copy only the characters of the line (not the rest of the array), its words are ended in place */
+    if (length > MAX_ASSEMBLY_LINE_LENGTH - 1){
+        length = MAX_ASSEMBLY_LINE_LENGTH - 1;
     }
+    memcpy(line_struct->text, text_line, length);
+    line_struct->text[length] = '\0';
 
-    /* Initialize all variables in the new line struct to zero */
-    initialize_variables(new_line);
-
-    i = skip_white_character(i,text_line);
-
-    /* If the line is empty (only contains a white character), set 'count' to zero and return */
-    if(temp_line[i] == '\n'){
-        new_line ->count = ZERO;
-        return new_line;
+    /* Every word that is not found in the line is an empty string */
+    for (number = 0; number <= MAX_WORDS_IN_LINE; number++){
+        line_struct->words[number] = empty_word;
+        line_struct->columns[number] = 0;
     }
+    line_struct->first_word = 0;
+    line_struct->source = NOT_EXIST;
+    line_struct->destination = NOT_EXIST;
+
+    number = 0;
+    i = skip_blanks_of_line(line_struct->text, i);
+    while (line_struct->text[i] != '\n' && line_struct->text[i] != '\0'){
+        /* More than five words in the line */
+        if (number == MAX_WORDS_IN_LINE){
+            line_struct->count = TOO_MUCH;
+            return;
+        }
 
-    /* Macro to extract individual words from 'temp_line' and store them in the line struct */
-    GET_WORD(word1, ONE)
-    GET_WORD(word2, TWO)
-    GET_WORD(word3, TREE)
-    GET_WORD(word4, FOUR)
-    GET_WORD(word5, FIVE)
-
-    /* Set 'source' and 'destination' flags to 'NOT_EXIST', and 'count' to 'TOO_MUCH' indicating more than five words */
-    new_line->source = NOT_EXIST;
-    new_line->destination = NOT_EXIST;
-    new_line ->count = TOO_MUCH;
-    return new_line;
-}
-
-static void initialize_variables(ptr_line line_struct){
-    memset(line_struct->word1, 0, MAX_ASSEMBLY_LINE_LENGTH);
-    memset(line_struct->word2, 0, MAX_ASSEMBLY_LINE_LENGTH);
-    memset(line_struct->word3, 0, MAX_ASSEMBLY_LINE_LENGTH);
-    memset(line_struct->word4, 0, MAX_ASSEMBLY_LINE_LENGTH);
-    memset(line_struct->word5, 0, MAX_ASSEMBLY_LINE_LENGTH);
-    line_struct->count = 0;
+        if (line_struct->text[i] == ','){
+            /* A comma is a word of its own */
+            line_struct->words[number] = comma_word;
+            line_struct->columns[number] = i + 1;
+            i++;
+        } else {
+            /* Find the end of the word and end it with a null terminator (a comma after it is kept in 'delimiter') */
+            line_struct->words[number] = &line_struct->text[i];
+            line_struct->columns[number] = i + 1;
+            i = find_end_of_word(line_struct->text, i);
+            delimiter = line_struct->text[i];
+            line_struct->text[i] = '\0';
+            if (delimiter == ','){
+                number++;
+                if (number == MAX_WORDS_IN_LINE){
+                    line_struct->count = TOO_MUCH;
+                    return;
+                }
+                line_struct->words[number] = comma_word;
+                line_struct->columns[number] = i + 1;
+            }
+            if (delimiter != '\n' && delimiter != '\0'){
+                i++;
+            }
+        }
+        number++;
+        i = skip_blanks_of_line(line_struct->text, i);
+    }
+    line_struct->count = (count_word_in_line) number;
 }
 
-void delete_label_from_line_struct(ptr_line line_struct){
-    /* Copy the content of each word to the previous word, effectively deleting the first word */
-    strcpy(line_struct->word1,line_struct->word2);
-    strcpy(line_struct->word2,line_struct->word3);
-    strcpy(line_struct->word3,line_struct->word4);
-    strcpy(line_struct->word4,line_struct->word5);
+void copy_line_struct(ptr_line line_struct, const item_line *source_line){
+    int number;
 
-    /* Clear the content of the fifth word (set all characters to null) */
-    memset(line_struct->word5, 0, MAX_ASSEMBLY_LINE_LENGTH);
+    *line_struct = *source_line;
 
-    /* If the line struct's 'count' indicates that there were less than five words originally, decrement the 'count' */
-    if (line_struct->count != TOO_MUCH){
-        (line_struct->count)--;
+    /* Every word of the text is moved to the text of the copy, the constant words are shared */
+    for (number = 0; number <= MAX_WORDS_IN_LINE; number++){
+        if (source_line->words[number] != empty_word && source_line->words[number] != comma_word){
+            line_struct->words[number] = line_struct->text + (source_line->words[number] - source_line->text);
+        }
     }
 }
 
-void free_line(ptr_line line_struct){
-    /* Check if 'line_struct' is not NULL before attempting to free the memory */
-    if (line_struct != NULL){
-        free(line_struct);
+static int skip_blanks_of_line(const char *text, int position){
+#ifndef SCAN_SCALAR
+    unsigned long chunk;
+
+    /* Skip whole chunks while every character of the chunk is a space or a tab */
+    while (position + (int) sizeof(unsigned long) <= MAX_ASSEMBLY_LINE_LENGTH){
+        memcpy(&chunk, text + position, sizeof(unsigned long));
+        if ((SWAR_BYTES_EQUAL(chunk, ' ') | SWAR_BYTES_EQUAL(chunk, '\t')) != SWAR_HIGHS){
+            break;
+        }
+        position += (int) sizeof(unsigned long);
+    }
+#endif
+    /* Find the first character that is not blank in the last chunk */
+    while (text[position] == ' ' || text[position] == '\t'){
+        position++;
     }
+    return position;
 }
 
-static char * fix_comma_in_line(const char *line){
-    int i = 0; /* Index for scanning the input line */
-    int j = 0; /* Index for building the modified line */
-
-    /* Buffer to store the modified line with spaces around commas */
-    static char temp_line[MAX_ASSEMBLY_LINE_LENGTH] = "";
-
-    /* Scan through the input 'line' and modify commas to include spaces around them */
-    while (line[i] != '\n' && line[i] != '\0'){
-        if (line[i] == ','){
-            /* Add a space before the comma */
-            temp_line[j] = ' ';
-            j++;
-
-            /* Copy the comma to the modified line */
-            temp_line[j] = line[i];
-            j++;
+static int find_end_of_word(const char *text, int position){
+#ifndef SCAN_SCALAR
+    unsigned long chunk;
 
-            /* Add a space after the comma */
-            temp_line[j] = ' ';
-            j++;
-        } else {
-            /* Copy non-comma characters as they are */
-            temp_line[j] = line[i];
-            j++;
+    /* Skip whole chunks while no character of the chunk ends a word */
+    while (position + (int) sizeof(unsigned long) <= MAX_ASSEMBLY_LINE_LENGTH){
+        memcpy(&chunk, text + position, sizeof(unsigned long));
+        if ((SWAR_BYTES_EQUAL(chunk, ' ') | SWAR_BYTES_EQUAL(chunk, '\t') | SWAR_BYTES_EQUAL(chunk, ',') |
+             SWAR_BYTES_EQUAL(chunk, '\n') | (~SWAR_NONZERO_BYTES(chunk) & SWAR_HIGHS)) != 0){
+            break;
         }
+        position += (int) sizeof(unsigned long);
+    }
+#endif
+    /* Find the delimiter in the last chunk */
+    while (is_word_delimiter(text[position]) == FALSE){
+        position++;
+    }
+    return position;
+}
 
-        /* Move to the next character in the input line */
-        i++;
+static bool is_word_delimiter(char c){
+    if (c == ' ' || c == '\t' || c == ',' || c == '\n' || c == '\0'){
+        return TRUE;
     }
-    /* Ensure the modified line ends with a newline character and a null terminator */
-    temp_line[j] = '\n';
-    j++;
-    temp_line[j] = '\0';
+    return FALSE;
+}
 
-    /* Return a pointer to the modified line (stored in the static buffer) */
-    return  temp_line;
+void delete_label_from_line_struct(ptr_line line_struct){
+    /* Move the first word to the next word, effectively deleting the label */
+    (line_struct->first_word)++;
+
+    /* If the line struct's 'count' indicates that there were less than five words originally, decrement the 'count' */
+    if (line_struct->count != TOO_MUCH){
+        (line_struct->count)--;
+    }
 }
 
 int skip_white_character(int curr_position, const char *text){
@@ -269,18 +359,17 @@ bool is_end_line(int curr_position, const char *line_text){
 
 bool is_label(ptr_line line_struct){
     int i = 0;
-    char temp_first_word[MAX_ASSEMBLY_LINE_LENGTH];
-    strcpy(temp_first_word, line_struct->word1);
+    char *first_word = WORD_OF_LINE(line_struct, 1);
 
     /* Find the last character in the first word */
-    while (temp_first_word[i + 1] != '\0'){
+    while (first_word[i + 1] != '\0'){
         i++;
     }
 
     /* Check if the last character is a colon (':'), indicating a label */
-    if(temp_first_word[i] == ':') {
+    if(first_word[i] == ':') {
         /* Remove the colon by replacing it with the null terminator */
-        line_struct->word1[i] = '\0';
+        first_word[i] = '\0';
         return TRUE; /* The first word is a label */
     }
     return FALSE; /* The first word is not a label */
@@ -329,15 +418,12 @@ bool is_line_empty(const char *line_text){
 }
 
 static bool is_register(char *text) {
-    /* List of valid register names in assembly (e.g., '@r1', '@r2', ..., '@r7') */
-    if (strcmp(text, "@r1") == 0 || strcmp(text, "@r2") == 0 ||
-        strcmp(text, "@r3") == 0 || strcmp(text, "@r4") == 0 ||
-        strcmp(text, "@r5") == 0 || strcmp(text, "@r6") == 0 ||
-        strcmp(text, "@r7") == 0 || strcmp(text, "@r0") == 0) {
-        /* The text matches one of the valid register names */
+    ptr_keyword keyword = find_keyword(text);
+
+    /* The text is one of the valid register names ('@r0' to '@r7') */
+    if (keyword != NULL && keyword->type == KEYWORD_REGISTER) {
         return TRUE;
     }
-    /* The text does not match any of the valid register names */
     return FALSE;
 }
 
@@ -374,57 +460,55 @@ bool is_label_name_valid(char *name_label){
 }
 
 bool is_name_a_reserved_word(char *name){
-    if (strcmp(name, ".data") == 0) { return TRUE; }
-    if (strcmp(name, ".string") == 0) { return TRUE; }
-    if (strcmp(name, ".entry") == 0) { return TRUE; }
-    if (strcmp(name, ".extern") == 0) { return TRUE; }
-    if (strcmp(name, "@r0") == 0) { return TRUE; }
-    if (strcmp(name, "@r2") == 0) { return TRUE; }
-    if (strcmp(name, "@r3") == 0) { return TRUE; }
-    if (strcmp(name, "@r4") == 0) { return TRUE; }
-    if (strcmp(name, "@r5") == 0) { return TRUE; }
-    if (strcmp(name, "@r6") == 0) { return TRUE; }
-    if (strcmp(name, "@r7") == 0) { return TRUE; }
-    if (strcmp(name, "mov") == 0) { return TRUE; }
-    if (strcmp(name, "cmp") == 0) { return TRUE; }
-    if (strcmp(name, "add") == 0) { return TRUE; }
-    if (strcmp(name, "sub") == 0) { return TRUE; }
-    if (strcmp(name, "not") == 0) { return TRUE; }
-    if (strcmp(name, "clr") == 0) { return TRUE; }
-    if (strcmp(name, "lea") == 0) { return TRUE; }
-    if (strcmp(name, "inc") == 0) { return TRUE; }
-    if (strcmp(name, "dec") == 0) { return TRUE; }
-    if (strcmp(name, "jmp") == 0) { return TRUE; }
-    if (strcmp(name, "bne") == 0) { return TRUE; }
-    if (strcmp(name, "red") == 0) { return TRUE; }
-    if (strcmp(name, "prn") == 0) { return TRUE; }
-    if (strcmp(name, "jsr") == 0) { return TRUE; }
-    if (strcmp(name, "rts") == 0) { return TRUE; }
-    if (strcmp(name, "stop") == 0) { return TRUE; }
+    /* Every instruction, directive and register is a keyword */
+    if (find_keyword(name) != NULL) {
+        return TRUE;
+    }
     return FALSE;
 }
 
-
 instruction_type get_instruction_type(const char *word){
-    if (strcmp(word, "mov") == 0) { return MOV; }
-    if (strcmp(word, "cmp") == 0) { return CMP; }
-    if (strcmp(word, "add") == 0) { return ADD; }
-    if (strcmp(word, "sub") == 0) { return SUB; }
-    if (strcmp(word, "not") == 0) { return NOT; }
-    if (strcmp(word, "clr") == 0) { return CLR; }
-    if (strcmp(word, "lea") == 0) { return LEA; }
-    if (strcmp(word, "inc") == 0) { return INC; }
-    if (strcmp(word, "dec") == 0) { return DEC; }
-    if (strcmp(word, "jmp") == 0) { return JMP; }
-    if (strcmp(word, "bne") == 0) { return BNE; }
-    if (strcmp(word, "red") == 0) { return RED; }
-    if (strcmp(word, "prn") == 0) { return PRN; }
-    if (strcmp(word, "jsr") == 0) { return JSR; }
-    if (strcmp(word, "rts") == 0) { return RTS; }
-    if (strcmp(word, "stop") == 0) { return STOP; }
+    ptr_keyword keyword = find_keyword(word);
+
+    if (keyword != NULL && keyword->type == KEYWORD_INSTRUCTION) {
+        return (instruction_type) keyword->value;
+    }
     return NOT_INSTRUCTION;
 }
 
+line_status get_directive_status(const char *word){
+    ptr_keyword keyword = find_keyword(word);
+
+    if (keyword != NULL && keyword->type == KEYWORD_DIRECTIVE) {
+        return (line_status) keyword->value;
+    }
+    /* A word that is not a directive is an instruction (or a label) */
+    return STATUS_CODE;
+}
+
+ptr_keyword find_keyword(const char *word){
+    ptr_keyword keyword;
+    int length = 0;
+
+    /* Find the length of the word, a word longer than every keyword is not a keyword */
+    while (word[length] != '\0'){
+        if (length == MAX_KEYWORD_LENGTH){
+            return NULL;
+        }
+        length++;
+    }
+    if (length == 0){
+        return NULL;
+    }
+
+    /* The only keyword that can be in the slot of the word is the one with the same hash, compare with it */
+    keyword = &keyword_table[KEYWORD_HASH(word, length)];
+    if (keyword->name != NULL && strcmp(keyword->name, word) == 0){
+        return keyword;
+    }
+    return NULL;
+}
+
 addressing_method get_addressing_method_type(char *word){
     if (word[0] == '\0') { return NOT_EXIST; }
     if (is_number(word) == TRUE) { return IMMEDIATE; }
@@ -436,68 +520,71 @@ int get_number_of_register(char *register_name) {
     return (register_name[2] - '0');
 }
 
-char * convert_binary_to_64base(unsigned int word){
+static void init_base64_pairs(void){
     /* Base64 encoding lookup table */
-    char base64_table[] = {'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H',
-                        'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
-                        'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X',
-                        'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f',
-                        'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n',
-                        'o', 'p', 'q', 'r', 's', 't', 'u', 'v',
-                        'w', 'x', 'y', 'z', '0', '1', '2', '3',
-                        '4', '5', '6', '7', '8', '9', '+', '/'};
-
-    /* Allocate memory for the base64 representation */
-    char *word_in_64base = (char *) malloc(BASE64_CHAR_LENGTH);
-    if (word_in_64base == NULL){
-        /* Memory allocation failure */
-        fprintf(stderr, "Error in dynamic memory allocation");
-        exit(EXIT_FAILURE);
-    }
-    /* Convert the 6-bit binary word to base64 representation */
-    word_in_64base[0] = base64_table[get_specific_bits(word, 6, 11)];
-    word_in_64base[1] = base64_table[get_specific_bits(word,0,5)];
-    word_in_64base[2] = '\n'; /* Add newline character */
-    word_in_64base[3] = '\0'; /* Null terminator to indicate the end of the string */
-    return word_in_64base;
-}
+    const char base64_table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    int word;
 
-static unsigned int get_specific_bits(unsigned int word, int start, int end){
-    unsigned int result;
-    int length = end - start + 1; /* Length of bit-sequence */
-
-    /* Create a mask with 'length' number of 1's (e.g., 000...0111...1) */
-    unsigned int mask = pow_math(length) - 1;
+    for (word = 0; word < BASE64_TABLE_SIZE; word++){
+        base64_pairs[word][0] = base64_table[(word >> 6) & 63];
+        base64_pairs[word][1] = base64_table[word & 63];
+    }
+}
 
-    /* Shift the mask to the position of the bit sequence to be extracted */
-    mask <<= start;
+size_t encode_words_to_64base(const unsigned int *words, int count_words, char *output){
+    const char *pair;
+    int i;
 
-    /* Apply the mask to 'word' using bitwise AND to extract the specific bits */
-    result = word & mask;
+    /* Build the table on the first call */
+    pthread_once(&base64_pairs_once, init_base64_pairs);
 
-    /* Shift the extracted sequence to the least significant bits (LSB) position */
-    result >>= start;
-    return result;
+    /* Every word becomes its two characters from the table and a newline */
+    for (i = 0; i < count_words; i++){
+        pair = base64_pairs[words[i] & (BASE64_TABLE_SIZE - 1)];
+        output[0] = pair[0];
+        output[1] = pair[1];
+        output[2] = '\n';
+        output += BASE64_WORD_LENGTH;
+    }
+    return (size_t) count_words * BASE64_WORD_LENGTH;
 }
 
-static int pow_math(int exp){
-    int base = BASE_POW;
-    int result = 1;
-
-    /* Check if the exponent is negative (invalid input) and return -1 */
-    if(exp < 0){
-        return -1;
+int decode_64base_to_word(const char *text){
+    int word = 0;
+    int value;
+    int i;
+
+    for (i = 0; i < 2; i++){
+        /* The value of the character in the base64 table ("A-Z", "a-z", "0-9", '+', '/') */
+        if (text[i] >= 'A' && text[i] <= 'Z'){
+            value = text[i] - 'A';
+        } else if (text[i] >= 'a' && text[i] <= 'z'){
+            value = text[i] - 'a' + 26;
+        } else if (text[i] >= '0' && text[i] <= '9'){
+            value = text[i] - '0' + 52;
+        } else if (text[i] == '+'){
+            value = 62;
+        } else if (text[i] == '/'){
+            value = 63;
+        } else {
+            return -1;
+        }
+        word = (word << 6) | value;
     }
+    return word;
+}
 
-    /* Perform binary exponentiation algorithm to calculate the result */
-    while (exp){
-        if (exp & 1){ /* If the current bit of 'exp' is 1 */
-            result *= base; /* Multiply the result by the current 'base' value */
-        }
-        exp >>= 1; /* Right shift 'exp' to move to the next bit */
-        base *= base; /* Square the 'base' value for the next iteration */
+unsigned long hash_name(const char *name){
+    /* FNV-1a offset basis */
+    unsigned long hash = 2166136261UL;
+
+    /* Mix every character of the name into the hash value */
+    while (*name != '\0'){
+        hash ^= (unsigned char) *name;
+        hash = (hash * 16777619UL) & 0xFFFFFFFFUL; /* FNV prime, kept to 32 bits */
+        name++;
     }
-    return result;
+    return hash;
 }
 
 void print_red(){
@@ -509,11 +596,10 @@ void print_reset(){
 }
 
 __attribute__((unused)) void print_line(ptr_line line_struct){
-    printf("%s ",line_struct->word1);
-    printf("%s ",line_struct->word2);
-    printf("%s ",line_struct->word3);
-    printf("%s ",line_struct->word4);
-    printf("%s ",line_struct->word5);
+    int number;
+    for (number = 1; number <= MAX_WORDS_IN_LINE; number++){
+        printf("%s ", WORD_OF_LINE(line_struct, number));
+    }
     printf("source: %d ",line_struct->source);
     printf("destination: %d ",line_struct->destination);
     printf("count: %d\n",line_struct->count);
@@ -9,6 +9,7 @@
  *   - stdlib.h: Contains general utility functions like memory allocation and conversion functions.
  *   - string.h: Contains string manipulation functions like strcpy and strcat.
  *   - ctype.h: Provides character handling functions like isdigit and isalpha.
+ *   - pthread.h: POSIX threads library. It is used to build the base64 table once for all the files.
  *   - error_tool.h: Contains functions and declarations for handling and reporting errors during the assembly process.
  *   - setting.h: Contains constant definitions and configurations used throughout the assembly process.
  */
@@ -20,43 +21,41 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <pthread.h>
 #include "error_tool.h"
 #include "setting.h"
 
-/* Macro: GET_WORD
- * ---------------
- * A helper macro for parsing words from the input 'temp_line' and storing them in the 'new_line' struct.
+/* Maximum number of words kept for a line of assembly code */
+#define MAX_WORDS_IN_LINE 5
+
+/* Macro: WORD_OF_LINE
+ * -------------------
+ * Gives the word number 'number' (1 to 5) of a line struct, counted from its first word.
  *
- * This macro is used to extract up to five words from the 'temp_line' and store them in the corresponding fields
- * of the 'new_line' struct. It advances the index 'i' through the 'temp_line', extracts words delimited by whitespace,
- * and copies them to 'new_line' fields 'word_number'. It also skips over any additional whitespace between words and
- * sets the 'count' field of 'new_line' to indicate if there are more words in the line beyond the fifth word.
+ * Parameters:
+ *   - line_struct: A pointer to the line struct.
+ *   - number: The number of the word in the line, 1 for the first word.
+ *
+ * Notes:
+ *   - The value is a 'char *' lvalue, a word that does not exist in the line is an empty string.
+ *   - When the label of the line is deleted ('delete_label_from_line_struct'), the first word moves to the next word,
+ *     so the numbers of the words are shifted without copying any text.
+ */
+#define WORD_OF_LINE(line_struct, number) ((line_struct)->words[(line_struct)->first_word + (number) - 1])
+
+/* Macro: COLUMN_OF_LINE
+ * ---------------------
+ * Gives the column of the word number 'number' (1 to 5) of a line struct, counted from its first word like
+ * 'WORD_OF_LINE'.
  *
  * Parameters:
- *   - word_number: The identifier for the field in the 'new_line' struct where the word should be stored (e.g., word1, word2, etc.).
- *   - number: The current count of words found so far in the line.
+ *   - line_struct: A pointer to the line struct.
+ *   - number: The number of the word in the line, 1 for the first word.
  *
  * Notes:
- *   - The 'GET_WORD' macro is intended for use within the 'create_new_line_struct' function to simplify word extraction
- *     and assignment.
- */
-#define GET_WORD(word_number, number)                                                                       \
-j = 0;                                                                                                      \
-while (temp_line[i] != ' ' && temp_line[i] != '\t' && temp_line[i] != '\n' && temp_line[i] != '\0') {       \
-    temp_word[j] = temp_line[i];                                                                            \
-    i++;                                                                                                    \
-    j++;                                                                                                    \
-}                                                                                                           \
-temp_word[j] = '\0';                                                                                        \
-strcpy(new_line ->word_number, temp_word);                                                                  \
-memset(temp_word, 0, MAX_ASSEMBLY_LINE_LENGTH);                                                             \
-while (temp_line[i] == ' ' || temp_line[i] == '\t') {                                                       \
-i++;                                                                                                        \
-}                                                                                                           \
-if(temp_line[i] == '\n'||temp_line[i] == '\0'){                                                             \
-    new_line ->count = number;                                                                              \
-    return new_line;                                                                                        \
-}                                                                                                           \
+ *   - The column is counted from 1, it is 0 for a word that does not exist in the line.
+ */
+#define COLUMN_OF_LINE(line_struct, number) ((line_struct)->columns[(line_struct)->first_word + (number) - 1])
 
 /* Constants: Assembly Directives */
 #define DOT_DATA ".data" /* The assembly directive '.data'. */
@@ -189,64 +188,120 @@ typedef enum {
     RELOCATABLE     /* Relocatable encoding (variable's address is determined at linking time) */
 } encoding_type;
 
+/*
+ * Enum: keyword_type
+ * ------------------
+ * This enumeration represents the kinds of keywords (reserved words) of the assembly language.
+ *
+ * Constants:
+ *   - KEYWORD_INSTRUCTION: An instruction mnemonic (e.g., "mov"). The value of the keyword is its 'instruction_type'.
+ *   - KEYWORD_DIRECTIVE: A directive (e.g., ".data"). The value of the keyword is its 'line_status'.
+ *   - KEYWORD_REGISTER: A register (e.g., "@r1"). The value of the keyword is the number of the register.
+ */
+typedef enum {
+    KEYWORD_INSTRUCTION,    /* Instruction mnemonic */
+    KEYWORD_DIRECTIVE,      /* Assembly directive */
+    KEYWORD_REGISTER        /* CPU register */
+} keyword_type;
+
+/*
+ * Struct: item_keyword
+ * --------------------
+ * This struct represents a keyword of the assembly language in the table of keywords.
+ *
+ * Members:
+ *   - name: The text of the keyword (NULL for an empty slot of the table).
+ *   - type: The kind of the keyword.
+ *   - value: The value of the keyword, by its kind (see 'keyword_type').
+ */
+typedef const struct keyword_struct * ptr_keyword;
+typedef struct keyword_struct {
+    const char *name;   /* Text of the keyword */
+    keyword_type type;  /* Kind of the keyword */
+    int value;          /* Instruction type, line status or register number */
+} item_keyword;
+
+/* Number of slots of the table of keywords (a power of two) */
+#define KEYWORD_TABLE_SIZE 64
+
+/* Length of the longest keyword (".string" and ".extern") */
+#define MAX_KEYWORD_LENGTH 7
+
 /*
  * Struct: line_struct
  * -------------------
  * This struct represents a line of assembly code, storing its components and relevant information.
  *
  * Members:
- *   - word1: A character array to store the first word in the assembly line.
- *   - word2: A character array to store the second word in the assembly line.
- *   - word3: A character array to store the third word in the assembly line.
- *   - word4: A character array to store the fourth word in the assembly line.
- *   - word5: A character array to store the fifth word in the assembly line.
+ *   - text: A copy of the line, in which every word is ended by a null terminator.
+ *   - words: The words of the line. A word points into 'text', a comma points to a constant "," string and a word that
+ *            does not exist in the line points to a constant empty string. The last entry is always empty, so a line
+ *            whose label was deleted still has five words.
+ *   - columns: The column of every word in the line, counted from 1 (0 for a word that does not exist in the line).
+ *   - first_word: The index in 'words' of the first word of the line (one after the label was deleted).
  *   - source: An enumeration indicating the addressing method of the source operand in an instruction.
  *   - destination: An enumeration indicating the addressing method of the destination operand in an instruction.
  *   - count: An enumeration representing the count of words in the line (e.g., one, two, three, etc.).
  *
  * Notes:
  *   - The struct is used to store the components of an assembly line after parsing.
+ *   - The words are read with the 'WORD_OF_LINE' macro, and their columns with the 'COLUMN_OF_LINE' macro.
+ *   - The struct is reused for every line of a file, so parsing a line does not allocate memory.
  *   - The 'source' and 'destination' members specify the addressing method of the instruction operands.
  *   - The 'count' member indicates the number of words found in the line during assembly code parsing.
  *   - This struct is typically used to process and analyze individual lines of the assembly code.
  */
 typedef struct line_struct * ptr_line;
 typedef struct line_struct {
-    char word1[MAX_ASSEMBLY_LINE_LENGTH];  /* First word in the assembly line */
-    char word2[MAX_ASSEMBLY_LINE_LENGTH];  /* Second word in the assembly line */
-    char word3[MAX_ASSEMBLY_LINE_LENGTH];  /* Third word in the assembly line */
-    char word4[MAX_ASSEMBLY_LINE_LENGTH];  /* Fourth word in the assembly line */
-    char word5[MAX_ASSEMBLY_LINE_LENGTH];  /* Fifth word in the assembly line */
+    char text[MAX_ASSEMBLY_LINE_LENGTH];   /* Copy of the line, every word ended by a null terminator */
+    char *words[MAX_WORDS_IN_LINE + 1];    /* Words of the line (pointers into 'text' or constant strings) */
+    int columns[MAX_WORDS_IN_LINE + 1];    /* Column of every word of the line, from 1 (0 if it does not exist) */
+    int first_word;                        /* Index in 'words' of the first word of the line */
     addressing_method source;              /* Addressing method of the source operand in an instruction */
     addressing_method destination;         /* Addressing method of the destination operand in an instruction */
     count_word_in_line count;              /* Count of words in the line */
 } item_line;
 
 
-/* Function: create_new_line_struct
- * --------------------------------
- * Creates and initializes a new line struct based on the provided text line.
+/* Function: split_line_to_words
+ * -------------------------------
+ * Splits a line of assembly code into the words of a line struct.
  *
- * This function takes a string 'text_line' as input and creates a new line struct, dynamically
- * allocating memory for it. The function then parses the input 'text_line' to extract up to five
- * words (delimited by whitespace) and stores them in the corresponding fields of the newly created
- * line struct.
+ * This function copies 'text_line' to the 'text' field of the line struct and splits the copy into up to five words,
+ * delimited by whitespace. A comma is a word of its own, even without whitespace around it (for example, "r1,r2" is
+ * split into "r1", "," and "r2"). Every word is ended in the copy by a null terminator, so the words are read in place.
+ * The column of every word (of its first character, or of the comma) is kept in the 'columns' field.
  *
  * Parameters:
+ *   - line_struct: A pointer to the line struct that receives the words. Its previous content is overwritten.
  *   - text_line: A pointer to a string containing the text of the line to be processed.
  *
- * Returns:
- *   - ptr_line: A pointer to the newly created and initialized line struct.
+ * Notes:
+ *   - No memory is allocated, the struct is reused for every line of the file.
+ *   - The line struct is designed to store up to five words. If there are more than five words in the line, the
+ *     function keeps the first five words and sets the 'count' field to 'TOO_MUCH'.
+ *   - The 'source' and 'destination' fields are set to 'NOT_EXIST'.
+ *   - The words are counted as they are found in the line, so a line that starts with a comma, such as " ,  r3 red sub",
+ *     has four words: it is reported as an instruction that does not exist, and not also as too many words for an
+ *     instruction (see 'Tests/bad_test2.as').
+ */
+void split_line_to_words(ptr_line line_struct, const char *text_line);
+
+/* Function: copy_line_struct
+ * --------------------------
+ * Copies a line struct that was already split into words, without splitting its text again.
+ *
+ * Parameters:
+ *   - line_struct: A pointer to the line struct that receives the copy. Its previous content is overwritten.
+ *   - source_line: A pointer to the line struct to be copied (filled by 'split_line_to_words').
  *
  * Notes:
- *   - If dynamic memory allocation fails, the function prints an error message to stderr and exits the program.
- *   - The 'initialize_variables' function is called to reset all fields of the new line struct to zero .
- *   - The 'GET_WORD' macro is used to extract individual words from the 'text_line' and store them in the line struct.
- *   - The line struct is designed to store up to five words, but the function does not check if there are more than five words
- *     in the input 'text_line'. It simply stores the first five words found, and sets the 'count' field to indicate if there
- *     were more words in the line.
+ *   - The words that point into the text of 'source_line' are moved to the same positions in the text of the copy,
+ *     the constant comma and empty words are kept, so the copy is split exactly as the original.
+ *   - This is how the lines of a macro body, split once when the macro is defined, are given to the passes for every
+ *     call of the macro.
  */
-ptr_line create_new_line_struct(const char *text);
+void copy_line_struct(ptr_line line_struct, const item_line *source_line);
 
 /* Function: delete_label_from_line_struct
  * ---------------------------------------
@@ -259,28 +314,14 @@ ptr_line create_new_line_struct(const char *text);
  *   - The 'delete_label_from_line_struct' function is designed for use during the first pass of the assembly process
  *     to remove the label (if any) from the input line after it has been processed and the relevant information has
  *     been extracted. This operation prepares the line for further processing during the assembly.
- *   - The function uses the 'strcpy' function to copy the content of one word to another and the 'memset' function to
- *     set the fifth word to an empty string.
+ *   - The words are not copied, the function only moves the 'first_word' index to the next word, so the fifth word is
+ *     the empty last entry of 'words'.
  *   - The function does not check whether the line struct has a label (first word) before attempting to delete it.
  *     If the line struct's 'count' field is already zero or one (indicating that there is no label), the function will
  *     still perform the word shifting and clearing without any errors.
  */
 void delete_label_from_line_struct(ptr_line line_struct);
 
-/* Function: free_line
- * -------------------
- * Frees the memory allocated for a line struct.
- *
- * Parameters:
- *   - line_struct: A pointer to the line struct that needs to be freed.
- *
- * Notes:
- *   - The 'free_line' function is designed to be used when the line struct is no longer needed and can be
- *     safely deallocated. After calling this function, the 'line_struct' pointer should not be used again
- *     to access the freed memory.
- */
-void free_line(ptr_line line_struct);
-
 /* Function: skip_white_character
  * ------------------------------
  * Skips over white spaces (spaces and tabs) in the input text starting from the specified position.
@@ -359,8 +400,8 @@ bool is_end_line(int curr_position, const char *line_text);
  * Notes:
  *   - The 'is_label' function helps determine if a line of text starts with a label. Labels are used to mark memory
  *     locations or specific positions in the assembly code and end with a colon (':').
- *   - The 'is_label' function does not modify any other part of 'line_struct' except 'line_struct->word1' when it
- *     processes a line containing a label.
+ *   - The 'is_label' function does not modify any other part of 'line_struct' except its first word, from which
+ *     the colon is removed, when it processes a line containing a label.
  */
 bool is_label(ptr_line line_struct);
 
@@ -441,7 +482,7 @@ bool is_label_name_valid(char *name_label);
  * Checks if the given name is a reserved word in the assembly language.
  *
  * This function takes a pointer to a character array 'name', which represents a word or identifier
- * in the assembly language. It compares 'name' against a list of known reserved words to determine
+ * in the assembly language. It looks 'name' up in the table of keywords ('find_keyword') to determine
  * if it matches any of them.
  *
  * Parameters:
@@ -453,7 +494,7 @@ bool is_label_name_valid(char *name_label);
  * Notes:
  *   - The function is case-sensitive; reserved words must match exactly, including letter case.
  *   - The reserved words checked by this function include assembler directives (e.g., ".data", ".string"),
- *     processor registers (e.g., "@r0", "@r2"), and assembly instructions (e.g., "mov", "cmp").
+ *     processor registers ("@r0" to "@r7"), and assembly instructions (e.g., "mov", "cmp").
  */
 bool is_name_a_reserved_word(char *name);
 
@@ -462,7 +503,7 @@ bool is_name_a_reserved_word(char *name);
  * Retrieves the instruction type for the given assembly instruction word.
  *
  * This function takes a pointer to a character array 'word', representing an assembly instruction
- * mnemonic. It compares 'word' against a list of known assembly instructions and returns the
+ * mnemonic. It looks 'word' up in the table of keywords ('find_keyword') and returns the
  * corresponding instruction type enumeration.
  *
  * Parameters:
@@ -493,6 +534,40 @@ bool is_name_a_reserved_word(char *name);
  */
 instruction_type get_instruction_type(const char *word);
 
+/* Function: get_directive_status
+ * ------------------------------
+ * Retrieves the line status of the given directive word.
+ *
+ * Parameters:
+ *   - word: A pointer to a null-terminated string, usually the first word of a line (after its label).
+ *
+ * Returns:
+ *   - line_status: 'STATUS_DATA', 'STATUS_STRING', 'STATUS_ENTRY' or 'STATUS_EXTERN' for the matching directive,
+ *     or 'STATUS_CODE' if 'word' is not a directive.
+ *
+ * Notes:
+ *   - The word is looked up in the table of keywords ('find_keyword').
+ */
+line_status get_directive_status(const char *word);
+
+/* Function: find_keyword
+ * ----------------------
+ * Looks a word up in the table of keywords (the instructions, directives and registers of the language).
+ *
+ * Parameters:
+ *   - word: A pointer to a null-terminated string containing the word.
+ *
+ * Returns:
+ *   - ptr_keyword: A pointer to the keyword that matches 'word', or NULL if 'word' is not a keyword.
+ *
+ * Notes:
+ *   - The table is a perfect hash table built at compile time: the hash of the word selects the only keyword it can
+ *     match, so a word is compared with one keyword at most.
+ *   - A word longer than 'MAX_KEYWORD_LENGTH' is rejected without being read to its end.
+ *   - The function is case-sensitive.
+ */
+ptr_keyword find_keyword(const char *word);
+
 /* Function: get_addressing_method_type
  * -------------------------------------
  * Retrieves the addressing method type for the given assembly operand.
@@ -542,30 +617,57 @@ addressing_method get_addressing_method_type(char *word);
  */
 int get_number_of_register(char *register_name);
 
-/* Function: convert_binary_to_64base
- * ----------------------------------
- * Converts a 12-bit binary word to a 64-base representation.
+/* Function: encode_words_to_64base
+ * ---------------------------------
+ * Encodes an array of 12-bit binary words in the base64 format of the object file.
+ *
+ * Every word is written to 'output' as two base64 characters (the high 6 bits, then the low 6 bits) followed by a
+ * newline character. The characters are taken from a table of the 4096 possible words, so encoding a word is a lookup
+ * and a copy of three characters.
+ *
+ * Parameters:
+ *   - words: The array of words to be encoded. Only the low 12 bits of every word are used.
+ *   - count_words: The number of words in 'words'.
+ *   - output: A buffer of at least 'count_words * BASE64_WORD_LENGTH' characters that receives the encoded words.
+ *
+ * Returns:
+ *   - size_t: The number of characters written to 'output' (no null terminator is written).
+ *
+ * Notes:
+ *   - No memory is allocated. The table is built on the first call (once, with 'pthread_once'), so the function can be
+ *     called for several files at the same time.
+ */
+size_t encode_words_to_64base(const unsigned int *words, int count_words, char *output);
+
+/* Function: decode_64base_to_word
+ * -------------------------------
+ * Decodes one word of the object file: two base64 characters (the high 6 bits, then the low 6 bits).
+ *
+ * Parameters:
+ *   - text: A pointer to the two characters of the word.
  *
- * This function takes an unsigned integer 'word' representing a 12-bit binary word and converts it into a 64-base
- * (base64) representation.
+ * Returns:
+ *   - int: The 12-bit word, or -1 if one of the characters is not a base64 character.
+ */
+int decode_64base_to_word(const char *text);
+
+/* Function: hash_name
+ * -------------------
+ * Computes a hash value for a name (label or macro name).
  *
- * binary word is used as an index into the lookup table to obtain the corresponding character in the base64 encoding.
- * The resulting base64 representation is a three-character string (plus a null terminator) that can be used to represent
- * the original 12-bit binary word.
+ * This function computes the 32-bit FNV-1a hash of the null-terminated string 'name'. It is used to find the home slot of
+ * a name in the hash tables of labels and macros.
  *
  * Parameters:
- *   - word: An unsigned integer representing the 12-bit binary word to be converted.
+ *   - name: A pointer to a null-terminated string containing the name to be hashed.
  *
  * Returns:
- *   - char*: A dynamically allocated pointer to a string containing the base64 representation of the input 'word'.
- *            The caller is responsible for freeing the memory allocated by this function when it is no longer needed.
+ *   - unsigned long: The hash value of 'name' (only the low 32 bits are used).
  *
  * Notes:
- *   - The function dynamically allocates memory to store the base64 representation of the input 'word'.
- *   - If the memory allocation fails, the function prints an error message to stderr and exits the program.
- *   - The function uses the 'get_specific_bits' helper function to extract specific bits from the input 'word'.
+ *   - The hash tables use the value masked by their size (a power of two) as the home slot of the name.
  */
-char * convert_binary_to_64base(unsigned int word);
+unsigned long hash_name(const char *name);
 
 /* Function: print_red
  * -------------------
@@ -592,8 +694,8 @@ void print_reset();
  * --------------------
  * (For Debugging) Prints the content of a 'ptr_line' structure to the console.
  *
- * This function takes a pointer to a 'ptr_line' structure and prints the content of its 'word1', 'word2', 'word3',
- * 'word4', and 'word5' members, separated by spaces. Additionally, it prints the 'count' member at the end of the line.
+ * This function takes a pointer to a 'ptr_line' structure and prints its five words (read with 'WORD_OF_LINE'),
+ * separated by spaces. Additionally, it prints the 'count' member at the end of the line.
  * The function is intended for debugging purposes to display the content of the 'ptr_line' structure and its associated
  * information.
  *
@@ -606,8 +708,8 @@ void print_reset();
  *   - The function does not modify the content of the 'ptr_line' structure or any associated data.
  *   - The printed output format is as follows:
  *       "word1 word2 word3 word4 word5 count: X\n"
- *     where 'word1', 'word2', 'word3', 'word4', and 'word5' represent the content of the corresponding members of
- *     the 'ptr_line' structure, and 'X' is the value of the 'count' member.
+ *     where 'word1' to 'word5' represent the five words of the 'ptr_line' structure, and 'X' is the value of the
+ *     'count' member.
  */
 __attribute__((unused)) void print_line(ptr_line line_struct);
 
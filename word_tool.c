@@ -0,0 +1,72 @@
+#include "word_tool.h"
+
+/* The bitmask of every addressing method of an operand, and of every method but an immediate number. */
+#define ANY_METHOD (METHOD_BIT(NOT_EXIST) | METHOD_BIT(IMMEDIATE) | METHOD_BIT(DIRECT) | METHOD_BIT(REGISTER))
+#define NOT_IMMEDIATE (ANY_METHOD & ~METHOD_BIT(IMMEDIATE))
+
+/* The layouts must fill the word exactly, and every opcode and addressing method must fit its field (a negative size
+ * of the array fails the build otherwise). */
+typedef char check_first_word_layout[(SOURCE_METHOD_SHIFT + METHOD_BITS == WORD_BITS) ? 1 : -1];
+typedef char check_register_word_layout[(SOURCE_REGISTER_SHIFT + REGISTER_BITS == WORD_BITS) ? 1 : -1];
+typedef char check_value_word_layout[(VALUE_SHIFT + VALUE_BITS == WORD_BITS) ? 1 : -1];
+typedef char check_opcode_field[(STOP < (1 << OPCODE_BITS)) ? 1 : -1];
+typedef char check_method_field[(REGISTER < (1 << METHOD_BITS)) ? 1 : -1];
+typedef char check_encoding_field[(RELOCATABLE <= ENCODING_TYPE_MASK) ? 1 : -1];
+
+/* The table of the instructions, in the order of 'instruction_type' (the opcodes), closed by 'NOT_INSTRUCTION'. */
+static const item_instruction_spec instruction_specs[NOT_INSTRUCTION + 1] = {
+    {2, ANY_METHOD, NOT_IMMEDIATE},           /* MOV */
+    {2, ANY_METHOD, ANY_METHOD},              /* CMP */
+    {2, ANY_METHOD, NOT_IMMEDIATE},           /* ADD */
+    {2, ANY_METHOD, NOT_IMMEDIATE},           /* SUB */
+    {1, ANY_METHOD, NOT_IMMEDIATE},           /* NOT */
+    {1, ANY_METHOD, NOT_IMMEDIATE},           /* CLR */
+    {2, METHOD_BIT(DIRECT), NOT_IMMEDIATE},   /* LEA */
+    {1, ANY_METHOD, NOT_IMMEDIATE},           /* INC */
+    {1, ANY_METHOD, NOT_IMMEDIATE},           /* DEC */
+    {1, ANY_METHOD, NOT_IMMEDIATE},           /* JMP */
+    {1, ANY_METHOD, NOT_IMMEDIATE},           /* BNE */
+    {1, ANY_METHOD, NOT_IMMEDIATE},           /* RED */
+    {1, ANY_METHOD, ANY_METHOD},              /* PRN */
+    {1, ANY_METHOD, NOT_IMMEDIATE},           /* JSR */
+    {0, ANY_METHOD, ANY_METHOD},              /* RTS */
+    {0, ANY_METHOD, ANY_METHOD},              /* STOP */
+    {-1, ANY_METHOD, ANY_METHOD}              /* NOT_INSTRUCTION */
+};
+
+const item_instruction_spec * get_instruction_spec(instruction_type type){
+    if (type < MOV || type > NOT_INSTRUCTION){
+        type = NOT_INSTRUCTION;
+    }
+    return &instruction_specs[type];
+}
+
+bool is_valid_addressing(instruction_type type, addressing_method source, addressing_method destination){
+    const item_instruction_spec *spec = get_instruction_spec(type);
+
+    if ((spec->source_methods & METHOD_BIT(source)) == 0 || (spec->destination_methods & METHOD_BIT(destination)) == 0){
+        return FALSE;
+    }
+    return TRUE;
+}
+
+void update_operands_of_line(ptr_line line_struct, instruction_type type){
+    switch (get_instruction_spec(type)->count_operands) {
+        case 2:
+            /* The source is the first operand and the destination the second one (after the comma). */
+            line_struct->source = get_addressing_method_type(WORD_OF_LINE(line_struct, 2));
+            line_struct->destination = get_addressing_method_type(WORD_OF_LINE(line_struct, 4));
+            break;
+        case 1:
+            /* The single operand is the destination, and it is used as word4 as well. */
+            line_struct->source = NOT_EXIST;
+            line_struct->destination = get_addressing_method_type(WORD_OF_LINE(line_struct, 2));
+            WORD_OF_LINE(line_struct, 4) = WORD_OF_LINE(line_struct, 2);
+            break;
+        default:
+            /* For instructions with no operands (or no instruction), both operands do not exist. */
+            line_struct->source = NOT_EXIST;
+            line_struct->destination = NOT_EXIST;
+            break;
+    }
+}
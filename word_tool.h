@@ -0,0 +1,167 @@
+/*
+ * Header: word_tool.h
+ * -------------------
+ * This header file defines the layouts of the machine words of an instruction and the table of the instructions, which
+ * both passes share.
+ *
+ * Every word has 'WORD_BITS' (12) bits. The layouts, from the highest bit to the lowest:
+ *
+ *   First word:     | source method (3) | opcode (4) | destination method (3) | A,R,E (2) |
+ *   Register word:  | source register (5) | destination register (5) | A,R,E (2) |
+ *   Value word:     | value or address (10) | A,R,E (2) |
+ *
+ * A word is built with plain shifts and masks by the 'ENCODE_*' macros below, so every field is cut to its width and
+ * the bits above the word are always zero. The layouts are checked when 'word_tool.c' is compiled: a field that does
+ * not fit the word, or an opcode or an addressing method that does not fit its field, fails the build.
+ *
+ * The table of the instructions holds, for every opcode, the number of its operands and the addressing methods that
+ * its source and its destination accept (as bitmasks), so an instruction is checked with a lookup in the table.
+ *
+ * Included Files:
+ *   - text_tool.h: Contains the line struct and the 'instruction_type', 'addressing_method' and 'encoding_type' enums.
+ *   - setting.h: Contains constant definitions and configurations used throughout the assembly process.
+ */
+
+#ifndef WORD_TOOL_H
+#define WORD_TOOL_H
+
+#include "text_tool.h"
+#include "setting.h"
+
+/* Bits of the addressing method fields of the first word, and the position of the destination method */
+#define METHOD_BITS 3
+#define DESTINATION_METHOD_SHIFT ENCODING_TYPE_BITS
+
+/* Bits of the opcode field of the first word and its position, followed by the source method */
+#define OPCODE_BITS 4
+#define OPCODE_SHIFT (DESTINATION_METHOD_SHIFT + METHOD_BITS)
+#define SOURCE_METHOD_SHIFT (OPCODE_SHIFT + OPCODE_BITS)
+
+/* Bits of the register fields of a register word, and their positions */
+#define REGISTER_BITS 5
+#define DESTINATION_REGISTER_SHIFT ENCODING_TYPE_BITS
+#define SOURCE_REGISTER_SHIFT (DESTINATION_REGISTER_SHIFT + REGISTER_BITS)
+
+/* Bits of the value field of a value word (an immediate number or the address of a label), and its position */
+#define VALUE_BITS (WORD_BITS - ENCODING_TYPE_BITS)
+#define VALUE_SHIFT ENCODING_TYPE_BITS
+
+/*
+ * Macro: FIELD_OF_WORD
+ * --------------------
+ * The bits of a field of a word: the 'bits' lowest bits of 'value', moved to the position 'shift'.
+ */
+#define FIELD_OF_WORD(value, shift, bits) ((((unsigned int) (value)) & ((1u << (bits)) - 1)) << (shift))
+
+/*
+ * Macro: ENCODE_FIRST_WORD
+ * ------------------------
+ * The first word of an instruction, of the given opcode and addressing methods of its operands (always ABSOLUTE).
+ */
+#define ENCODE_FIRST_WORD(opcode, source, destination) \
+        (FIELD_OF_WORD(source, SOURCE_METHOD_SHIFT, METHOD_BITS) | \
+         FIELD_OF_WORD(opcode, OPCODE_SHIFT, OPCODE_BITS) | \
+         FIELD_OF_WORD(destination, DESTINATION_METHOD_SHIFT, METHOD_BITS) | ABSOLUTE)
+
+/*
+ * Macro: ENCODE_REGISTER_WORD
+ * ---------------------------
+ * The word of the register operands of an instruction (always ABSOLUTE). An operand that is not a register is zero.
+ */
+#define ENCODE_REGISTER_WORD(source_register, destination_register) \
+        (FIELD_OF_WORD(source_register, SOURCE_REGISTER_SHIFT, REGISTER_BITS) | \
+         FIELD_OF_WORD(destination_register, DESTINATION_REGISTER_SHIFT, REGISTER_BITS) | ABSOLUTE)
+
+/*
+ * Macro: ENCODE_VALUE_WORD
+ * ------------------------
+ * The word of an immediate operand or of the address of a label, with the given encoding type (A,R,E). A negative
+ * value keeps its two's complement in the 'VALUE_BITS' bits of the field.
+ */
+#define ENCODE_VALUE_WORD(value, encoding) \
+        (FIELD_OF_WORD(value, VALUE_SHIFT, VALUE_BITS) | FIELD_OF_WORD(encoding, 0, ENCODING_TYPE_BITS))
+
+/*
+ * Macro: VALUE_OF_WORD
+ * --------------------
+ * The value field of a value word (the address of a label in a relocatable word), without its encoding type.
+ */
+#define VALUE_OF_WORD(word) ((((unsigned int) (word)) >> VALUE_SHIFT) & ((1u << VALUE_BITS) - 1))
+
+/*
+ * Macro: ENCODING_OF_WORD
+ * -----------------------
+ * The encoding type (A,R,E) of a word.
+ */
+#define ENCODING_OF_WORD(word) (((unsigned int) (word)) & ENCODING_TYPE_MASK)
+
+/*
+ * Macro: METHOD_BIT
+ * -----------------
+ * The bit of an addressing method in the bitmasks of the table of the instructions ('NOT_EXIST' is the bit of a
+ * missing operand).
+ */
+#define METHOD_BIT(method) (1u << (method))
+
+/*
+ * Struct: item_instruction_spec
+ * -----------------------------
+ * A structure representing an entry of the table of the instructions.
+ *
+ * Fields:
+ *   - count_operands: The number of operands of the instruction (0, 1 or 2), or -1 for 'NOT_INSTRUCTION'.
+ *   - source_methods: The bitmask ('METHOD_BIT') of the addressing methods the source operand accepts.
+ *   - destination_methods: The bitmask of the addressing methods the destination operand accepts.
+ */
+typedef struct instruction_spec {
+    int count_operands;
+    unsigned int source_methods;
+    unsigned int destination_methods;
+} item_instruction_spec;
+
+/*
+ * Function: get_instruction_spec
+ * ------------------------------
+ * Returns the entry of an instruction in the table of the instructions.
+ *
+ * Parameters:
+ *   type (instruction_type): The type of the instruction (an unknown instruction is 'NOT_INSTRUCTION').
+ *
+ * Returns:
+ *   const item_instruction_spec*: A pointer to the entry of the instruction (never NULL).
+ */
+const item_instruction_spec * get_instruction_spec(instruction_type type);
+
+/*
+ * Function: is_valid_addressing
+ * -----------------------------
+ * Checks the addressing methods of the operands of an instruction against the table of the instructions.
+ *
+ * Parameters:
+ *   type (instruction_type): The type of the instruction.
+ *   source (addressing_method): The addressing method of the source operand ('NOT_EXIST' if there is none).
+ *   destination (addressing_method): The addressing method of the destination operand ('NOT_EXIST' if there is none).
+ *
+ * Returns:
+ *   bool: TRUE if the instruction accepts both methods, FALSE otherwise.
+ */
+bool is_valid_addressing(instruction_type type, addressing_method source, addressing_method destination);
+
+/*
+ * Function: update_operands_of_line
+ * ---------------------------------
+ * Updates the addressing methods of the operands of an instruction line, by the number of operands of the instruction.
+ *
+ * Parameters:
+ *   line_struct (ptr_line): A pointer to the split line of the instruction.
+ *   type (instruction_type): The type of the instruction, obtained from the first word of the line.
+ *
+ * Notes:
+ *   - An instruction with two operands takes its source from 'word2' and its destination from 'word4'.
+ *   - An instruction with a single operand takes its destination from 'word2', and 'word4' is set to 'word2' (a
+ *     pointer, the text is not copied), so the destination operand is always 'word4'.
+ *   - The missing operands are 'NOT_EXIST'.
+ */
+void update_operands_of_line(ptr_line line_struct, instruction_type type);
+
+#endif /* WORD_TOOL_H */